@@ -16,6 +16,15 @@ set(PRIORITY 0 CACHE STRING "Change the nice level [-20 - 20]")
 set(POLICY "OTHER" CACHE STRING "NA")
 set(OOMADJUST 0 CACHE STRING "Adapt the OOM score [-15 - 15]")
 set(STACKSIZE 0 CACHE STRING "Default stack size per thread")
+set(REACTORS 1 CACHE STRING "Number of resource monitor (socket I/O) threads")
+set(SHAREDRING 0 CACHE STRING "Shared memory slots per direction for large COM-RPC frames, 0 is off")
+set(WORKSTEALING false CACHE STRING "Use per thread job queues with work stealing in the workerpool")
+set(OUTBOUND_HIGHWATERMARK 1048576 CACHE STRING "Bytes queued on a connection before its events are dropped or coalesced, 0 is unbounded")
+set(OUTBOUND_LOWWATERMARK 262144 CACHE STRING "Bytes queued on a connection below which its events are accepted again")
+set(OUTBOUND_POLICY "coalesce" CACHE STRING "What to do with events for a congested connection: drop or coalesce")
+set(COMPRESSION false CACHE STRING "Compress websocket messages if the client offers permessage-deflate")
+set(COMPRESSION_CONTEXTTAKEOVER false CACHE STRING "Keep the compression context between messages, costs memory per connection")
+set(COMPRESSION_THRESHOLD 256 CACHE STRING "Messages smaller than this number of bytes are sent uncompressed")
 
 map()
   key(plugins)
@@ -41,10 +50,29 @@ map()
     kv(policy ${POLICY})
     kv(oomadjust ${OOMADJUST})
     kv(stacksize ${STACKSIZE})
+    kv(reactors ${REACTORS})
+    kv(sharedring ${SHAREDRING})
+    kv(workstealing ${WORKSTEALING})
 end()
 ans(PROCESS_CONFIG)
 map_append(${CONFIG} process ${PROCESS_CONFIG})
 
+map()
+    kv(highwatermark ${OUTBOUND_HIGHWATERMARK})
+    kv(lowwatermark ${OUTBOUND_LOWWATERMARK})
+    kv(policy ${OUTBOUND_POLICY})
+end()
+ans(OUTBOUND_CONFIG)
+map_append(${CONFIG} outbound ${OUTBOUND_CONFIG})
+
+map()
+    kv(enabled ${COMPRESSION})
+    kv(contexttakeover ${COMPRESSION_CONTEXTTAKEOVER})
+    kv(threshold ${COMPRESSION_THRESHOLD})
+end()
+ans(COMPRESSION_CONFIG)
+map_append(${CONFIG} compression ${COMPRESSION_CONFIG})
+
 map()
     kv(callsign Controller)
     key(configuration)
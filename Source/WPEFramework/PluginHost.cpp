@@ -385,6 +385,14 @@ namespace PluginHost {
             if (serviceConfig.Process.StackSize.IsSet() == true) {
                 Core::Thread::DefaultStackSize(serviceConfig.Process.StackSize.Value());
             }
+
+            if (serviceConfig.Process.Reactors.IsSet() == true) {
+                Core::ResourceMonitor::DefaultReactors(serviceConfig.Process.Reactors.Value());
+            }
+
+            if (serviceConfig.Process.SharedRing.IsSet() == true) {
+                RPC::SharedRing::DefaultSlots(serviceConfig.Process.SharedRing.Value());
+            }
         }
 
 #ifndef __WINDOWS__
@@ -620,6 +628,12 @@ namespace PluginHost {
                     for (uint8_t index = 0; index < metaData.Slots; index++) {
                         printf("  Thread%02d:  %d\n", (index + 1), metaData.Slot[index]);
                     }
+                    if (Core::WorkerPool::Instance().IsWorkStealing() == true) {
+                        printf("Steals:\n");
+                        for (uint8_t index = 0; index < metaData.Slots; index++) {
+                            printf("  Thread%02d:  %d\n", (index + 1), metaData.Steals[index]);
+                        }
+                    }
                     status->Release();
                     break;
                 }
@@ -678,9 +692,12 @@ namespace PluginHost {
 
 #if !defined(__WINDOWS__) && !defined(__APPLE__)
                 case 'R': {
-                    printf("\nMonitor callstack:\n");
-                    printf("============================================================\n");
-                    PublishCallstack(Core::ResourceMonitor::Instance().Id());
+                    Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
+                    for (uint8_t index = 0; index < monitor.Reactors(); index++) {
+                        printf("\nMonitor callstack [%d]:\n", index);
+                        printf("============================================================\n");
+                        PublishCallstack(monitor.Id(index));
+                    }
                     break;
                 }
                 case '0':
@@ -40,6 +40,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
     /* static */ Core::ProxyPoolType<Server::Channel::WebRequestJob> Server::Channel::_webJobs(2);
     /* static */ Core::ProxyPoolType<Server::Channel::JSONElementJob> Server::Channel::_jsonJobs(2);
     /* static */ Core::ProxyPoolType<Server::Channel::TextJob> Server::Channel::_textJobs(2);
+    /* static */ Core::ProxyPoolType<Server::Channel::BatchJob> Server::Channel::_batchJobs(2);
 
 #ifdef __WINDOWS__
     /* static */ const TCHAR* Server::ConfigFile = _T("C:\\Projects\\PluginHost.json");
@@ -209,6 +210,11 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
                 newInfo.Name = name;
             }
 
+            newInfo.Depth = client->QueueDepth();
+            newInfo.Dropped = client->Dropped();
+            newInfo.Coalesced = client->Coalesced();
+            newInfo.Latency = client->Latency();
+
             metaData.Add(newInfo);
         }
     }
@@ -566,6 +572,14 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
         , _security(_parent.Officer())
         , _service()
     {
+        const ChannelMap& channels(static_cast<ChannelMap&>(*parent));
+
+        Outbound(channels.HighWatermark(), channels.LowWatermark(), channels.Policy());
+
+        if (channels.Compression() == true) {
+            Compression(true, channels.ContextTakeover(), channels.Threshold());
+        }
+
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
     }
 
@@ -605,8 +619,9 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
     Server::Server(Server::Config & configuration, const bool background)
         : _accessor()
-        , _dispatcher(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
-        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime)
+        , _dispatcher(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0,
+              configuration.Process.IsSet() ? configuration.Process.WorkStealing.Value() : false)
+        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime, configuration.Outbound, configuration.Compression)
         , _config(configuration.Version.Value(),
               DetermineProperModel(configuration.Model),
               background,
@@ -622,6 +637,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
               Core::NodeId(configuration.Communicator.Value().c_str()),
               configuration.Redirect.Value())
         , _services(*this, _config, configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
+        , _activator(_dispatcher)
         , _controller()
     {
 
@@ -723,6 +739,88 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
         }
     }
 
+    uint32_t Server::Activator::Predecessor(const uint32_t index) const
+    {
+        const Step& current(_steps[index]);
+        uint32_t result = NoStep;
+
+        if (current.Waited == true) {
+            for (uint32_t step = 0; step < _steps.size(); step++) {
+                const Step& candidate(_steps[step]);
+
+                if ((candidate.Begin <= current.Queued) && (candidate.Begin < current.Begin)) {
+                    if (result == NoStep) {
+                        result = step;
+                    } else {
+                        const Step& chosen(_steps[result]);
+                        const bool running = (candidate.End >= current.Queued);
+
+                        // An activation still running when the preconditions were met beats one that completed before.
+                        if ((running == true) && ((chosen.End < current.Queued) || (candidate.Begin > chosen.Begin))) {
+                            result = step;
+                        } else if ((running == false) && (chosen.End < current.Queued) && (candidate.End > chosen.End)) {
+                            result = step;
+                        }
+                    }
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    void Server::Activator::Report() const
+    {
+        ASSERT(_steps.empty() == false);
+
+        // The activation that completed last ends the critical path, walk back over the ones it waited for.
+        uint32_t index = 0;
+
+        for (uint32_t step = 1; step < _steps.size(); step++) {
+            if (_steps[step].End > _steps[index].End) {
+                index = step;
+            }
+        }
+
+        const uint64_t end = _steps[index].End;
+        std::list<const Step*> path;
+
+        while (index != NoStep) {
+            path.push_front(&(_steps[index]));
+            index = Predecessor(index);
+        }
+
+        string text;
+
+        for (const Step* step : path) {
+            if (text.empty() == false) {
+                text += _T(" -> ");
+            }
+            text += step->Callsign + _T(" (") + Core::NumberType<uint32_t>(static_cast<uint32_t>((step->End - step->Begin) / 1000)).Text() + _T(" ms");
+
+            // Time spent waiting for a free thread, not for a precondition.
+            if ((step->Begin - step->Queued) >= 1000) {
+                text += _T(", queued ") + Core::NumberType<uint32_t>(static_cast<uint32_t>((step->Begin - step->Queued) / 1000)).Text() + _T(" ms");
+            }
+            text += _T(")");
+        }
+
+        SYSLOG(Logging::Startup, (_T("Activated %d plugins in %d ms, critical path: %s"), static_cast<int>(_steps.size()), static_cast<int>((end - _begin) / 1000), text.c_str()));
+
+        if (_waiting.empty() == false) {
+            string waiting;
+
+            for (const string& callsign : _waiting) {
+                if (waiting.empty() == false) {
+                    waiting += _T(", ");
+                }
+                waiting += callsign;
+            }
+
+            SYSLOG(Logging::Startup, (_T("Plugins waiting for their preconditions: %s"), waiting.c_str()));
+        }
+    }
+
     void Server::Open()
     {
         // Before we do anything with the subsystems (notifications)
@@ -760,7 +858,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
             Core::ProxyType<Service> service(*iterator);
 
             if (service->AutoStart() == true) {
-                service->Activate(PluginHost::IShell::STARTUP);
+                _activator.Submit(service, PluginHost::IShell::STARTUP);
             } else {
                 SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] blocked"), service->ClassName().c_str(), service->Callsign().c_str()));
             }
@@ -771,6 +869,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
     {
         Plugin::Controller* destructor(_controller->ClassType<Plugin::Controller>());
         _connections.Close(Core::infinite);
+        _activator.Close();
         destructor->Stopped();
         _services.Destroy();
         _dispatcher.Stop();
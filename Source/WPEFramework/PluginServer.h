@@ -96,6 +96,9 @@ namespace PluginHost {
                     , OOMAdjust(0)
                     , Policy()
                     , StackSize(0)
+                    , Reactors(1)
+                    , WorkStealing(false)
+                    , SharedRing(0)
                     , Umask(1)
                 {
                     Add(_T("user"), &User);
@@ -104,6 +107,9 @@ namespace PluginHost {
                     Add(_T("policy"), &Policy);
                     Add(_T("oomadjust"), &OOMAdjust);
                     Add(_T("stacksize"), &StackSize);
+                    Add(_T("reactors"), &Reactors);
+                    Add(_T("workstealing"), &WorkStealing);
+                    Add(_T("sharedring"), &SharedRing);
                     Add(_T("umask"), &Umask);
                 }
                 ProcessSet(const ProcessSet& copy)
@@ -114,6 +120,9 @@ namespace PluginHost {
                     , OOMAdjust(copy.OOMAdjust)
                     , Policy(copy.Policy)
                     , StackSize(copy.StackSize)
+                    , Reactors(copy.Reactors)
+                    , WorkStealing(copy.WorkStealing)
+                    , SharedRing(copy.SharedRing)
                     , Umask(copy.Umask)
                 {
                     Add(_T("user"), &User);
@@ -122,6 +131,9 @@ namespace PluginHost {
                     Add(_T("policy"), &Policy);
                     Add(_T("oomadjust"), &OOMAdjust);
                     Add(_T("stacksize"), &StackSize);
+                    Add(_T("reactors"), &Reactors);
+                    Add(_T("workstealing"), &WorkStealing);
+                    Add(_T("sharedring"), &SharedRing);
                     Add(_T("umask"), &Umask);
                 }
                 ~ProcessSet()
@@ -136,6 +148,9 @@ namespace PluginHost {
                     Policy = RHS.Policy;
                     OOMAdjust = RHS.OOMAdjust;
                     StackSize = RHS.StackSize;
+                    Reactors = RHS.Reactors;
+                    WorkStealing = RHS.WorkStealing;
+                    SharedRing = RHS.SharedRing;
                     Umask = RHS.Umask;
 
                     return (*this);
@@ -147,6 +162,9 @@ namespace PluginHost {
                 Core::JSON::DecSInt8 OOMAdjust;
                 Core::JSON::EnumType<Core::ProcessInfo::scheduler> Policy;
                 Core::JSON::DecUInt32 StackSize;
+                Core::JSON::DecUInt8 Reactors;
+                Core::JSON::Boolean WorkStealing;
+                Core::JSON::DecUInt8 SharedRing;
                 Core::JSON::DecUInt16 Umask;
             };
 
@@ -186,6 +204,80 @@ namespace PluginHost {
                 Core::JSON::EnumType<PluginHost::InputHandler::type> Type;
             };
 
+            class OutboundConfig : public Core::JSON::Container {
+            public:
+                OutboundConfig()
+                    : HighWatermark(1024 * 1024)
+                    , LowWatermark(256 * 1024)
+                    , Policy(PluginHost::Channel::COALESCE)
+                {
+                    Add(_T("highwatermark"), &HighWatermark);
+                    Add(_T("lowwatermark"), &LowWatermark);
+                    Add(_T("policy"), &Policy);
+                }
+                OutboundConfig(const OutboundConfig& copy)
+                    : HighWatermark(copy.HighWatermark)
+                    , LowWatermark(copy.LowWatermark)
+                    , Policy(copy.Policy)
+                {
+                    Add(_T("highwatermark"), &HighWatermark);
+                    Add(_T("lowwatermark"), &LowWatermark);
+                    Add(_T("policy"), &Policy);
+                }
+                ~OutboundConfig()
+                {
+                }
+                OutboundConfig& operator=(const OutboundConfig& RHS)
+                {
+                    HighWatermark = RHS.HighWatermark;
+                    LowWatermark = RHS.LowWatermark;
+                    Policy = RHS.Policy;
+                    return (*this);
+                }
+
+                Core::JSON::DecUInt32 HighWatermark;
+                Core::JSON::DecUInt32 LowWatermark;
+                Core::JSON::EnumType<PluginHost::Channel::EventPolicy> Policy;
+            };
+
+            // Compression of websocket messages (permessage-deflate). Every compressing connection
+            // holds its own zlib state, so it is off unless configured.
+            class CompressionConfig : public Core::JSON::Container {
+            public:
+                CompressionConfig()
+                    : Enabled(false)
+                    , ContextTakeover(false)
+                    , Threshold(Web::WebSocket::Protocol::DefaultThreshold)
+                {
+                    Add(_T("enabled"), &Enabled);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                    Add(_T("threshold"), &Threshold);
+                }
+                CompressionConfig(const CompressionConfig& copy)
+                    : Enabled(copy.Enabled)
+                    , ContextTakeover(copy.ContextTakeover)
+                    , Threshold(copy.Threshold)
+                {
+                    Add(_T("enabled"), &Enabled);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                    Add(_T("threshold"), &Threshold);
+                }
+                ~CompressionConfig()
+                {
+                }
+                CompressionConfig& operator=(const CompressionConfig& RHS)
+                {
+                    Enabled = RHS.Enabled;
+                    ContextTakeover = RHS.ContextTakeover;
+                    Threshold = RHS.Threshold;
+                    return (*this);
+                }
+
+                Core::JSON::Boolean Enabled;
+                Core::JSON::Boolean ContextTakeover;
+                Core::JSON::DecUInt16 Threshold;
+            };
+
 #ifdef PROCESSCONTAINERS_ENABLED
 
             class ProcessContainerConfig : public Core::JSON::Container {
@@ -245,6 +337,8 @@ namespace PluginHost {
                 , DefaultTraceCategories(false)
                 , Process()
                 , Input()
+                , Outbound()
+                , Compression()
                 , Configs()
                 , Environments()
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -271,6 +365,8 @@ namespace PluginHost {
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
                 Add(_T("input"), &Input);
+                Add(_T("outbound"), &Outbound);
+                Add(_T("compression"), &Compression);
                 Add(_T("plugins"), &Plugins);
                 Add(_T("configs"), &Configs);
                 Add(_T("environments"), &Environments);
@@ -303,6 +399,8 @@ namespace PluginHost {
             Core::JSON::String DefaultTraceCategories;
             ProcessSet Process;
             InputConfig Input;
+            OutboundConfig Outbound;
+            CompressionConfig Compression;
             Core::JSON::String Configs;
             Core::JSON::ArrayType<Plugin::Config> Plugins;
             Core::JSON::ArrayType<Environment::Config> Environments;
@@ -317,8 +415,8 @@ namespace PluginHost {
             WorkerPoolImplementation(const WorkerPoolImplementation&) = delete;
             WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
 
-            WorkerPoolImplementation(const uint32_t stackSize)
-                : Core::WorkerPoolType<THREADPOOL_COUNT>(stackSize)
+            WorkerPoolImplementation(const uint32_t stackSize, const bool workStealing)
+                : Core::WorkerPoolType<THREADPOOL_COUNT>(stackSize, workStealing)
             {
             }
             virtual ~WorkerPoolImplementation()
@@ -759,7 +857,7 @@ namespace PluginHost {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = Factories::Instance().Response();
-                    FileToServe(request.Path, *result);
+                    FileToServe(request, *result);
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = Factories::Instance().Response();
@@ -909,7 +1007,8 @@ namespace PluginHost {
 
                         Unlock();
 
-                        Activate(_reason);
+                        // Activates on the worker pool, or right here if the pool is too small for that.
+                        _administrator.Activate(*this, _reason);
 
                         Lock();
                     }
@@ -1688,6 +1787,10 @@ namespace PluginHost {
                 {
                     return (_subSystems.Value());
                 }
+                inline void Activate(Service& service, const PluginHost::IShell::reason why)
+                {
+                    _server._activator.Submit(Core::ProxyType<Service>(service), why, true);
+                }
                 inline ISubSystem* SubSystemsInterface()
                 {
                     return (reinterpret_cast<ISubSystem*>(_subSystems.QueryInterface(ISubSystem::ID)));
@@ -1980,6 +2083,248 @@ namespace PluginHost {
                 IAuthenticate* _authenticationHandler;
             };
 
+        // Activates plugins on the worker pool: the autostart plugins at startup and, later on, the
+        // plugins whose preconditions are met. Plugins are activated concurrently, but two threads of
+        // the pool are always kept free: plugins running out of process need a free thread to handle
+        // their COM-RPC calls while they initialize. A pool that can not spare two threads activates
+        // on the thread that submits, one plugin at a time. Plugins waiting for a subsystem are submitted again
+        // by their Evaluate once the subsystem is set. The activation that set it is not known, so
+        // the one running at that moment, or else the one completed last, is taken as the one they
+        // waited for. That yields the critical path of the startup.
+        class EXTERNAL Activator {
+        private:
+            Activator() = delete;
+            Activator(const Activator&) = delete;
+            Activator& operator=(const Activator&) = delete;
+
+            static constexpr uint8_t Concurrent = (THREADPOOL_COUNT > 2 ? THREADPOOL_COUNT - 2 : 0);
+            static constexpr uint32_t NoStep = static_cast<uint32_t>(~0);
+
+            class Job : public Core::IDispatchType<void> {
+            private:
+                Job() = delete;
+                Job(const Job&) = delete;
+                Job& operator=(const Job&) = delete;
+
+            public:
+                Job(Activator* parent, const Core::ProxyType<Service>& service, const PluginHost::IShell::reason why, const bool waited)
+                    : _parent(*parent)
+                    , _service(service)
+                    , _why(why)
+                    , _waited(waited)
+                    , _queued(Core::Time::Monotonic())
+                {
+                    ASSERT(parent != nullptr);
+                }
+                virtual ~Job()
+                {
+                }
+
+            public:
+                virtual void Dispatch() override
+                {
+                    _parent.Activate(*this);
+                }
+
+            private:
+                friend class Activator;
+
+                Activator& _parent;
+                Core::ProxyType<Service> _service;
+                const PluginHost::IShell::reason _why;
+                const bool _waited;
+                const uint64_t _queued;
+            };
+
+            struct Step {
+                string Callsign;
+                bool Waited;
+                uint64_t Queued;
+                uint64_t Begin;
+                uint64_t End;
+            };
+
+        public:
+            Activator(Core::WorkerPool& workerPool)
+                : _adminLock()
+                , _workerPool(workerPool)
+                , _pending()
+                , _running()
+                , _idle(true, true)
+                , _closed(false)
+                , _steps()
+                , _waiting()
+                , _begin(0)
+                , _reported(0)
+            {
+            }
+            ~Activator()
+            {
+                ASSERT(_running.empty() == true);
+            }
+
+        public:
+            void Submit(const Core::ProxyType<Service>& service, const PluginHost::IShell::reason why, const bool waited = false)
+            {
+                Core::ProxyType<Job> inlined;
+
+                _adminLock.Lock();
+
+                // A service is activated once, submitting it again while its job is pending or running does not add one.
+                if ((_closed == false) && (IsSubmitted(service) == false)) {
+                    if ((why == PluginHost::IShell::STARTUP) && (_begin == 0)) {
+                        _begin = Core::Time::Monotonic();
+                    }
+
+                    Core::ProxyType<Job> job(Core::ProxyType<Job>::Create(this, service, why, waited));
+
+                    if (Concurrent == 0) {
+                        _idle.ResetEvent();
+                        _running.push_back(job);
+                        inlined = job;
+                    } else if (_running.size() < Concurrent) {
+                        Start(job);
+                    } else {
+                        _pending.push_back(job);
+                    }
+                }
+
+                _adminLock.Unlock();
+
+                if (inlined.IsValid() == true) {
+                    Activate(*inlined);
+                }
+            }
+            // Stop activating, and wait for the activations in progress to complete.
+            void Close()
+            {
+                _adminLock.Lock();
+
+                _closed = true;
+                _pending.clear();
+
+                std::list<Core::ProxyType<Job>>::iterator index(_running.begin());
+
+                while (index != _running.end()) {
+                    if (_workerPool.Revoke(Core::ProxyType<Core::IDispatch>(*index), 0) == Core::ERROR_NONE) {
+                        index = _running.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+
+                if (_running.empty() == true) {
+                    _idle.SetEvent();
+                }
+
+                _adminLock.Unlock();
+
+                _idle.Lock(Core::infinite);
+            }
+
+        private:
+            bool IsSubmitted(const Core::ProxyType<Service>& service) const
+            {
+                bool result = false;
+                std::list<Core::ProxyType<Job>>::const_iterator index(_running.begin());
+
+                while ((result == false) && (index != _running.end())) {
+                    result = ((*index)->_service == service);
+                    index++;
+                }
+
+                index = _pending.begin();
+
+                while ((result == false) && (index != _pending.end())) {
+                    result = ((*index)->_service == service);
+                    index++;
+                }
+
+                return (result);
+            }
+            void Start(const Core::ProxyType<Job>& job)
+            {
+                _idle.ResetEvent();
+                _running.push_back(job);
+                _workerPool.Submit(Core::ProxyType<Core::IDispatch>(job));
+            }
+            void Activate(Job& job)
+            {
+                const uint64_t begin = Core::Time::Monotonic();
+
+                uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+                // The preconditions may have been lost again, or the plugin activated otherwise, since it was submitted.
+                if ((job._waited == false) || (job._service->State() == PluginHost::IShell::PRECONDITION)) {
+                    result = job._service->Activate(job._why);
+                }
+
+                const uint64_t end = Core::Time::Monotonic();
+
+                _adminLock.Lock();
+
+                if (job._why == PluginHost::IShell::STARTUP) {
+                    const string& callsign(job._service->Callsign());
+                    std::list<string>::iterator waiting(std::find(_waiting.begin(), _waiting.end(), callsign));
+
+                    if (result == Core::ERROR_PENDING_CONDITIONS) {
+                        if (waiting == _waiting.end()) {
+                            _waiting.push_back(callsign);
+                        }
+                    } else {
+                        if (waiting != _waiting.end()) {
+                            _waiting.erase(waiting);
+                        }
+                        if (result == Core::ERROR_NONE) {
+                            _steps.push_back({ callsign, job._waited, job._queued, begin, end });
+                        }
+                    }
+                }
+
+                std::list<Core::ProxyType<Job>>::iterator index(_running.begin());
+
+                while ((index != _running.end()) && (&(**index) != &job)) {
+                    index++;
+                }
+
+                ASSERT(index != _running.end());
+
+                // Keep the job alive until it returns from the dispatch.
+                Core::ProxyType<Job> current(*index);
+
+                _running.erase(index);
+
+                if ((_closed == false) && (_pending.empty() == false)) {
+                    Start(_pending.front());
+                    _pending.pop_front();
+                }
+
+                if (_running.empty() == true) {
+                    if (_steps.size() != _reported) {
+                        _reported = static_cast<uint32_t>(_steps.size());
+                        Report();
+                    }
+                    _idle.SetEvent();
+                }
+
+                _adminLock.Unlock();
+            }
+            uint32_t Predecessor(const uint32_t index) const;
+            void Report() const;
+
+        private:
+            Core::CriticalSection _adminLock;
+            Core::WorkerPool& _workerPool;
+            std::list<Core::ProxyType<Job>> _pending;
+            std::list<Core::ProxyType<Job>> _running;
+            Core::Event _idle;
+            bool _closed;
+            std::vector<Step> _steps;
+            std::list<string> _waiting;
+            uint64_t _begin;
+            uint32_t _reported;
+        };
+
             // Connection handler is the listening socket and keeps track of all open
             // Links. A Channel is identified by an ID, this way, whenever a link dies
             // (is closed) during the service process, the ChannelMap will
@@ -1989,6 +2334,14 @@ namespace PluginHost {
                 Channel(const Channel& copy) = delete;
                 Channel& operator=(const Channel&) = delete;
 
+            public:
+                // The response to one of the requests received on this channel. Requests might be
+                // pipelined, so the response can only be sent once all earlier requests are answered.
+                struct Answer {
+                    Core::ProxyType<Web::Request> Request;
+                    Core::ProxyType<Web::Response> Response;
+                };
+
             private:
                 class EXTERNAL WebRequestJob : public Core::IDispatchType<void> {
                 private:
@@ -2073,15 +2426,10 @@ namespace PluginHost {
                                 if (response->CacheControl.IsSet() == false)
                                     response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
 
-                                _server->Dispatcher().Submit(_ID, response);
+                                _server->Dispatcher().Submit(_ID, Answer{ _request, response });
                             } else {
                                 // Fire and forget, We are done !!!
-                                _server->Dispatcher().Submit(_ID, _missingResponse);
-                            }
-
-                            if (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE) {
-                                TRACE(Activity, (_T("HTTP Request with direct close on [%d]"), _ID));
-                                _server->Dispatcher().Suspend(_ID);
+                                _server->Dispatcher().Submit(_ID, Answer{ _request, _missingResponse });
                             }
 
                             // We are done, clear all info
@@ -2235,6 +2583,148 @@ namespace PluginHost {
                     string _text;
                 };
 
+                // Executes the calls of a JSON-RPC batch concurrently on the worker pool, once allowed, and
+                // sends the response to the batch back over the channel it came in on.
+                class EXTERNAL BatchResponse : public PluginHost::Channel::Batch {
+                private:
+                    BatchResponse() = delete;
+                    BatchResponse(const BatchResponse&) = delete;
+                    BatchResponse& operator=(const BatchResponse&) = delete;
+
+                public:
+                    BatchResponse(Server* server, const uint32_t id, const Core::ProxyType<Service>& service, ISecurity* security, const Core::ProxyType<Web::Request>& request)
+                        : PluginHost::Channel::Batch()
+                        , _server(server)
+                        , _ID(id)
+                        , _service(service)
+                        , _security(security)
+                        , _request(request)
+                    {
+                    }
+                    ~BatchResponse() override
+                    {
+                    }
+
+                protected:
+                    void Call(const uint32_t index, const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& call) override
+                    {
+                        if ((_security == nullptr) || (_security->Allowed(*call) == false)) {
+                            if (call->Id.IsSet() == false) {
+                                Completed(index, Core::ProxyType<Core::JSONRPC::Message>());
+                            } else {
+                                call->Designator.Clear();
+                                call->Parameters.Clear();
+                                call->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                                call->Error.SetError(Core::ERROR_PRIVILIGED_REQUEST);
+                                call->Error.Text = _T("Request needs authorization, but it was not authorized");
+                                Completed(index, Core::ProxyType<Core::JSONRPC::Message>(call));
+                            }
+                        } else {
+                            Core::ProxyType<BatchJob> job(_batchJobs.Element());
+                            Core::ProxyType<Core::JSONRPC::Message> message(call);
+                            Core::ProxyType<BatchResponse> batch(*this);
+
+                            ASSERT(job.IsValid() == true);
+
+                            job->Set(_ID, _service, message, batch, index);
+                            _server->Submit(Core::proxy_cast<Core::IDispatch>(job));
+                        }
+                    }
+                    void Reply(const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& body) override
+                    {
+                        if (_request.IsValid() == false) {
+                            // Came in over a websocket, if it were all notifications, there is nothing to send.
+                            if (body->IsSet() == true) {
+                                _server->Dispatcher().Submit(_ID, Core::ProxyType<Core::JSON::IElement>(body));
+                            }
+                        } else {
+                            Core::ProxyType<Web::Response> response(Factories::Instance().Response());
+
+                            if (body->IsSet() == true) {
+                                response->ErrorCode = Web::STATUS_OK;
+                                response->Message = _T("JSONRPC executed succesfully");
+                                response->Body(body);
+                            } else {
+                                response->ErrorCode = Web::STATUS_NO_CONTENT;
+                            }
+                            response->AccessControlOrigin = _T("*");
+                            response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
+
+                            _server->Dispatcher().Submit(_ID, Answer{ _request, response });
+                        }
+                    }
+
+                private:
+                    Server* _server;
+                    uint32_t _ID;
+                    Core::ProxyType<Service> _service;
+                    // Only consulted while the batch is split in to its calls, the caller holds a reference.
+                    ISecurity* _security;
+                    Core::ProxyType<Web::Request> _request;
+                };
+
+                class EXTERNAL BatchJob : public Core::IDispatchType<void> {
+                private:
+                    BatchJob(const BatchJob&) = delete;
+                    BatchJob& operator=(const BatchJob&) = delete;
+
+                public:
+                    BatchJob()
+                        : _ID(0)
+                        , _service()
+                        , _message()
+                        , _batch()
+                        , _index(0)
+                    {
+                    }
+                    virtual ~BatchJob()
+                    {
+                        ASSERT((_message.IsValid() == false) && (_service.IsValid() == false) && (_batch.IsValid() == false));
+                    }
+
+                public:
+                    void Set(const uint32_t id, Core::ProxyType<Service>& service, Core::ProxyType<Core::JSONRPC::Message>& message, Core::ProxyType<BatchResponse>& batch, const uint32_t index)
+                    {
+                        ASSERT(_message.IsValid() == false);
+                        ASSERT(_service.IsValid() == false);
+
+                        _service = service;
+                        _message = message;
+                        _batch = batch;
+                        _index = index;
+                        _ID = id;
+                    }
+                    virtual void Dispatch()
+                    {
+                        ASSERT((_message.IsValid() == true) && (_service.IsValid() == true) && (_batch.IsValid() == true));
+
+                        Core::ProxyType<Core::JSONRPC::Message> response;
+                        PluginHost::IDispatcher* dispatcher = _service->Dispatcher();
+
+                        ASSERT(dispatcher != nullptr);
+
+                        if ((dispatcher != nullptr) && (_message->Id.IsSet() == true)) {
+                            response = dispatcher->Invoke(_ID, *_message);
+                        } else if (dispatcher != nullptr) {
+                            dispatcher->Invoke(_ID, *_message);
+                        }
+
+                        _batch->Completed(_index, response);
+
+                        // We are done, clear all info
+                        _service.Release();
+                        _message.Release();
+                        _batch.Release();
+                    }
+
+                private:
+                    uint32_t _ID;
+                    Core::ProxyType<Service> _service;
+                    Core::ProxyType<Core::JSONRPC::Message> _message;
+                    Core::ProxyType<BatchResponse> _batch;
+                    uint32_t _index;
+                };
+
             public:
                 Channel(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Channel>* parent);
                 virtual ~Channel();
@@ -2272,7 +2762,20 @@ namespace PluginHost {
                     PluginHost::Channel::Unlock();
                 }
 
+                using PluginHost::Channel::Submit;
+
+                void Submit(const Answer& answer)
+                {
+                    Respond(answer.Request, answer.Response);
+                }
+
             private:
+                void Execute(Core::ProxyType<Service>& service, const Core::JSONRPC::Batch& batch, ISecurity* security, const Core::ProxyType<Web::Request>& request)
+                {
+                    Core::ProxyType<BatchResponse> collector(Core::ProxyType<BatchResponse>::Create(&_parent, Id(), service, security, request));
+
+                    collector->Execute(batch);
+                }
                 bool Allowed(const string& pathParameter, const string& queryParameters)
                 {
                     Core::URL::KeyValue options(queryParameters);
@@ -2333,8 +2836,20 @@ namespace PluginHost {
                 virtual void Received(Core::ProxyType<Request>& request)
                 {
                     ISecurity* security = nullptr;
+                    Core::ProxyType<Web::Request> baseRequest(Core::proxy_cast<Web::Request>(request));
+                    Core::ProxyType<Core::JSONRPC::Batch> batch;
 
-                    TRACE(WebFlow, (Core::proxy_cast<Web::Request>(request)));
+                    TRACE(WebFlow, (baseRequest));
+
+                    PluginHost::Channel::Pipeline(baseRequest);
+
+                    if ((request->State() == Request::COMPLETE) && (request->HasBody() == true)) {
+                        batch = request->Body<Core::JSONRPC::Batch>();
+
+                        if ((batch.IsValid() == true) && (batch->IsBatch() == false)) {
+                            batch.Release();
+                        }
+                    }
 
                     // See if a token has been hooked up to the request, maybe we need a
                     // different security provider.
@@ -2361,8 +2876,8 @@ namespace PluginHost {
                         PluginHost::Channel::Unlock();
                     }
 
-                    // See if we are allowed to process this request..
-                    if ((security == nullptr) || (security->Allowed(*request) == false)) {
+                    // See if we are allowed to process this request, the calls in a batch are judged one by one..
+                    if ((security == nullptr) || ((batch.IsValid() == false) && (security->Allowed(*request) == false))) {
                         request->Unauthorized();
                     } else {
                         // If there was no body, we are still incomplete.
@@ -2373,7 +2888,7 @@ namespace PluginHost {
                             uint32_t status = _parent.Services().FromLocator(request->Path, service, serviceCall);
 
                             request->Service(status, Core::proxy_cast<PluginHost::Service>(service), serviceCall);
-                        } else if ((request->State() == Request::COMPLETE) && (request->HasBody() == true)) {
+                        } else if ((request->State() == Request::COMPLETE) && (request->HasBody() == true) && (batch.IsValid() == false)) {
                             Core::ProxyType<Core::JSONRPC::Message> message(request->Body<Core::JSONRPC::Message>());
                             if ((message.IsValid() == true) && (security->Allowed(*message) == false)) {
                                 request->Unauthorized();
@@ -2381,11 +2896,6 @@ namespace PluginHost {
                         }
                     }
 
-                    if (security != nullptr) {
-                        // We are done with the security related items, let go of the officer.
-                        security->Release();
-                    }
-
                     switch (request->State()) {
                     case Request::OBLIVIOUS: {
                         Core::ProxyType<Web::Response> result(Factories::Instance().Response());
@@ -2398,23 +2908,23 @@ namespace PluginHost {
                             result->Message = "Not Found";
                         }
 
-                        Submit(result);
+                        Respond(baseRequest, result);
 
                         break;
                     }
                     case Request::MISSING_CALLSIGN: {
                         // Report that we, at least, need a call sign.
-                        Submit(_missingCallsign);
+                        Respond(baseRequest, _missingCallsign);
                         break;
                     }
                     case Request::INVALID_VERSION: {
                         // Report that we, at least, need a call sign.
-                        Submit(_incorrectVersion);
+                        Respond(baseRequest, _incorrectVersion);
                         break;
                     }
                     case Request::UNAUTHORIZED: {
                         // Report that we, at least, need a call sign.
-                        Submit(_unauthorizedRequest);
+                        Respond(baseRequest, _unauthorizedRequest);
                         break;
                     }
                     case Request::COMPLETE: {
@@ -2426,7 +2936,9 @@ namespace PluginHost {
 
                         if (response.IsValid() == true) {
                             // Report that the calls sign could not be found !!
-                            Submit(response);
+                            Respond(baseRequest, response);
+                        } else if (batch.IsValid() == true) {
+                            Execute(service, *batch, security, baseRequest);
                         } else {
                             // Send the Request object out to be handled.
                             // By definition, we can issue it on a rental thread..
@@ -2435,7 +2947,6 @@ namespace PluginHost {
                             ASSERT(job.IsValid() == true);
 
                             if (job.IsValid() == true) {
-                                Core::ProxyType<Web::Request> baseRequest(Core::proxy_cast<Web::Request>(request));
                                 job->Set(Id(), service, baseRequest, !request->ServiceCall());
                                 _parent.Submit(Core::proxy_cast<Core::IDispatchType<void>>(job));
                             }
@@ -2447,10 +2958,20 @@ namespace PluginHost {
                         ASSERT(false);
                     }
                     }
+
+                    if (security != nullptr) {
+                        // We are done with the security related items, let go of the officer.
+                        security->Release();
+                    }
                 }
                 virtual void Send(const Core::ProxyType<Web::Response>& response)
                 {
                     TRACE(WebFlow, (response));
+
+                    if (PluginHost::Channel::Responded(response) == true) {
+                        TRACE(Activity, (_T("HTTP Request with direct close on [%d]"), Id()));
+                        Close(0);
+                    }
                 }
 
                 // Handle the JSON structs flowing over the WebSocket.
@@ -2483,8 +3004,22 @@ namespace PluginHost {
                     TRACE(SocketFlow, (element));
 
                     if (State() & Channel::JSONRPC) {
+                        Core::ProxyType<Core::JSONRPC::Batch> batch(Core::proxy_cast<Core::JSONRPC::Batch>(element));
                         Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(element));
-                        if (message.IsValid()) {
+
+                        if ((batch.IsValid() == true) && (batch->IsBatch() == true)) {
+                            PluginHost::Channel::Lock();
+                            ISecurity* security = _security;
+                            security->AddRef();
+                            PluginHost::Channel::Unlock();
+
+                            Execute(_service, *batch, security, Core::ProxyType<Web::Request>());
+
+                            security->Release();
+
+                            // The calls are on their way, there is nothing left to do for the batch itself.
+                            securityClearance = false;
+                        } else if (message.IsValid()) {
                             PluginHost::Channel::Lock();
                             securityClearance = _security->Allowed(*message);
                             PluginHost::Channel::Unlock();
@@ -2529,29 +3064,33 @@ namespace PluginHost {
 
                 // We are in an upgraded mode, we are a websocket. Time to "deserialize and serialize
                 // INBOUND and OUTBOUND information.
-                virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+                virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
                 {
-                    uint16_t result = 0;
+                    return (Core::Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                        uint16_t result;
 
-                    if (State() == RAW) {
-                        result = _service->Outbound(Id(), dataFrame, maxSendSize);
-                    } else {
-                        result = PluginHost::Channel::Serialize(dataFrame, maxSendSize);
-                    }
+                        if (State() == RAW) {
+                            result = static_cast<uint16_t>(_service->Outbound(Id(), &(dataFrame[offset]), size));
+                        } else {
+                            result = PluginHost::Channel::Serialize(&(dataFrame[offset]), size);
+                        }
 
-                    return (result);
+                        return (result);
+                    }));
                 }
-                virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+                virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
                 {
-                    uint16_t result = receivedSize;
+                    return (Core::Chunked(receivedSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                        uint16_t result;
 
-                    if (State() == RAW) {
-                        result = _service->Inbound(Id(), dataFrame, receivedSize);
-                    } else {
-                        result = PluginHost::Channel::Deserialize(dataFrame, receivedSize);
-                    }
+                        if (State() == RAW) {
+                            result = static_cast<uint16_t>(_service->Inbound(Id(), &(dataFrame[offset]), size));
+                        } else {
+                            result = PluginHost::Channel::Deserialize(&(dataFrame[offset]), size);
+                        }
 
-                    return (result);
+                        return (result);
+                    }));
                 }
 
                 // Whenever there is a state change on the link, it is reported here.
@@ -2561,6 +3100,8 @@ namespace PluginHost {
 
                     // If we are closing (or closed) do the clean up
                     if (IsOpen() == false) {
+                        PluginHost::Channel::Abandon();
+
                         if (_service.IsValid() == true) {
                             _service->Unsubscribe(*this);
 
@@ -2637,6 +3178,7 @@ namespace PluginHost {
                 static Core::ProxyPoolType<WebRequestJob> _webJobs;
                 static Core::ProxyPoolType<JSONElementJob> _jsonJobs;
                 static Core::ProxyPoolType<TextJob> _textJobs;
+                static Core::ProxyPoolType<BatchJob> _batchJobs;
 
                 // If there is no call sign or the associated handler does not exist,
                 // we can return a proper answer, without dispatching.
@@ -2689,10 +3231,16 @@ namespace PluginHost {
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
-                ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer)
+                ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer, const Config::OutboundConfig& outbound, const Config::CompressionConfig& compression)
                     : Core::SocketServerType<Channel>(listeningNode)
                     , _parent(parent)
                     , _connectionCheckTimer(connectionCheckTimer * 1000)
+                    , _highWatermark(outbound.HighWatermark.Value())
+                    , _lowWatermark(std::min(outbound.LowWatermark.Value(), outbound.HighWatermark.Value()))
+                    , _policy(outbound.Policy.Value())
+                    , _compression(compression.Enabled.Value())
+                    , _contextTakeover(compression.ContextTakeover.Value())
+                    , _threshold(compression.Threshold.Value())
                     , _job(Core::ProxyType<Job>::Create(this))
                 {
                     if (connectionCheckTimer != 0) {
@@ -2748,6 +3296,30 @@ namespace PluginHost {
                 {
                     return (Core::SocketServerType<Channel>::Count());
                 }
+                inline uint32_t HighWatermark() const
+                {
+                    return (_highWatermark);
+                }
+                inline uint32_t LowWatermark() const
+                {
+                    return (_lowWatermark);
+                }
+                inline PluginHost::Channel::EventPolicy Policy() const
+                {
+                    return (_policy);
+                }
+                inline bool Compression() const
+                {
+                    return (_compression);
+                }
+                inline bool ContextTakeover() const
+                {
+                    return (_contextTakeover);
+                }
+                inline uint16_t Threshold() const
+                {
+                    return (_threshold);
+                }
                 void GetMetaData(Core::JSON::ArrayType<MetaData::Channel>& metaData) const;
 
             private:
@@ -2784,6 +3356,12 @@ namespace PluginHost {
             private:
                 Server& _parent;
                 const uint32_t _connectionCheckTimer;
+                const uint32_t _highWatermark;
+                const uint32_t _lowWatermark;
+                const PluginHost::Channel::EventPolicy _policy;
+                const bool _compression;
+                const bool _contextTakeover;
+                const uint16_t _threshold;
                 Core::ProxyType<Core::IDispatchType<void>> _job;
             };
 
@@ -2865,6 +3443,9 @@ namespace PluginHost {
             // Maintain a list of all the loaded plugin servers. Here we can dispatch work to.
             ServiceMap _services;
 
+            // Activates the plugins on the worker pool, as far as their preconditions allow.
+            Activator _activator;
+
             PluginHost::InputHandler _inputHandler;
 
             // Hold on to the controller that controls the PluginHost. Using this plugin, the
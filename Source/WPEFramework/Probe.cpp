@@ -243,7 +243,7 @@ namespace Plugin {
         return (response);
     }
 
-    /* virtual*/ uint16_t Probe::Broadcaster::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+    /* virtual*/ uint32_t Probe::Broadcaster::ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
     {
 
         uint64_t stamp(Core::NumberType<uint64_t>(Core::Time::Now().Ticks()));
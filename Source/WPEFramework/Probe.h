@@ -133,7 +133,7 @@ namespace Plugin {
                 }
             }
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
 
                 // We assume that this all fit a datagram. The datagram will *NOT* cross the datagram boundries.
@@ -172,7 +172,7 @@ namespace Plugin {
             {
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize);
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize);
 
         private:
             std::string CreateRequest()
@@ -89,7 +89,7 @@ namespace Process {
         WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
 
         WorkerPoolImplementation(const uint8_t threads, const uint32_t stackSize)
-            : WorkerPool(threads, reinterpret_cast<uint32_t*>(::malloc(sizeof(uint32_t) * threads)))
+            : WorkerPool(threads, reinterpret_cast<uint32_t*>(::malloc(sizeof(uint32_t) * threads)), reinterpret_cast<uint32_t*>(::malloc(sizeof(uint32_t) * threads)), false)
             , _minions()
             , _announceHandler(nullptr)
             , _administration(Core::ServiceAdministrator::Instance())
@@ -108,6 +108,7 @@ namespace Process {
             Stop();
             _minions.clear();
             delete Snapshot().Slot;
+            ::free(Snapshot().Steals);
         }
         void Announcements(Core::IIPCServer* announces)
         {
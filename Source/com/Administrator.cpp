@@ -10,6 +10,10 @@ namespace RPC {
         , _proxy()
         , _factory(8)
         , _channelProxyMap()
+        , _channelReferenceMap()
+        , _ringLock()
+        , _rings()
+        , _reclaimer(Core::ProxyType<Core::IIPCServer>(Core::ProxyType<Reclaimer>::Create()))
     {
     }
 
@@ -140,6 +144,49 @@ namespace RPC {
 
         _adminLock.Unlock();
     }
+
+    void Administrator::RegisterRing(Core::IPCChannel* channel, const Core::ProxyType<SharedRing>& ring)
+    {
+        ASSERT((channel != nullptr) && (ring.IsValid() == true));
+
+        _ringLock.Lock();
+
+        _rings[channel] = ring;
+
+        _ringLock.Unlock();
+
+        channel->Reclaimer(_reclaimer);
+    }
+
+    void Administrator::UnregisterRing(const Core::IPCChannel* channel)
+    {
+        _ringLock.Lock();
+
+        RingMap::iterator index(_rings.find(channel));
+
+        if (index != _rings.end()) {
+            _rings.erase(index);
+        }
+
+        _ringLock.Unlock();
+    }
+
+    Core::ProxyType<SharedRing> Administrator::Ring(const Core::IPCChannel* channel) const
+    {
+        Core::ProxyType<SharedRing> result;
+
+        _ringLock.Lock();
+
+        RingMap::const_iterator index(_rings.find(channel));
+
+        if (index != _rings.end()) {
+            result = index->second;
+        }
+
+        _ringLock.Unlock();
+
+        return (result);
+    }
     void* Administrator::ProxyFind(const Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t id, const uint32_t interfaceId)
     {
         void* result = nullptr;
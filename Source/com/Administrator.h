@@ -86,6 +86,36 @@ namespace RPC {
         typedef std::list<ProxyStub::UnknownProxy*> ProxyList;
         typedef std::map<const Core::IPCChannel*, ProxyList> ChannelMap;
         typedef std::map<const Core::IPCChannel*, std::list<ExternalReference>> ReferenceMap;
+        typedef std::map<const Core::IPCChannel*, Core::ProxyType<SharedRing>> RingMap;
+
+        // A response that arrives after its call timed out, is not collected by the caller anymore.
+        // Hand back the ring slot it occupies, otherwise the ring slowly fills up.
+        class EXTERNAL Reclaimer : public Core::IIPCServer {
+        private:
+            Reclaimer(const Reclaimer&) = delete;
+            Reclaimer& operator=(const Reclaimer&) = delete;
+
+        public:
+            Reclaimer()
+            {
+            }
+            virtual ~Reclaimer()
+            {
+            }
+
+        public:
+            virtual void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data) override
+            {
+                if (data->Label() == InvokeMessage::Id()) {
+                    Core::ProxyType<InvokeMessage> message(data);
+                    Core::ProxyType<SharedRing> ring(Administrator::Instance().Ring(&source));
+
+                    if (ring.IsValid() == true) {
+                        message->Response().Collect(*ring);
+                    }
+                }
+            }
+        };
 
         struct EXTERNAL IMetadata {
             virtual ~IMetadata(){};
@@ -163,6 +193,11 @@ namespace RPC {
         void RegisterProxy(ProxyStub::UnknownProxy& proxy);
         void UnregisterProxy(ProxyStub::UnknownProxy& proxy);
 
+        // The SharedRing, if any, that large frames on this channel can be exchanged through.
+        void RegisterRing(Core::IPCChannel* channel, const Core::ProxyType<SharedRing>& ring);
+        void UnregisterRing(const Core::IPCChannel* channel);
+        Core::ProxyType<SharedRing> Ring(const Core::IPCChannel* channel) const;
+
         void RegisterInterface(Core::ProxyType<Core::IPCChannel>& channel, void* reference, const uint32_t id)
         {
             RegisterInterface(channel, Convert(reference, id), reference, id);
@@ -209,6 +244,9 @@ namespace RPC {
         Core::ProxyPoolType<InvokeMessage> _factory;
         ChannelMap _channelProxyMap;
         ReferenceMap _channelReferenceMap;
+        mutable Core::CriticalSection _ringLock;
+        RingMap _rings;
+        Core::ProxyType<Core::IIPCServer> _reclaimer;
     };
 
     class EXTERNAL Job : public Core::IDispatch {
@@ -276,7 +314,16 @@ namespace RPC {
 		{
             Core::ProxyType<InvokeMessage> message(data);
             ASSERT(message.IsValid() == true);
-            _administrator.Invoke(channel, message);
+
+            Core::ProxyType<SharedRing> ring(_administrator.Ring(channel.operator->()));
+
+            if (ring.IsValid() == true) {
+                message->Parameters().Collect(*ring);
+                _administrator.Invoke(channel, message);
+                message->Response().Share(*ring);
+            } else {
+                _administrator.Invoke(channel, message);
+            }
             channel->ReportResponse(data);
 
 		}
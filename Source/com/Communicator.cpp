@@ -452,6 +452,8 @@ namespace RPC {
             }
         } else {
             TRACE_L1("Connection to the server is down");
+
+            RPC::Administrator::Instance().UnregisterRing(this);
         }
     }
 
@@ -477,6 +479,17 @@ namespace RPC {
                 // Also load the ProxyStubs before we do anything else
                 RPC::LoadProxyStubs(proxyStubPath);
             }
+
+            string sharedRing(announceMessage->Response().SharedRing());
+            if ((sharedRing.empty() == false) && (RPC::Administrator::Instance().Ring(this).IsValid() == false)) {
+                // The other side offers a ring for the larger frames, attach to it.
+                Core::ProxyType<RPC::SharedRing> ring(Core::ProxyType<RPC::SharedRing>::Create(sharedRing));
+
+                if (ring->IsValid() == true) {
+                    RPC::Administrator::Instance().RegisterRing(this, ring);
+                    ring->Attach();
+                }
+            }
         }
 
         // Set event so WaitForCompletion() can continue.
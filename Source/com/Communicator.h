@@ -1054,8 +1054,9 @@ namespace RPC {
                     // Anounce the interface as completed
                     string jsonDefaultCategories(Trace::TraceUnit::Instance().Defaults());
                     void* result = _parent.Announce(proxyChannel, message->Parameters());
+                    string sharedRing(_parent.Ring(channel));
 
-                    message->Response().Set(result, proxyChannel->Extension().Id(), _parent.ProxyStubPath(), jsonDefaultCategories);
+                    message->Response().Set(result, proxyChannel->Extension().Id(), _parent.ProxyStubPath(), jsonDefaultCategories, sharedRing);
 
                     // We are done, report completion
                     channel.ReportResponse(data);
@@ -1097,6 +1098,8 @@ namespace RPC {
                 , _proxyStubPath(proxyStubPath)
                 , _connections(processes)
                 , _announceHandler(this)
+                , _local(remoteNode.Type() == Core::NodeId::TYPE_DOMAIN)
+                , _rings(0)
             {
                 BaseClass::Register(InvokeMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<InvokeHandlerImplementation>::Create()));
                 BaseClass::Register(AnnounceMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<AnnounceHandlerImplementation>::Create(this)));
@@ -1110,6 +1113,8 @@ namespace RPC {
                 , _proxyStubPath(proxyStubPath)
                 , _connections(processes)
                 , _announceHandler(this)
+                , _local(remoteNode.Type() == Core::NodeId::TYPE_DOMAIN)
+                , _rings(0)
             {
                 BaseClass::Register(InvokeMessage::Id(), handler);
                 BaseClass::Register(AnnounceMessage::Id(), handler);
@@ -1140,11 +1145,39 @@ namespace RPC {
                 // We are in business, register the process with this channel.
                 return (_connections.Announce(channel, info));
             }
+            string Ring(Core::IPCChannel& channel)
+            {
+                string result;
+
+                // Rings are only offered to processes on this device, connected over a domain socket.
+                if ((_local == true) && (SharedRing::DefaultSlots() > 0)) {
+                    Core::ProxyType<SharedRing> ring(Administrator::Instance().Ring(&channel));
+
+                    if (ring.IsValid() == false) {
+                        string fileName(BaseClass::Connector() + _T(".ring.") + Core::NumberType<uint32_t>(++_rings).Text());
+
+                        ring = Core::ProxyType<SharedRing>::Create(fileName, SharedRing::DefaultSlots());
+
+                        if (ring->IsValid() == true) {
+                            Administrator::Instance().RegisterRing(&channel, ring);
+                        } else {
+                            ring.Release();
+                        }
+                    }
+                    if (ring.IsValid() == true) {
+                        result = ring->Name();
+                    }
+                }
+
+                return (result);
+            }
 
         private:
             const string _proxyStubPath;
             RemoteConnectionMap& _connections;
             AnnounceHandlerImplementation _announceHandler;
+            const bool _local;
+            std::atomic<uint32_t> _rings;
         };
 
     private:
@@ -1211,6 +1244,7 @@ namespace RPC {
             std::list<RPC::ExposedInterface> pendingInterfaces;
 
             RPC::Administrator::Instance().DeleteChannel(channel, deadProxies, pendingInterfaces);
+            RPC::Administrator::Instance().UnregisterRing(channel.operator->());
 
             std::list<ProxyStub::UnknownProxy*>::const_iterator loop(deadProxies.begin());
             while (loop != deadProxies.end()) {
@@ -153,8 +153,19 @@ namespace ProxyStub {
         {
             ASSERT(_channel.IsValid() == true);
 
+            Core::ProxyType<RPC::SharedRing> ring(RPC::Administrator::Instance().Ring(_channel.operator->()));
+
+            if (ring.IsValid() == true) {
+                message->Parameters().Share(*ring);
+            }
+
             uint32_t result = _channel->Invoke(message, waitTime);
 
+            // Whatever the outcome, a response that did make it into the ring must give up its slot.
+            if (ring.IsValid() == true) {
+                message->Response().Collect(*ring);
+            }
+
             if (result != Core::ERROR_NONE) {
                 // Oops something failed on the communication. Report it.
                 TRACE_L1("IPC method invokation failed for 0x%X", message->Parameters().InterfaceId());
@@ -2,6 +2,7 @@
 #define __COM_MESSAGES_H
 
 #include "Module.h"
+#include "SharedRing.h"
 
 namespace WPEFramework {
 namespace RPC {
@@ -9,13 +10,27 @@ namespace RPC {
     namespace Data {
         static const uint16_t IPC_BLOCK_SIZE = 512;
 
+        // On the wire, a frame starts with a byte telling if the data follows inline, or if it has
+        // been placed in a slot of the SharedRing of the connection, in which case only the slot
+        // index and the length follow. With that byte, a full frame takes 64KB on the wire, so the
+        // offsets into it are 32 bits.
         class Frame : public Core::FrameType<IPC_BLOCK_SIZE> {
         private:
             Frame(Frame&) = delete;
             Frame& operator=(const Frame&) = delete;
 
+            typedef Core::FrameType<IPC_BLOCK_SIZE> BaseClass;
+
+            enum kind : uint8_t {
+                INLINE = 0,
+                SHARED = 1
+            };
+
+            static constexpr uint8_t DescriptorSize = sizeof(uint16_t) + sizeof(uint32_t);
+
         public:
             Frame()
+                : _slot(SharedRing::NoSlot)
             {
             }
             ~Frame()
@@ -27,22 +42,105 @@ namespace RPC {
             friend class Output;
             friend class ObjectInterface;
 
-            uint16_t Serialize(const uint16_t offset, uint8_t stream[], const uint16_t maxLength) const
+            inline void Clear()
+            {
+                _slot = SharedRing::NoSlot;
+                BaseClass::Clear();
+            }
+            inline uint32_t Length() const
+            {
+                return (1 + (_slot == SharedRing::NoSlot ? Size() : DescriptorSize));
+            }
+            // Move the data of a large frame into the ring, if there is room for it.
+            void Share(SharedRing& ring)
+            {
+                if ((_slot == SharedRing::NoSlot) && (Size() > IPC_BLOCK_SIZE)) {
+                    _slot = ring.Write(&(operator[](0)), Size());
+
+                    if (_slot != SharedRing::NoSlot) {
+                        const uint32_t length = Size();
+                        ::memcpy(&(_descriptor[0]), &_slot, sizeof(_slot));
+                        ::memcpy(&(_descriptor[sizeof(_slot)]), &length, sizeof(length));
+                    }
+                }
+            }
+            // Get the data of a frame received through the ring, and hand the slot back.
+            void Collect(SharedRing& ring)
+            {
+                if (_slot != SharedRing::NoSlot) {
+                    uint32_t length = 0;
+                    const uint8_t* data = ring.Data(_slot, length);
+
+                    if ((data != nullptr) && (length <= NUMBER_MAX_UNSIGNED(uint16_t))) {
+                        Size(static_cast<uint16_t>(length));
+                        ::memcpy(&(operator[](0)), data, length);
+                        ring.Release(_slot);
+                    } else {
+                        TRACE_L1("Received an invalid shared ring slot: %d, length: %d", _slot, length);
+                    }
+
+                    _slot = SharedRing::NoSlot;
+                }
+            }
+            inline bool IsShared() const
             {
-                uint16_t copiedBytes((Size() - offset) > maxLength ? maxLength : (Size() - offset));
+                return (_slot != SharedRing::NoSlot);
+            }
 
-                ::memcpy(stream, &(operator[](offset)), copiedBytes);
+            uint16_t Serialize(const uint32_t offset, uint8_t stream[], const uint16_t maxLength) const
+            {
+                uint16_t result = 0;
+                uint32_t position = offset;
+
+                if ((position == 0) && (maxLength > 0)) {
+                    stream[0] = (_slot == SharedRing::NoSlot ? INLINE : SHARED);
+                    result = 1;
+                    position = 1;
+                }
 
-                return (copiedBytes);
+                const uint32_t size = Length() - 1;
+                const uint8_t* source = (_slot == SharedRing::NoSlot ? &(operator[](0)) : _descriptor);
+                uint16_t copiedBytes(static_cast<uint16_t>((size - (position - 1)) > static_cast<uint32_t>(maxLength - result) ? (maxLength - result) : (size - (position - 1))));
+
+                ::memcpy(&(stream[result]), &(source[position - 1]), copiedBytes);
+
+                return (result + copiedBytes);
             }
-            uint16_t Deserialize(const uint16_t offset, const uint8_t stream[], const uint16_t maxLength)
+            uint16_t Deserialize(const uint32_t offset, const uint8_t stream[], const uint16_t maxLength)
             {
-                Size(offset + maxLength);
+                uint16_t result = 0;
+                uint32_t position = offset;
 
-                ::memcpy(&(operator[](offset)), stream, maxLength);
+                if ((position == 0) && (maxLength > 0)) {
+                    _slot = (stream[0] == SHARED ? 0 : SharedRing::NoSlot);
+                    Size(0);
+                    result = 1;
+                    position = 1;
+                }
+
+                if (_slot == SharedRing::NoSlot) {
+                    // A frame never holds more than 64KB - 1, whatever the other side sends.
+                    if ((maxLength > result) && ((position - 1 + (maxLength - result)) <= NUMBER_MAX_UNSIGNED(uint16_t))) {
+                        Size(static_cast<uint16_t>(position - 1 + (maxLength - result)));
+
+                        ::memcpy(&(operator[](static_cast<uint16_t>(position - 1))), &(stream[result]), maxLength - result);
+                    }
+                } else if ((position - 1) < DescriptorSize) {
+                    uint16_t copiedBytes(static_cast<uint16_t>(static_cast<uint32_t>(maxLength - result) > (DescriptorSize - (position - 1)) ? (DescriptorSize - (position - 1)) : (maxLength - result)));
+
+                    ::memcpy(&(_descriptor[position - 1]), &(stream[result]), copiedBytes);
+
+                    if ((position - 1 + copiedBytes) == DescriptorSize) {
+                        ::memcpy(&_slot, &(_descriptor[0]), sizeof(_slot));
+                    }
+                }
 
                 return (maxLength);
             }
+
+        private:
+            uint16_t _slot;
+            uint8_t _descriptor[DescriptorSize];
         };
 
         class Input {
@@ -97,7 +195,15 @@ namespace RPC {
             }
             uint32_t Length() const
             {
-                return (_data.Size());
+                return (_data.Length());
+            }
+            inline void Share(SharedRing& ring)
+            {
+                _data.Share(ring);
+            }
+            inline void Collect(SharedRing& ring)
+            {
+                _data.Collect(ring);
             }
             inline Frame::Writer Writer()
             {
@@ -109,11 +215,11 @@ namespace RPC {
             }
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const
             {
-                return (_data.Serialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Serialize(offset, stream, maxLength));
             }
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, const uint32_t offset)
             {
-                return (_data.Deserialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Deserialize(offset, stream, maxLength));
             }
 
         private:
@@ -154,15 +260,23 @@ namespace RPC {
             }
             inline uint32_t Length() const
             {
-                return (static_cast<uint32_t>(_data.Size()));
+                return (_data.Length());
+            }
+            inline void Share(SharedRing& ring)
+            {
+                _data.Share(ring);
+            }
+            inline void Collect(SharedRing& ring)
+            {
+                _data.Collect(ring);
             }
             inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const
             {
-                return (_data.Serialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Serialize(offset, stream, maxLength));
             }
             inline uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, const uint32_t offset)
             {
-                return (_data.Deserialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Deserialize(offset, stream, maxLength));
             }
 
         private:
@@ -320,12 +434,13 @@ namespace RPC {
             {
                 _data.Clear();
             }
-            void Set(void* implementation, const uint32_t sequenceNumber, const string& proxyStubPath, const string& traceCategories)
+            void Set(void* implementation, const uint32_t sequenceNumber, const string& proxyStubPath, const string& traceCategories, const string& sharedRing = string())
             {
                 _data.SetNumber<void*>(0, implementation);
                 _data.SetNumber<uint32_t>(sizeof(void*), sequenceNumber);
                 uint16_t length = _data.SetText(sizeof(void*) + sizeof(uint32_t), proxyStubPath);
-                _data.SetText(sizeof(void*)+ sizeof(uint32_t) + length, traceCategories);
+                length += _data.SetText(sizeof(void*)+ sizeof(uint32_t) + length, traceCategories);
+                _data.SetText(sizeof(void*)+ sizeof(uint32_t) + length, sharedRing);
             }
             inline bool IsSet() const {
                 return (_data.Size() > 0);
@@ -357,6 +472,22 @@ namespace RPC {
 
                 return (value);
             }
+            string SharedRing() const
+            {
+                string value;
+
+                uint16_t length = sizeof(void*) + sizeof(uint32_t) ;   // skip implentation and sequencenumber
+                length += _data.GetText(length, value);  // skip proxyStub path
+                length += _data.GetText(length, value);  // skip trace categories
+
+                if (length < _data.Size()) {
+                    _data.GetText(length, value);
+                } else {
+                    value.clear();
+                }
+
+                return (value);
+            }
             void* Implementation() const
             {
                 void* result = nullptr;
@@ -369,15 +500,15 @@ namespace RPC {
             }
             uint32_t Length() const
             {
-                return (_data.Size());
+                return (_data.Length());
             }
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const
             {
-                return (_data.Serialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Serialize(offset, stream, maxLength));
             }
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, const uint32_t offset)
             {
-                return (_data.Deserialize(static_cast<uint16_t>(offset), stream, maxLength));
+                return (_data.Deserialize(offset, stream, maxLength));
             }
 
         private:
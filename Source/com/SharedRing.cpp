@@ -0,0 +1,71 @@
+#include "SharedRing.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    /* static */ constexpr uint32_t SharedRing::RingMagic;
+    /* static */ constexpr uint16_t SharedRing::NoSlot;
+    /* static */ constexpr uint32_t SharedRing::SlotSize;
+    /* static */ uint8_t SharedRing::_defaultSlots = 0;
+
+    SharedRing::SharedRing(const string& fileName, const uint8_t slots)
+        : _buffer(fileName,
+              Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::GROUP_WRITE | Core::File::SHAREABLE | Core::File::CREATE,
+              Offset() + (2 * slots * Stride()))
+        , _control(nullptr)
+        , _slots(slots)
+        , _creator(true)
+    {
+        ASSERT(slots > 0);
+
+        if (_buffer.IsValid() == true) {
+            _control = reinterpret_cast<Control*>(_buffer.Buffer());
+
+            _control->Magic = RingMagic;
+            _control->Slots = slots;
+            _control->Padding = 0;
+            _control->SlotSize = SlotSize;
+            _control->Attached.store(0);
+            _control->Head[0].store(0);
+            _control->Head[1].store(0);
+
+            for (uint16_t index = 0; index < (2 * slots); index++) {
+                Entry(index).State.store(FREE);
+                Entry(index).Length = 0;
+            }
+        } else {
+            TRACE_L1("Could not create the shared ring: %s", fileName.c_str());
+        }
+    }
+
+    SharedRing::SharedRing(const string& fileName)
+        : _buffer(fileName, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE, 0)
+        , _control(nullptr)
+        , _slots(0)
+        , _creator(false)
+    {
+        if ((_buffer.IsValid() == true) && (_buffer.Size() >= Offset())) {
+            Control* control = reinterpret_cast<Control*>(_buffer.Buffer());
+            const uint16_t slots = control->Slots;
+
+            // Only use it if it is what we expect it to be..
+            if ((control->Magic == RingMagic) && (control->SlotSize == SlotSize) && (slots > 0) && (_buffer.Size() >= (Offset() + (2 * slots * Stride())))) {
+                _control = control;
+                _slots = slots;
+            }
+        }
+
+        if (_control == nullptr) {
+            TRACE_L1("Could not attach to the shared ring: %s", fileName.c_str());
+        }
+    }
+
+    SharedRing::~SharedRing()
+    {
+        if ((_creator == true) && (_buffer.IsValid() == true)) {
+            // The other side has it mapped already, or will never map it, no need to keep it around.
+            Core::File(_buffer.Name()).Destroy();
+        }
+    }
+}
+}
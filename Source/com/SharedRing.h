@@ -0,0 +1,170 @@
+#ifndef __COM_SHAREDRING_H
+#define __COM_SHAREDRING_H
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    // A SharedRing is a memory mapped file, shared by the two processes on either side of a COM-RPC
+    // connection. It holds a ring of fixed size slots per direction. A large frame is copied into a
+    // free slot by the sender, the IPC message only carries the slot index, and the receiver copies
+    // it out and releases the slot. Slots can be released in any order, so responses to pipelined
+    // calls do not need to arrive in the order the calls went out. That keeps large frames out of
+    // the socket, it still takes a socket message, and so a system call, per frame, and a copy on
+    // either side.
+    // Everything in the shared memory can be written by the other process, so the geometry of the
+    // ring is taken once, and the lengths the other side reports are checked before they are used.
+    // The ring is created by the side that accepted the connection (the Communicator) and offered
+    // to the other side in the announce response. Only when the other side has attached to it, it is
+    // used in both directions. If there is no free slot, the frame simply goes inline over the socket.
+    class EXTERNAL SharedRing {
+    private:
+        SharedRing() = delete;
+        SharedRing(const SharedRing&) = delete;
+        SharedRing& operator=(const SharedRing&) = delete;
+
+        static constexpr uint32_t RingMagic = 0x52494E47; // "RING"
+
+        enum state : uint32_t {
+            FREE = 0,
+            BUSY = 1
+        };
+
+        struct Control {
+            uint32_t Magic;
+            uint16_t Slots;
+            uint16_t Padding;
+            uint32_t SlotSize;
+            std::atomic<uint32_t> Attached;
+            std::atomic<uint32_t> Head[2];
+        };
+        struct Slot {
+            std::atomic<uint32_t> State;
+            uint32_t Length;
+        };
+
+    public:
+        static constexpr uint16_t NoSlot = 0xFFFF;
+        static constexpr uint32_t SlotSize = 0x10000;
+
+        // Create the ring, this is the side that listens for connections.
+        SharedRing(const string& fileName, const uint8_t slots);
+        // Attach to a ring offered by the other side.
+        SharedRing(const string& fileName);
+        ~SharedRing();
+
+    public:
+        // The number of slots per direction the Communicator offers on new connections, 0 means
+        // none, all data goes inline over the socket.
+        static void DefaultSlots(const uint8_t slots)
+        {
+            _defaultSlots = slots;
+        }
+        static uint8_t DefaultSlots()
+        {
+            return (_defaultSlots);
+        }
+
+        inline bool IsValid() const
+        {
+            return (_control != nullptr);
+        }
+        inline bool IsAttached() const
+        {
+            return ((_control != nullptr) && (_control->Attached.load(std::memory_order_acquire) != 0));
+        }
+        inline const string& Name() const
+        {
+            return (_buffer.Name());
+        }
+        // The attaching side reports it is ready to receive data through the ring.
+        inline void Attach()
+        {
+            ASSERT((_creator == false) && (_control != nullptr));
+
+            _control->Attached.store(1, std::memory_order_release);
+        }
+
+        // Copy the data into one of our slots, returns the slot index, or NoSlot if it does not fit
+        // or all slots are still in use.
+        uint16_t Write(const uint8_t data[], const uint32_t length)
+        {
+            uint16_t result = NoSlot;
+
+            if ((length <= SlotSize) && (IsAttached() == true)) {
+                const uint8_t direction = (_creator == true ? 0 : 1);
+                uint16_t attempt = 0;
+
+                while ((result == NoSlot) && (attempt < _slots)) {
+                    uint16_t index = static_cast<uint16_t>((_control->Head[direction].fetch_add(1, std::memory_order_relaxed) % _slots) + (direction * _slots));
+                    Slot& slot(Entry(index));
+                    uint32_t expected = FREE;
+
+                    if (slot.State.compare_exchange_strong(expected, BUSY, std::memory_order_acquire) == true) {
+                        ::memcpy(&(reinterpret_cast<uint8_t*>(&slot)[sizeof(Slot)]), data, length);
+                        slot.Length = length;
+                        std::atomic_thread_fence(std::memory_order_release);
+                        result = index;
+                    }
+                    attempt++;
+                }
+            }
+
+            return (result);
+        }
+        // Access a slot written by the other side. Returns nullptr if the index is not one of theirs,
+        // or if the length they put in it does not fit the slot.
+        const uint8_t* Data(const uint16_t index, uint32_t& length) const
+        {
+            const uint8_t* result = nullptr;
+            const uint8_t direction = (_creator == true ? 1 : 0);
+
+            length = 0;
+
+            if ((index >= (direction * _slots)) && (index < ((direction + 1) * _slots))) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                const Slot& slot(Entry(index));
+                const uint32_t size = slot.Length;
+
+                if (size <= SlotSize) {
+                    length = size;
+                    result = &(reinterpret_cast<const uint8_t*>(&slot)[sizeof(Slot)]);
+                }
+            }
+
+            return (result);
+        }
+        inline void Release(const uint16_t index)
+        {
+            Entry(index).State.store(FREE, std::memory_order_release);
+        }
+
+    private:
+        static inline uint32_t Stride()
+        {
+            // Keep the slot headers on their own cache line.
+            return (((sizeof(Slot) + SlotSize) + 63) & ~63);
+        }
+        inline Slot& Entry(const uint16_t index) const
+        {
+            return (*reinterpret_cast<Slot*>(const_cast<uint8_t*>(&(_buffer.Buffer()[Offset() + (index * Stride())]))));
+        }
+        static inline uint32_t Offset()
+        {
+            return ((sizeof(Control) + 63) & ~63);
+        }
+
+    private:
+        Core::DataElementFile _buffer;
+        Control* _control;
+        uint16_t _slots;
+        const bool _creator;
+
+        static uint8_t _defaultSlots;
+    };
+}
+}
+
+#endif // __COM_SHAREDRING_H
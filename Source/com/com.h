@@ -9,6 +9,7 @@
 #include "IValueIterator.h"
 #include "Ids.h"
 #include "Messages.h"
+#include "SharedRing.h"
 
 #ifdef __WINDOWS__
 #pragma comment(lib, "com.lib")
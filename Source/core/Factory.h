@@ -19,6 +19,8 @@ namespace Core {
 
             virtual Core::ProxyType<BASEOBJECT> GetElement() = 0;
             virtual uint32_t CreatedElements() const = 0;
+            virtual uint32_t ReusedElements() const = 0;
+            virtual uint32_t OutstandingElements() const = 0;
             virtual uint32_t QueuedElements() const = 0;
             virtual uint32_t CurrentQueueSize() const = 0;
         };
@@ -47,6 +49,14 @@ namespace Core {
             {
                 return (_warehouse.CreatedElements());
             }
+            virtual uint32_t ReusedElements() const
+            {
+                return (_warehouse.ReusedElements());
+            }
+            virtual uint32_t OutstandingElements() const
+            {
+                return (_warehouse.OutstandingElements());
+            }
             virtual uint32_t QueuedElements() const
             {
                 return (_warehouse.QueuedElements());
@@ -115,6 +125,18 @@ namespace Core {
 
                 return (_index->second->CreatedElements());
             }
+            inline uint32_t ReusedElements() const
+            {
+                ASSERT(IsValid());
+
+                return (_index->second->ReusedElements());
+            }
+            inline uint32_t OutstandingElements() const
+            {
+                ASSERT(IsValid());
+
+                return (_index->second->OutstandingElements());
+            }
             inline uint32_t QueuedElements() const
             {
                 ASSERT(IsValid());
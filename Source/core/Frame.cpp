@@ -0,0 +1,140 @@
+#include "Frame.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Core {
+
+    namespace {
+
+        constexpr uint32_t ClassSize[FrameBuffer::Classes] = { 512, 4 * 1024, 64 * 1024 };
+        constexpr uint8_t ClassDepth[FrameBuffer::Classes] = { 32, 8, 2 };
+        constexpr uint8_t MaxDepth = 32;
+
+        std::atomic<uint32_t> _allocated[FrameBuffer::Classes];
+        std::atomic<uint32_t> _recycled[FrameBuffer::Classes];
+        std::atomic<uint32_t> _unclassified;
+
+        class ThreadCache {
+        private:
+            ThreadCache(const ThreadCache&) = delete;
+            ThreadCache& operator=(const ThreadCache&) = delete;
+
+        public:
+            ThreadCache()
+            {
+                ::memset(_count, 0, sizeof(_count));
+            }
+            ~ThreadCache();
+
+        public:
+            uint8_t* Pop(const uint8_t index)
+            {
+                return (_count[index] > 0 ? _entries[index][--_count[index]] : nullptr);
+            }
+            bool Push(const uint8_t index, uint8_t* buffer)
+            {
+                bool result = (_count[index] < ClassDepth[index]);
+
+                if (result == true) {
+                    _entries[index][_count[index]++] = buffer;
+                }
+
+                return (result);
+            }
+
+        private:
+            uint8_t* _entries[FrameBuffer::Classes][MaxDepth];
+            uint8_t _count[FrameBuffer::Classes];
+        };
+
+        // Frames are released after the thread local cache of a thread is gone, e.g. by static
+        // destructors. From then on, buffers go straight back to the heap.
+        thread_local bool _closed = false;
+        thread_local ThreadCache _cache;
+
+        ThreadCache::~ThreadCache()
+        {
+            _closed = true;
+
+            for (uint8_t index = 0; index < FrameBuffer::Classes; index++) {
+                while (_count[index] > 0) {
+                    ::free(_entries[index][--_count[index]]);
+                }
+            }
+        }
+
+        inline uint8_t Class(const uint32_t size)
+        {
+            uint8_t index = 0;
+
+            while ((index < FrameBuffer::Classes) && (ClassSize[index] != size)) {
+                index++;
+            }
+
+            return (index);
+        }
+    }
+
+    /* static */ uint32_t FrameBuffer::Capacity(const uint32_t requiredSize, const uint32_t blockSize)
+    {
+        uint32_t result;
+        uint8_t index = 0;
+
+        while ((index < Classes) && (ClassSize[index] < requiredSize)) {
+            index++;
+        }
+
+        if (index < Classes) {
+            result = ClassSize[index];
+        } else {
+            const uint32_t block = (blockSize != 0 ? blockSize : ClassSize[0]);
+
+            result = ((requiredSize + block - 1) / block) * block;
+        }
+
+        return (result);
+    }
+
+    /* static */ uint8_t* FrameBuffer::Allocate(const uint32_t size)
+    {
+        uint8_t* result = nullptr;
+        const uint8_t index = Class(size);
+
+        if (index < Classes) {
+            _allocated[index].fetch_add(1, std::memory_order_relaxed);
+
+            if ((_closed == false) && ((result = _cache.Pop(index)) != nullptr)) {
+                _recycled[index].fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            _unclassified.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (result == nullptr) {
+            result = reinterpret_cast<uint8_t*>(::malloc(size));
+        }
+
+        return (result);
+    }
+
+    /* static */ void FrameBuffer::Free(uint8_t* buffer, const uint32_t size)
+    {
+        const uint8_t index = Class(size);
+
+        if ((index >= Classes) || (_closed == true) || (_cache.Push(index, buffer) == false)) {
+            ::free(buffer);
+        }
+    }
+
+    /* static */ void FrameBuffer::Snapshot(Statistics& info)
+    {
+        for (uint8_t index = 0; index < Classes; index++) {
+            info.Size[index] = ClassSize[index];
+            info.Allocated[index] = _allocated[index].load(std::memory_order_relaxed);
+            info.Recycled[index] = _recycled[index].load(std::memory_order_relaxed);
+        }
+        info.Unclassified = _unclassified.load(std::memory_order_relaxed);
+    }
+}
+}
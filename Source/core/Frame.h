@@ -2,10 +2,40 @@
 #define __GENERICS_FRAME_H
 
 #include "Module.h"
+#include "Portability.h"
+#include "Serialization.h"
 
 namespace WPEFramework {
 namespace Core {
 
+    // Frame buffers grow in a few fixed size classes. Buffers of such a class are recycled through
+    // a small per-thread free list, so a frame that needs more than its initial block does not have
+    // to go through a chain of reallocations, nor through the heap, every time it is (re)used.
+    class EXTERNAL FrameBuffer {
+    private:
+        FrameBuffer() = delete;
+        FrameBuffer(const FrameBuffer&) = delete;
+        FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    public:
+        static constexpr uint8_t Classes = 3;
+
+        struct Statistics {
+            uint32_t Size[Classes];
+            uint32_t Allocated[Classes];
+            uint32_t Recycled[Classes];
+            uint32_t Unclassified;
+        };
+
+    public:
+        // The capacity to allocate to hold requiredSize bytes. This is the smallest size class it
+        // fits in, or a multiple of the blockSize if it is larger than the largest class.
+        static uint32_t Capacity(const uint32_t requiredSize, const uint32_t blockSize);
+        static uint8_t* Allocate(const uint32_t size);
+        static void Free(uint8_t* buffer, const uint32_t size);
+        static void Snapshot(Statistics& info);
+    };
+
     template <const uint16_t BLOCKSIZE>
     class FrameType {
     private:
@@ -17,13 +47,13 @@ namespace Core {
         public:
             AllocatorType()
                 : _bufferSize(STARTSIZE)
-                , _data(reinterpret_cast<uint8_t*>(::malloc(_bufferSize)))
+                , _data(FrameBuffer::Allocate(_bufferSize))
             {
                 static_assert(STARTSIZE != 0, "This method can only be called if you specify an initial blocksize");
             }
             AllocatorType(const AllocatorType<STARTSIZE>& copy)
                 : _bufferSize(copy._bufferSize)
-                , _data(STARTSIZE == 0 ? copy._data : reinterpret_cast<uint8_t*>(::malloc(_bufferSize)))
+                , _data(STARTSIZE == 0 ? copy._data : FrameBuffer::Allocate(_bufferSize))
             {
 
                 if (STARTSIZE != 0) {
@@ -39,7 +69,7 @@ namespace Core {
             ~AllocatorType()
             {
                 if ((STARTSIZE != 0) && (_data != nullptr)) {
-                    ::free(_data);
+                    FrameBuffer::Free(_data, _bufferSize);
                 }
             }
 
@@ -67,10 +97,15 @@ namespace Core {
             {
                 if (requiredSize > _bufferSize) {
 
-                    _bufferSize = static_cast<uint16_t>(((requiredSize / (STARTSIZE ? STARTSIZE : 1)) + 1) * STARTSIZE);
+                    // oops we need to "reallocate", jump straight to the size class that fits.
+                    uint32_t bufferSize = FrameBuffer::Capacity(requiredSize, STARTSIZE);
+                    uint8_t* data = FrameBuffer::Allocate(bufferSize);
 
-                    // oops we need to "reallocate".
-                    _data = reinterpret_cast<uint8_t*>(::realloc(_data, _bufferSize));
+                    ::memcpy(data, _data, _bufferSize);
+                    FrameBuffer::Free(_data, _bufferSize);
+
+                    _bufferSize = bufferSize;
+                    _data = data;
                 }
             }
             inline void RealAllocate(const uint32_t requiredSize, const TemplateIntToType<0>& /* For compile time diffrentiation */)
@@ -79,7 +114,7 @@ namespace Core {
             }
 
         private:
-            uint16_t _bufferSize;
+            uint32_t _bufferSize;
             uint8_t* _data;
         };
 
@@ -239,6 +274,13 @@ namespace Core {
             {
                 return (_offset);
             }
+            // Make room for the next length bytes in one go, if the size of what is about to be written is known.
+            void Reserve(const uint32_t length)
+            {
+                ASSERT(_container != nullptr);
+
+                _container->Reserve(_offset + length);
+            }
             template <typename TYPENAME>
             void Buffer(const TYPENAME length, const uint8_t buffer[])
             {
@@ -328,6 +370,10 @@ namespace Core {
 
             _size = size;
         }
+        inline void Reserve(const uint32_t size)
+        {
+            _data.Allocate(size);
+        }
         template <typename TYPENAME>
         uint16_t SetBuffer(const uint16_t offset, const TYPENAME& length, const uint8_t buffer[])
         {
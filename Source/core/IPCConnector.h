@@ -18,7 +18,13 @@ namespace Core {
     struct IMessage {
     public:
         typedef IMessage BaseElement;
-        typedef uint32_t Identifier;
+
+        // A frame carries the label of the message and the sequence number of the call it belongs
+        // to, so responses can be matched with their request, even if they arrive out of order.
+        struct Identifier {
+            uint32_t Label;
+            uint32_t Sequence;
+        };
 
         class Serializer {
         private:
@@ -62,7 +68,7 @@ namespace Core {
 
                 while ((_current != nullptr) && (result < maxLength)) {
                     if (_offset < 4) {
-                        uint32_t length = _length + CommandSize();
+                        uint32_t length = _length + HeaderSize();
 
                         // Write the length. Continue as long as the top bt is active..
                         while ((_offset < 4) && (result < maxLength)) {
@@ -91,16 +97,29 @@ namespace Core {
                         }
                     }
 
+                    // Write the sequence, Same structure as length..
+                    while ((_offset < 12) && (result < maxLength)) {
+                        uint32_t value = _current->Sequence() >> (7 * (_offset - 8));
+                        stream[result] = ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0x00));
+                        result++;
+
+                        if (value >= 0x80) {
+                            _offset++;
+                        } else {
+                            _offset = 12;
+                        }
+                    }
+
                     if (result < maxLength) {
                         // Write the command, Same structure as length..
-                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - 8);
+                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - 12);
 
                         result += handled;
                         _offset += handled;
 
-                        ASSERT_VERBOSE((_offset - 8) <= _length, "%d <= %d", (_offset - 8), _length);
+                        ASSERT_VERBOSE((_offset - 12) <= _length, "%d <= %d", (_offset - 12), _length);
 
-                        if ((_offset - 8) == _length) {
+                        if ((_offset - 12) == _length) {
                             const IMessage* ready = _current;
                             _current = nullptr;
 
@@ -115,9 +134,13 @@ namespace Core {
             virtual void Serialized(const IMessage& element) = 0;
 
         private:
-            inline uint32_t CommandSize() const
+            static inline uint8_t EncodedSize(const uint32_t value)
             {
-                return (_current->Label() > 0x1FFFFF ? 4 : (_current->Label() > 0xCFFF ? 3 : (_current->Label() > 0x7F ? 2 : 1)));
+                return (value >= 0x200000 ? 4 : (value >= 0x4000 ? 3 : (value >= 0x80 ? 2 : 1)));
+            }
+            inline uint32_t HeaderSize() const
+            {
+                return (EncodedSize(_current->Label()) + EncodedSize(_current->Sequence()));
             }
 
         private:
@@ -136,6 +159,7 @@ namespace Core {
                 : _length(0)
                 , _offset(0)
                 , _label(0)
+                , _sequence(0)
                 , _current(nullptr)
             {
             }
@@ -145,14 +169,14 @@ namespace Core {
 
         public:
             virtual void Deserialized(IMessage& element) = 0;
-            virtual IMessage* Element(const uint32_t& label) = 0;
+            virtual IMessage* Element(const Identifier& id) = 0;
 
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength)
             {
                 uint16_t result = 0;
 
                 while (result < maxLength) {
-					if ((_current == nullptr) && (_offset < 8)) {
+					if ((_current == nullptr) && (_offset < 12)) {
                         // We have nothing, start by getting the length/command
                         while ((_offset < 4) && (result < maxLength)) {
                             _length |= ((stream[result] & (_offset == 3 ? 0xFF : 0x7F)) << (7 * _offset));
@@ -175,30 +199,46 @@ namespace Core {
                             }
                         }
 
-                        if (_offset == 8) {
-                            _current = Element(_label);
+                        while ((_offset < 12) && (result < maxLength)) {
+                            _sequence |= ((stream[result] & (_offset == 11 ? 0xFF : 0x7F)) << (7 * (_offset - 8)));
+                            _length--;
+
+                            if ((stream[result++] & 0x80) != 0) {
+                                _offset++;
+                            } else {
+                                _offset = 12;
+                            }
+                        }
+
+                        if (_offset == 12) {
+                            Identifier id;
+                            id.Label = _label;
+                            id.Sequence = _sequence;
+
+                            _current = Element(id);
                             _label = 0;
+                            _sequence = 0;
                         }
                     }
 
-                    ASSERT((_offset - 8) <= _length);
+                    ASSERT((_offset - 12) <= _length);
 
-                    if ((_offset - 8) < _length) {
+                    if ((_offset - 12) < _length) {
 
                         // There could be multiple packages in this frame, do not read/handle more than what fits in the frame.
-                        uint16_t handled((maxLength - result) > static_cast<uint16_t>(_length - (_offset - 8)) ? static_cast<uint16_t>(_length - (_offset - 8)) : (maxLength - result));
+                        uint16_t handled((maxLength - result) > static_cast<uint16_t>(_length - (_offset - 12)) ? static_cast<uint16_t>(_length - (_offset - 12)) : (maxLength - result));
 
                         if (_current != nullptr) {
-                            handled = _current->Deserialize(&stream[result], handled, _offset - 8);
+                            handled = _current->Deserialize(&stream[result], handled, _offset - 12);
                         }
 
                         _offset += handled;
                         result += handled;
                     }
 
-                    ASSERT((_offset - 8) <= _length);
+                    ASSERT((_offset - 12) <= _length);
 
-                    if ((_offset - 8) == _length) {
+                    if ((_offset - 12) == _length) {
                         if (_current != nullptr) {
                             IMessage* ready = _current;
                             _current = nullptr;
@@ -215,6 +255,7 @@ namespace Core {
             uint32_t _length;
             uint32_t _offset;
             uint32_t _label;
+            uint32_t _sequence;
             IMessage* _current;
         };
 
@@ -222,6 +263,7 @@ namespace Core {
         virtual ~IMessage() {}
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
         virtual uint32_t Length() const = 0;
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) = 0;
@@ -232,6 +274,8 @@ namespace Core {
         virtual ~IIPC();
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
+        virtual void Sequence(const uint32_t sequence) = 0;
         virtual ProxyType<IMessage> IParameters() = 0;
         virtual ProxyType<IMessage> IResponse() = 0;
     };
@@ -285,6 +329,10 @@ namespace Core {
             {
                 return (REALIDENTIFIER);
             }
+            virtual uint32_t Sequence() const
+            {
+                return (_parent.Sequence());
+            }
             virtual uint32_t Length() const
             {
                 return (_Length<PACKAGE, REALIDENTIFIER>());
@@ -416,11 +464,13 @@ namespace Core {
         IPCMessageType()
             : _parameters(*this)
             , _response(*this)
+            , _sequence(0)
         {
         }
         IPCMessageType(const PARAMETERS& info)
             : _parameters(*this, info)
             , _response(*this)
+            , _sequence(0)
         {
         }
 #ifdef __WINDOWS__
@@ -453,6 +503,14 @@ namespace Core {
         {
             return (IDENTIFIER);
         }
+        virtual uint32_t Sequence() const
+        {
+            return (_sequence);
+        }
+        virtual void Sequence(const uint32_t sequence)
+        {
+            _sequence = sequence;
+        }
         virtual ProxyType<IMessage> IParameters()
         {
             return ProxyType<IMessage>(&_parameters, &_parameters);
@@ -470,6 +528,7 @@ namespace Core {
     private:
         RawSerializedType<PARAMETERS, (IDENTIFIER << 1)> _parameters;
         RawSerializedType<RESPONSE, ((IDENTIFIER << 1) | 0x1)> _response;
+        uint32_t _sequence;
     };
 
     class EXTERNAL IPCChannel {
@@ -485,13 +544,25 @@ namespace Core {
             IPCFactory(const IPCFactory& copy) = delete;
             IPCFactory& operator=(const IPCFactory&) = delete;
 
+            // Bookkeeping of a call that is send out and waits for its response.
+            struct Outbound {
+                Core::ProxyType<IIPC> Message;
+                IDispatchType<IIPC>* Callback;
+                bool Synchronous;
+                bool Aborted;
+            };
+
+            typedef std::map<uint32_t, Outbound> OutboundMap;
+
             IPCFactory()
                 : _lock()
                 , _inbound()
                 , _outbound()
-                , _callback(nullptr)
+                , _sequence(0)
                 , _factory()
                 , _handlers()
+                , _discarded()
+                , _reclaimer()
             {
             }
             inline void Factory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
@@ -506,9 +577,11 @@ namespace Core {
                 : _lock()
                 , _inbound()
                 , _outbound()
-                , _callback(nullptr)
+                , _sequence(0)
                 , _factory(factory)
                 , _handlers()
+                , _discarded()
+                , _reclaimer()
             {
                 // Only creat the IPCFactory with a valid base factory
                 ASSERT(factory.IsValid());
@@ -527,6 +600,10 @@ namespace Core {
                 }
 
                 _handlers.clear();
+
+                if (_reclaimer.IsValid() == true) {
+                    _reclaimer.Release();
+                }
             }
 
         public:
@@ -557,23 +634,50 @@ namespace Core {
                 _lock.Unlock();
             }
 
+            inline void Reclaimer(const ProxyType<IIPCServer>& handler)
+            {
+                _lock.Lock();
+
+                _reclaimer = handler;
+
+                _lock.Unlock();
+            }
+
             inline bool InProgress() const
             {
-                return (_outbound.IsValid());
+                _lock.Lock();
+
+                bool result = (_outbound.empty() == false);
+
+                _lock.Unlock();
+
+                return (result);
             }
 
-            inline ProxyType<IMessage> Element(const uint32_t& identifier)
+            inline ProxyType<IMessage> Element(const IMessage::Identifier& identifier)
             {
                 ProxyType<IMessage> result;
-                uint32_t searchIdentifier(identifier >> 1);
+                uint32_t searchIdentifier(identifier.Label >> 1);
 
                 _lock.Lock();
 
-                if (identifier & 0x01) {
-                    if ((_outbound.IsValid() == true) && (_outbound->Label() == searchIdentifier)) {
-                        result = _outbound->IResponse();
+                if (identifier.Label & 0x01) {
+                    OutboundMap::iterator index(_outbound.find(identifier.Sequence));
+
+                    if ((index != _outbound.end()) && (index->second.Aborted == false) && (index->second.Message->Label() == searchIdentifier)) {
+                        result = index->second.Message->IResponse();
                     } else {
-                        TRACE_L1("Unexpected response message for ID [%d].\n", searchIdentifier);
+                        TRACE_L1("Unexpected response message for ID [%d], sequence [%d].\n", searchIdentifier, identifier.Sequence);
+
+                        if ((_reclaimer.IsValid() == true) && (_discarded.IsValid() == false)) {
+                            // Nobody waits for this response anymore, still receive it, so whatever
+                            // it refers to can be reclaimed.
+                            _discarded = _factory->Element(searchIdentifier);
+
+                            if (_discarded.IsValid() == true) {
+                                result = _discarded->IResponse();
+                            }
+                        }
                     }
                 } else {
                     ASSERT(_inbound.IsValid() == false);
@@ -581,6 +685,8 @@ namespace Core {
                     ProxyType<IIPC> rpcCall(_factory->Element(searchIdentifier));
 
                     if (rpcCall.IsValid() == true) {
+                        // The response will be send with the sequence of the request.
+                        rpcCall->Sequence(identifier.Sequence);
                         _inbound = rpcCall;
                         result = rpcCall->IParameters();
                     } else {
@@ -599,14 +705,22 @@ namespace Core {
 
                 TRACE_L1("Flushing the IPC mechanims. %d", __LINE__);
 
-                _callback = nullptr;
+                // The synchronous calls that have been aborted, are cleaned up by their waiting callers.
+                OutboundMap::iterator index(_outbound.begin());
 
-                if (_outbound.IsValid() == true) {
-                    _outbound.Release();
+                while (index != _outbound.end()) {
+                    if (index->second.Synchronous == false) {
+                        index = _outbound.erase(index);
+                    } else {
+                        index++;
+                    }
                 }
                 if (_inbound.IsValid() == true) {
                     _inbound.Release();
                 }
+                if (_discarded.IsValid() == true) {
+                    _discarded.Release();
+                }
 
                 _lock.Unlock();
             }
@@ -617,25 +731,31 @@ namespace Core {
 
                 _lock.Lock();
 
-                if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
+                OutboundMap::iterator index((rhs->Label() & 0x01) != 0 ? _outbound.find(rhs->Sequence()) : _outbound.end());
+
+                if ((index != _outbound.end()) && (index->second.Message->IResponse() == rhs)) {
 
-                    ASSERT(_callback != nullptr);
+                    ASSERT(index->second.Callback != nullptr);
 
-                    ProxyType<IIPC> handledObject(_outbound);
+                    ProxyType<IIPC> handledObject(index->second.Message);
+                    IDispatchType<IIPC>* callback(index->second.Callback);
 
-                    _outbound.Release();
-                    _callback->Dispatch(*handledObject);
-                    _callback = nullptr;
+                    _outbound.erase(index);
+                    callback->Dispatch(*handledObject);
+                } else if ((_discarded.IsValid() == true) && (_discarded->IResponse() == rhs)) {
+                    procedure = _reclaimer;
+                    inbound = _discarded;
+                    _discarded.Release();
                 }
-                // If this is *NOT* the outbound call, it is inbound and thus it must have been registered
+                // If this is *NOT* an outbound call, it is inbound and thus it must have been registered
                 else if (_inbound.IsValid() == true) {
 
-                    std::map<uint32_t, ProxyType<IIPCServer>>::iterator index(_handlers.find(_inbound->Label()));
+                    std::map<uint32_t, ProxyType<IIPCServer>>::iterator handler(_handlers.find(_inbound->Label()));
 
-					ASSERT(index != _handlers.end());
+					ASSERT(handler != _handlers.end());
 
-                    if (index != _handlers.end()) {
-                        procedure = (*index).second;
+                    if (handler != _handlers.end()) {
+                        procedure = (*handler).second;
                         inbound = _inbound;
                     } else {
                         TRACE_L1("No handler defined to handle the incoming frames. [%d]", _inbound->Label());
@@ -651,37 +771,74 @@ namespace Core {
                 return (procedure);
             }
 
-            inline void SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback)
+            inline uint32_t SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback, const bool synchronous)
             {
                 _lock.Lock();
 
                 ASSERT((outbound.IsValid() == true) && (callback != nullptr));
-                ASSERT((_outbound.IsValid() == false) && (_callback == nullptr));
 
-                _outbound = outbound;
-                _callback = callback;
+                // Sequence numbers are send as (at most) 4 bytes of 7 bits, 0 is never used.
+                do {
+                    _sequence = (_sequence + 1) & 0x0FFFFFFF;
+                } while ((_sequence == 0) || (_outbound.find(_sequence) != _outbound.end()));
+
+                Outbound& entry(_outbound[_sequence]);
+                entry.Message = outbound;
+                entry.Callback = callback;
+                entry.Synchronous = synchronous;
+                entry.Aborted = false;
+
+                outbound->Sequence(_sequence);
+
+                uint32_t result = _sequence;
 
                 _lock.Unlock();
+
+                return (result);
             }
 
-            inline bool AbortOutbound()
+            // Forget about a single call, returns true if no response was received for it.
+            inline bool AbortOutbound(const uint32_t sequence)
             {
                 bool result = false;
 
                 _lock.Lock();
 
-                if (_outbound.IsValid() == true) {
+                OutboundMap::iterator index(_outbound.find(sequence));
 
+                if (index != _outbound.end()) {
                     result = true;
+                    _outbound.erase(index);
+                }
 
-                    if (_callback != nullptr) {
-                        _callback->Dispatch(*_outbound);
-                        _callback = nullptr;
-                    }
+                _lock.Unlock();
 
-                    _outbound.Release();
-                } else {
-                    ASSERT(_callback == nullptr);
+                return (result);
+            }
+
+            inline bool AbortOutbound()
+            {
+                bool result = false;
+
+                _lock.Lock();
+
+                OutboundMap::iterator index(_outbound.begin());
+
+                while (index != _outbound.end()) {
+                    if (index->second.Aborted == true) {
+                        index++;
+                    } else {
+                        result = true;
+
+                        index->second.Callback->Dispatch(*(index->second.Message));
+
+                        if (index->second.Synchronous == true) {
+                            index->second.Aborted = true;
+                            index++;
+                        } else {
+                            index = _outbound.erase(index);
+                        }
+                    }
                 }
 
                 _lock.Unlock();
@@ -692,10 +849,12 @@ namespace Core {
         private:
             mutable CriticalSection _lock;
             Core::ProxyType<IIPC> _inbound;
-            mutable Core::ProxyType<IIPC> _outbound;
-            IDispatchType<IIPC>* _callback;
+            OutboundMap _outbound;
+            uint32_t _sequence;
             Core::ProxyType<FactoryType<IIPC, uint32_t>> _factory;
             std::map<uint32_t, ProxyType<IIPCServer>> _handlers;
+            Core::ProxyType<IIPC> _discarded;
+            ProxyType<IIPCServer> _reclaimer;
         };
 
     protected:
@@ -726,6 +885,12 @@ namespace Core {
             _administration.Unregister(id);
         }
 
+        // Responses that arrive after their call timed out or was aborted are handed to this handler.
+        inline void Reclaimer(const ProxyType<IIPCServer>& handler)
+        {
+            _administration.Reclaimer(handler);
+        }
+
         inline void Abort()
         {
             _administration.AbortOutbound();
@@ -875,6 +1040,7 @@ namespace Core {
             IPCTrigger(IPCFactory& administration)
                 : _administration(administration)
                 , _signal(false, true)
+                , _sequence(0)
             {
             }
             virtual ~IPCTrigger()
@@ -882,16 +1048,21 @@ namespace Core {
             }
 
         public:
+            inline void Sequence(const uint32_t sequence)
+            {
+                _sequence = sequence;
+            }
             uint32_t Wait(const uint32_t waitTime)
             {
                 uint32_t result = Core::ERROR_NONE;
 
                 // Now we wait for ever, to get a signal that we are done :-)
                 if (_signal.Lock(waitTime) != Core::ERROR_NONE) {
-                    _administration.AbortOutbound();
+                    _administration.AbortOutbound(_sequence);
 
                     result = Core::ERROR_TIMEDOUT;
-                } else if (_administration.AbortOutbound() == true) {
+                } else if (_administration.AbortOutbound(_sequence) == true) {
+                    // Still registered, so we were woken up without a response..
                     result = Core::ERROR_ASYNC_FAILED;
                 }
 
@@ -905,6 +1076,7 @@ namespace Core {
         private:
             IPCFactory& _administration;
             Event _signal;
+            uint32_t _sequence;
         };
 
     public:
@@ -1041,18 +1213,16 @@ namespace Core {
         {
         }
 
+        // Calls are not serialized, each call gets its own sequence number, so multiple calls
+        // can be outstanding on the channel and the responses can come back in any order.
         virtual uint32_t Execute(ProxyType<IIPC>& command, IDispatchType<IIPC>* completed)
         {
             uint32_t success = Core::ERROR_UNAVAILABLE;
 
-            _serialize.Lock();
-
-            if (_administration.InProgress() == true) {
-                success = Core::ERROR_INPROGRESS;
-            } else if (_link.IsOpen() == true) {
+            if (_link.IsOpen() == true) {
                 // We need to accept a CONST object to avoid an additional object creation
                 // proxy casted objects.
-                _administration.SetOutbound(command, completed);
+                _administration.SetOutbound(command, completed, false);
 
                 // Send out the
                 _link.Submit(command->IParameters());
@@ -1060,22 +1230,18 @@ namespace Core {
                 success = Core::ERROR_NONE;
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
         virtual uint32_t Execute(ProxyType<IIPC>& command, const uint32_t waitTime)
         {
             uint32_t success = Core::ERROR_CONNECTION_CLOSED;
 
-            _serialize.Lock();
-
             if (_link.IsOpen() == true) {
                 IPCTrigger sink(_administration);
 
                 // We need to accept a CONST object to avoid an additional object creation
                 // proxy casted objects.
-                _administration.SetOutbound(command, &sink);
+                sink.Sequence(_administration.SetOutbound(command, &sink, true));
 
                 // Send out the
                 _link.Submit(command->IParameters());
@@ -1083,8 +1249,6 @@ namespace Core {
                 success = sink.Wait(waitTime);
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
         inline void CallProcedure(ProxyType<IIPCServer>& procedure, ProxyType<IIPC>& message)
@@ -1093,7 +1257,6 @@ namespace Core {
         }
 
     private:
-        CriticalSection _serialize;
         IPCLink _link;
         EXTENSION _extension;
     };
@@ -2,6 +2,7 @@
 #define __JSON_H
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "Enumerate.h"
@@ -108,11 +109,22 @@ namespace Core {
                 realObject.Clear();
 
                 if (text.empty() == false) {
-                    // Deserialize object
-                    uint16_t loaded = static_cast<IElement&>(realObject).Deserialize(text.c_str(), static_cast<uint16_t>(text.length() + 1), offset, error);
+                    // The text is already contiguous, so parse it straight from the string. Only if it
+                    // does not fit the 16 bits length of a chunk, it takes more than one call.
+                    const char* stream = text.c_str();
+                    size_t remaining = text.length() + 1;
+                    uint16_t loaded;
 
-                    ASSERT(loaded <= (text.length() + 1));
-                    DEBUG_VARIABLE(loaded);
+                    do {
+                        const uint16_t chunk = static_cast<uint16_t>(std::min(remaining, static_cast<size_t>(0xFFFF)));
+
+                        loaded = static_cast<IElement&>(realObject).Deserialize(stream, chunk, offset, error);
+
+                        ASSERT(loaded <= chunk);
+
+                        stream += loaded;
+                        remaining -= loaded;
+                    } while ((offset != 0) && (remaining > 0) && (loaded > 0) && (error.IsSet() == false));
                 }
 
                 if (offset != 0 && error.IsSet() == false) {
@@ -1401,6 +1413,32 @@ namespace Core {
                         result++;
                         _scopeCount |= (QuoteFoundBit | 1);
                         _unaccountedCount = 1;
+
+                        // Typically the whole string is in this chunk. If so, take it in one go and
+                        // resolve the escape sequences, if any, in place afterwards.
+                        uint16_t end = result;
+                        bool escaped = false;
+
+                        while ((end < maxLength) && (stream[end] != '\"')) {
+                            if (stream[end] == '\\') {
+                                if (((end + 1) >= maxLength) || (IsEscapable(stream[end + 1]) == false)) {
+                                    // Leave it to the character by character parser.
+                                    break;
+                                }
+                                escaped = true;
+                                end++;
+                            }
+                            end++;
+                        }
+
+                        if ((end < maxLength) && (stream[end] == '\"')) {
+                            _value.assign(&(stream[result]), end - result);
+                            if (escaped == true) {
+                                Unescape();
+                            }
+                            result = end + 1;
+                            finished = true;
+                        }
                     }
                 }
 
@@ -1596,12 +1634,39 @@ namespace Core {
             bool IsValidEscapeSequence(char current) const
             {
                 ASSERT(MatchLastCharacter(_value, '\\') == true);
+                return (IsEscapable(current));
+            }
+            static bool IsEscapable(const char current)
+            {
                 // Any character may be escaped using \uXXXX. The serlializer should escape
                 // control chars with values less that 0x1F using this convention. Also serializer
                 // should change '"' '\' '\n' '\t' '\f' '\r' '\f' to
                 // '\''"' '\''\' '\''n' '\''t' '\''f' '\''r' '\''f' and deserisalizer has to change tham back
                 return current == '"' || current == 'b' || current == 'n' || current == 't' || current == 'u' || current == '/' || current == '\\' || current == 'f' || current == 'r';
             }
+            // Resolve the escape sequences of a value that was taken in one go, the same way the
+            // character by character parser does.
+            void Unescape()
+            {
+                size_t to = 0;
+
+                for (size_t from = 0; from < _value.length(); from++, to++) {
+                    char current = _value[from];
+
+                    if ((current == '\\') && ((from + 1) < _value.length())) {
+                        const char next = _value[from + 1];
+                        const EscapeSequenceAction action = GetEscapeSequenceAction(next);
+
+                        if (action != EscapeSequenceAction::NOTHING) {
+                            current = (action == EscapeSequenceAction::REPLACE ? EscapeSequenceReplacemnent(next) : next);
+                            from++;
+                        }
+                    }
+                    _value[to] = current;
+                }
+
+                _value.resize(to);
+            }
 
             enum class EscapeSequenceAction {
                 NOTHING,
@@ -2718,6 +2783,30 @@ namespace Core {
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
             typedef std::list<JSONLabelValue> JSONElementList;
 
+            // Containers with more than a handful of members look up labels through a hash index, which
+            // is built the first time a label is looked up and dropped when a member is added or removed.
+            static constexpr uint8_t IndexThreshold = 8;
+
+            struct LabelHash {
+                size_t operator()(const TCHAR* label) const
+                {
+                    size_t result = 2166136261u;
+
+                    while (*label != '\0') {
+                        result = (result ^ static_cast<size_t>(*label++)) * 16777619u;
+                    }
+
+                    return (result);
+                }
+            };
+            struct LabelEqual {
+                bool operator()(const TCHAR* lhs, const TCHAR* rhs) const
+                {
+                    return (strcmp(lhs, rhs) == 0);
+                }
+            };
+            typedef std::unordered_map<const TCHAR*, IElement*, LabelHash, LabelEqual> JSONElementIndex;
+
             class Iterator {
             private:
                 enum State {
@@ -2792,6 +2881,7 @@ namespace Core {
             Container()
                 : _state(0)
                 , _data()
+                , _index()
                 , _iterator()
                 , _fieldName(true)
             {
@@ -2846,6 +2936,7 @@ namespace Core {
             void Add(const TCHAR label[], IElement* element)
             {
                 _data.push_back(JSONLabelValue(label, element));
+                _index.clear();
             }
 
             void Remove(const TCHAR label[])
@@ -2858,10 +2949,11 @@ namespace Core {
 
                 if (index != _data.end()) {
                     _data.erase(index);
+                    _index.clear();
                 }
             }
 
-        private:
+        protected:
             // IElement iface:
             uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
             {
@@ -3060,6 +3152,7 @@ namespace Core {
                 return (loaded);
             }
 
+        private:
             // IMessagePack iface:
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
             {
@@ -3191,12 +3284,28 @@ namespace Core {
 
                 JSONElementList::iterator index = _data.begin();
 
-                while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
-                    index++;
-                }
+                if (_data.size() >= IndexThreshold) {
+                    if (_index.empty() == true) {
+                        while (index != _data.end()) {
+                            // Like the list lookup, the first one registered with a label wins.
+                            _index.emplace(index->first, index->second);
+                            index++;
+                        }
+                    }
 
-                if (index != _data.end()) {
-                    result = index->second;
+                    JSONElementIndex::const_iterator entry(_index.find(label));
+
+                    if (entry != _index.end()) {
+                        result = entry->second;
+                    }
+                } else {
+                    while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
+                        index++;
+                    }
+
+                    if (index != _data.end()) {
+                        result = index->second;
+                    }
                 }
                 if (Request(label) == true) {
                     index = _data.end();
@@ -3248,6 +3357,7 @@ namespace Core {
                 mutable IMessagePack* pack;
             } _current;
             JSONElementList _data;
+            JSONElementIndex _index;
             mutable JSONElementList::const_iterator _iterator;
             mutable String _fieldName;
         };
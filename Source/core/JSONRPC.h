@@ -6,6 +6,7 @@
 
 #include <cctype>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace WPEFramework {
@@ -235,6 +236,80 @@ namespace Core {
             Info Error;
         };
 
+        // A message that, as described by the JSON-RPC 2.0 specification, might also be a batch: an
+        // array of calls (or the responses to them). A single message reads and writes as a Message,
+        // an array is kept as the (unparsed) JSON text of its entries.
+        class Batch : public Message {
+        public:
+            Batch(const Batch&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            Batch()
+                : Message()
+                , Calls()
+                , _batch(false)
+            {
+            }
+            ~Batch()
+            {
+            }
+
+        public:
+            inline bool IsBatch() const
+            {
+                return (_batch);
+            }
+            void Add(const Message& response)
+            {
+                string text;
+                response.ToString(text);
+
+                Calls.Add(Core::JSON::String(false)) = text;
+                _batch = true;
+            }
+            void Clear()
+            {
+                Message::Clear();
+                Calls.Clear();
+                _batch = false;
+            }
+
+            // IElement iface:
+            bool IsSet() const override
+            {
+                return (_batch == true ? Calls.IsSet() : Message::IsSet());
+            }
+
+        protected:
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            {
+                return (_batch == true ? static_cast<const Core::JSON::IElement&>(Calls).Serialize(stream, maxLength, offset) : Message::Serialize(stream, maxLength, offset));
+            }
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                uint16_t loaded = 0;
+
+                if (offset == 0) {
+                    // Only the first character that is not a space tells what we are reading.
+                    while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
+                        loaded++;
+                    }
+                    if (loaded == maxLength) {
+                        return (loaded);
+                    }
+                    _batch = (stream[loaded] == '[');
+                }
+
+                return (_batch == true ? static_cast<Core::JSON::IElement&>(Calls).Deserialize(stream, maxLength, offset, error) : Message::Deserialize(stream, maxLength, offset, error));
+            }
+
+        public:
+            Core::JSON::ArrayType<Core::JSON::String> Calls;
+
+        private:
+            bool _batch;
+        };
+
         class EXTERNAL Connection {
         private:
             Connection() = delete;
@@ -392,13 +467,20 @@ namespace Core {
                 string _designator;
             };
 
-            typedef std::map<const string, Entry> HandlerMap;
+            typedef std::unordered_map<string, Entry> HandlerMap;
             typedef std::list<Observer> ObserverList;
             typedef std::map<string, ObserverList> ObserverMap;
 
             typedef std::function<void(const uint32_t id, const string& designator, const string& data)> NotificationFunction;
+            // Receives all subscribers that get exactly the same notification at once, so the message
+            // has to be created and serialized only once.
+            typedef std::function<void(const std::vector<uint32_t>& ids, const string& designator, const string& data)> BroadcastFunction;
 
         public:
+            // Identifies a registered method, so it can be invoked without looking it up again. An id
+            // remains valid for as long as the Generation() of the handler does not change.
+            typedef Entry* MethodId;
+
             class EventIterator {
             public:
                 EventIterator()
@@ -476,7 +558,9 @@ namespace Core {
                 , _handlers()
                 , _observers()
                 , _notificationFunction(notificationFunction)
+                , _broadcastFunction()
                 , _versions(versions)
+                , _generation(0)
             {
             }
             Handler(const NotificationFunction& notificationFunction, const std::vector<uint8_t>& versions, const Handler& copy)
@@ -484,7 +568,29 @@ namespace Core {
                 , _handlers(copy._handlers)
                 , _observers()
                 , _notificationFunction(notificationFunction)
+                , _broadcastFunction()
                 , _versions(versions)
+                , _generation(0)
+            {
+            }
+            Handler(const NotificationFunction& notificationFunction, const BroadcastFunction& broadcastFunction, const std::vector<uint8_t>& versions)
+                : _adminLock()
+                , _handlers()
+                , _observers()
+                , _notificationFunction(notificationFunction)
+                , _broadcastFunction(broadcastFunction)
+                , _versions(versions)
+                , _generation(0)
+            {
+            }
+            Handler(const NotificationFunction& notificationFunction, const BroadcastFunction& broadcastFunction, const std::vector<uint8_t>& versions, const Handler& copy)
+                : _adminLock()
+                , _handlers(copy._handlers)
+                , _observers()
+                , _notificationFunction(notificationFunction)
+                , _broadcastFunction(broadcastFunction)
+                , _versions(versions)
+                , _generation(0)
             {
             }
             ~Handler()
@@ -509,6 +615,7 @@ namespace Core {
                     _handlers.emplace(std::piecewise_construct,
                         std::forward_as_tuple(method),
                         std::forward_as_tuple(info));
+                    _generation++;
                 }
 
                 return (copied);
@@ -523,6 +630,17 @@ namespace Core {
             {
                 return (std::find(_versions.begin(), _versions.end(), number) != _versions.end());
             }
+            // Changes every time a method is registered or unregistered.
+            inline uint32_t Generation() const
+            {
+                return (_generation);
+            }
+            MethodId Resolve(const string& methodName)
+            {
+                HandlerMap::iterator index = _handlers.find(methodName);
+
+                return (index != _handlers.end() ? &(index->second) : nullptr);
+            }
             template <typename PARAMETER, typename GET_METHOD, typename SET_METHOD, typename REALOBJECT>
             typename std::enable_if<(std::is_same<std::nullptr_t, typename std::remove_cv<GET_METHOD>::type>::value && !std::is_same<std::nullptr_t, typename std::remove_cv<SET_METHOD>::type>::value), void>::type
             Property(const string& methodName, GET_METHOD getMethod, SET_METHOD setMethod, REALOBJECT* objectPtr)
@@ -600,6 +718,7 @@ namespace Core {
                 _handlers.emplace(std::piecewise_construct,
                     std::make_tuple(methodName),
                     std::make_tuple(lambda));
+                _generation++;
             }
             void Register(const string& methodName, const CallbackFunction& lambda)
             {
@@ -609,6 +728,7 @@ namespace Core {
                 _handlers.emplace(std::piecewise_construct,
                     std::make_tuple(methodName),
                     std::make_tuple(lambda));
+                _generation++;
             }
             void Unregister(const string& methodName)
             {
@@ -618,6 +738,7 @@ namespace Core {
 
                 if (index != _handlers.end()) {
                     _handlers.erase(index);
+                    _generation++;
                 }
             }
             uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
@@ -626,12 +747,21 @@ namespace Core {
 
                 response.clear();
 
-                HandlerMap::iterator index = _handlers.find(Message::Method(method));
+                // Most methods come without a version or an index, those can be looked up as is.
+                HandlerMap::iterator index = (method.find_first_of(_T(".@")) == string::npos ? _handlers.find(method) : _handlers.find(Message::Method(method)));
                 if (index != _handlers.end()) {
                     result = index->second.Invoke(connection, method, parameters, response);
                 }
                 return (result);
             }
+            uint32_t Invoke(const MethodId id, const Connection connection, const string& method, const string& parameters, string& response)
+            {
+                ASSERT(id != nullptr);
+
+                response.clear();
+
+                return (id->Invoke(connection, method, parameters, response));
+            }
             void Subscribe(const uint32_t id, const string& eventId, const string& callsign, Core::JSONRPC::Message& response)
             {
                 _adminLock.Lock();
@@ -1013,15 +1143,35 @@ namespace Core {
 
                     result = Core::ERROR_NONE;
 
-                    while (loop != clients.end()) {
-                        const string& designator(loop->Designator());
+                    if (!_broadcastFunction) {
+                        while (loop != clients.end()) {
+                            const string& designator(loop->Designator());
+
+                            if (!sendifmethod || sendifmethod(designator)) {
+
+                                _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
+                            }
 
-                        if (!sendifmethod || sendifmethod(designator)) {
+                            loop++;
+                        }
+                    } else {
+                        // Subscribers registered with the same designator receive the same message, group them.
+                        std::map<string, std::vector<uint32_t>> recipients;
+
+                        while (loop != clients.end()) {
+                            const string& designator(loop->Designator());
+
+                            if (!sendifmethod || sendifmethod(designator)) {
 
-                            _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
+                                recipients[designator].push_back(loop->Id());
+                            }
+
+                            loop++;
                         }
 
-                        loop++;
+                        for (const std::pair<const string, std::vector<uint32_t>>& entry : recipients) {
+                            _broadcastFunction(entry.second, (entry.first.empty() == false ? entry.first + '.' + event : event), parameters);
+                        }
                     }
                 }
 
@@ -1035,7 +1185,9 @@ namespace Core {
             HandlerMap _handlers;
             ObserverMap _observers;
             NotificationFunction _notificationFunction;
+            BroadcastFunction _broadcastFunction;
             const std::vector<uint8_t> _versions;
+            uint32_t _generation;
         };
 
         using Error = Message::Info;
@@ -181,12 +181,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -347,15 +347,19 @@ namespace Core {
         {
             _channel.Trigger();
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
             // Serialize Response
-            return (_serializerImpl.Serialize(dataFrame, maxSendSize));
+            return (Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                return (_serializerImpl.Serialize(&(dataFrame[offset]), size));
+            }));
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
             // Deserialize Request
-            return (_deserialiserImpl.Deserialize(dataFrame, receivedSize));
+            return (Chunked(receivedSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                return (_deserialiserImpl.Deserialize(&(dataFrame[offset]), size));
+            }));
         }
 
     private:
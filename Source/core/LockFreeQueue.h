@@ -0,0 +1,430 @@
+#ifndef __LOCKFREEQUEUE_H
+#define __LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <list>
+#include <thread>
+
+#include "Module.h"
+#include "Portability.h"
+#include "Sync.h"
+#include "Trace.h"
+
+#if defined(__LINUX__) && !defined(__APPLE__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#ifdef __WINDOWS__
+#pragma comment(lib, "Synchronization.lib")
+#endif
+
+namespace WPEFramework {
+namespace Core {
+
+    // -------------------------------------------------------------------
+    // Bounded Multiple-Producer/Multiple-Consumer queue. The slots live in
+    // a ring of cells, each carrying a sequence number that tells whether
+    // it can be written or read for a given position (D. Vyukov). Posting
+    // and extracting an entry costs a single CAS, no locks and no heap
+    // allocations. Threads that have to wait for an entry (or a free slot)
+    // are parked on a futex, which is only touched if someone sleeps.
+    // The interface follows the QueueType, so it can replace it as is:
+    // Insert waits for a free slot, Post never refuses an entry on an
+    // enabled queue. If the ring is full, Post appends to a locked
+    // overflow list, which is drained, in order, once the ring is empty.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT>
+    class LockFreeQueueType {
+    private:
+        LockFreeQueueType() = delete;
+        LockFreeQueueType(const LockFreeQueueType<CONTEXT>&) = delete;
+        LockFreeQueueType& operator=(const LockFreeQueueType<CONTEXT>&) = delete;
+
+        // A cell is guarded against a concurrent Remove, while it is read.
+        static constexpr uint8_t LOCKED = 0x01;
+        static constexpr uint8_t REVOKED = 0x02;
+
+        struct Cell {
+            std::atomic<uint32_t> sequence;
+            std::atomic<uint8_t> guard;
+            CONTEXT data;
+        };
+
+        class Parking {
+        private:
+            Parking(const Parking&) = delete;
+            Parking& operator=(const Parking&) = delete;
+
+        public:
+            Parking()
+                : _ticket(0)
+                , _sleepers(0)
+            {
+                static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex requires a plain 32 bits word");
+            }
+            ~Parking()
+            {
+            }
+
+        public:
+            inline uint32_t Ticket() const
+            {
+                return (_ticket.load(std::memory_order_acquire));
+            }
+            inline void Enter()
+            {
+                _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            }
+            inline void Leave()
+            {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+            // Sleep as long as nobody changed the ticket, returns immediately if it already changed.
+            void Wait(const uint32_t ticket, const uint32_t waitTime)
+            {
+#if defined(__LINUX__) && !defined(__APPLE__)
+                struct timespec timeout;
+                timeout.tv_sec = waitTime / 1000;
+                timeout.tv_nsec = (waitTime % 1000) * 1000000;
+
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_ticket), FUTEX_WAIT_PRIVATE, ticket, (waitTime == Core::infinite ? nullptr : &timeout), nullptr, 0);
+#elif defined(__WINDOWS__)
+                ::WaitOnAddress(&_ticket, const_cast<uint32_t*>(&ticket), sizeof(uint32_t), (waitTime == Core::infinite ? INFINITE : waitTime));
+#else
+                if (Ticket() == ticket) {
+                    SleepMs(1);
+                }
+#endif
+            }
+            inline void Wake(const bool all)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if ((all == true) || (_sleepers.load(std::memory_order_relaxed) > 0)) {
+                    _ticket.fetch_add(1, std::memory_order_release);
+#if defined(__LINUX__) && !defined(__APPLE__)
+                    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_ticket), FUTEX_WAKE_PRIVATE, (all == true ? INT32_MAX : 1), nullptr, nullptr, 0);
+#elif defined(__WINDOWS__)
+                    if (all == true) {
+                        ::WakeByAddressAll(&_ticket);
+                    } else {
+                        ::WakeByAddressSingle(&_ticket);
+                    }
+#endif
+                }
+            }
+
+        private:
+            std::atomic<uint32_t> _ticket;
+            std::atomic<uint32_t> _sleepers;
+        };
+
+    public:
+        explicit LockFreeQueueType(const uint32_t highWaterMark)
+            : _slots(RoundUp(highWaterMark))
+            , _cells(new Cell[_slots])
+            , _enqueue(0)
+            , _dequeue(0)
+            , _disabled(false)
+            , _readers()
+            , _writers()
+            , _overflowLock()
+            , _overflow()
+            , _overflowed(0)
+        {
+            // A highwatermark of 0 makes no sense.
+            ASSERT(highWaterMark != 0);
+
+            for (uint32_t index = 0; index < _slots; index++) {
+                _cells[index].sequence.store(index, std::memory_order_relaxed);
+                _cells[index].guard.store(0, std::memory_order_relaxed);
+            }
+        }
+        ~LockFreeQueueType()
+        {
+            // Disable the queue and flush all entries.
+            Disable();
+            Flush();
+
+            delete[] _cells;
+        }
+
+    public:
+        bool Remove(const CONTEXT& entry)
+        {
+            bool removed = false;
+
+            if (_disabled.load(std::memory_order_acquire) == false) {
+                uint32_t position = _dequeue.load(std::memory_order_acquire);
+                const uint32_t end = _enqueue.load(std::memory_order_acquire);
+
+                // Entries can not be taken out of the ring, they are marked as revoked and skipped by the reader.
+                while ((removed == false) && (position != end)) {
+                    Cell& cell(_cells[position & (_slots - 1)]);
+
+                    Lock(cell);
+
+                    if ((cell.sequence.load(std::memory_order_acquire) == (position + 1)) && ((cell.guard.load(std::memory_order_relaxed) & REVOKED) == 0) && (cell.data == entry)) {
+                        cell.data = CONTEXT();
+                        cell.guard.store(REVOKED, std::memory_order_release);
+                        removed = true;
+                    } else {
+                        cell.guard.fetch_and(static_cast<uint8_t>(~LOCKED), std::memory_order_release);
+                    }
+
+                    position++;
+                }
+
+                if ((removed == false) && (_overflowed.load(std::memory_order_acquire) != 0)) {
+                    _overflowLock.Lock();
+
+                    typename std::list<CONTEXT>::iterator index(std::find(_overflow.begin(), _overflow.end(), entry));
+
+                    if (index != _overflow.end()) {
+                        _overflow.erase(index);
+                        _overflowed.fetch_sub(1, std::memory_order_release);
+                        removed = true;
+                    }
+
+                    _overflowLock.Unlock();
+                }
+            }
+
+            return (removed);
+        }
+        bool Post(const CONTEXT& entry)
+        {
+            bool result = (_disabled.load(std::memory_order_acquire) == false);
+
+            // Once entries overflowed, new ones queue up behind them to keep the order.
+            if ((result == true) && ((_overflowed.load(std::memory_order_acquire) != 0) || (Push(entry) == false))) {
+                _overflowLock.Lock();
+                _overflow.push_back(entry);
+                _overflowed.fetch_add(1, std::memory_order_release);
+                _overflowLock.Unlock();
+            }
+
+            if (result == true) {
+                _readers.Wake(false);
+            }
+
+            return (result);
+        }
+        bool Insert(const CONTEXT& entry, uint32_t waitTime)
+        {
+            bool posted = false;
+
+            while ((posted == false) && (_disabled.load(std::memory_order_acquire) == false)) {
+                if ((_overflowed.load(std::memory_order_acquire) == 0) && (Push(entry) == true)) {
+                    posted = true;
+                } else if (waitTime == 0) {
+                    break;
+                } else {
+                    const uint32_t ticket = _writers.Ticket();
+
+                    _writers.Enter();
+
+                    if ((_disabled.load(std::memory_order_acquire) == false) && ((_overflowed.load(std::memory_order_acquire) != 0) || ((posted = Push(entry)) == false))) {
+                        _writers.Wait(ticket, waitTime);
+
+                        if (waitTime != Core::infinite) {
+                            waitTime = 0;
+                        }
+                    }
+
+                    _writers.Leave();
+                }
+            }
+
+            if (posted == true) {
+                _readers.Wake(false);
+            }
+
+            return (posted);
+        }
+        bool Extract(CONTEXT& result, uint32_t waitTime)
+        {
+            bool received = false;
+
+            while ((received == false) && (_disabled.load(std::memory_order_acquire) == false)) {
+                if (Pop(result) == true) {
+                    received = true;
+                } else if (waitTime == 0) {
+                    break;
+                } else {
+                    const uint32_t ticket = _readers.Ticket();
+
+                    _readers.Enter();
+
+                    if ((_disabled.load(std::memory_order_acquire) == false) && ((received = Pop(result)) == false)) {
+                        _readers.Wait(ticket, waitTime);
+
+                        if (waitTime != Core::infinite) {
+                            waitTime = 0;
+                        }
+                    }
+
+                    _readers.Leave();
+                }
+            }
+
+            if (received == true) {
+                _writers.Wake(false);
+            }
+
+            return (received);
+        }
+        void Enable()
+        {
+            _disabled.store(false, std::memory_order_release);
+        }
+        void Disable()
+        {
+            if (_disabled.exchange(true, std::memory_order_acq_rel) == false) {
+                _readers.Wake(true);
+                _writers.Wake(true);
+            }
+        }
+        void Flush()
+        {
+            // Clear is only possible in a "DISABLED" state !!
+            ASSERT(_disabled.load() == true);
+
+            CONTEXT entry;
+
+            while (Pop(entry) == true) {
+                entry = CONTEXT();
+            }
+        }
+        inline bool IsEmpty() const
+        {
+            return (Length() == 0);
+        }
+        inline bool IsFull() const
+        {
+            return (Length() >= _slots);
+        }
+        // Revoked entries are counted until a reader skipped them.
+        inline uint32_t Length() const
+        {
+            return (_enqueue.load(std::memory_order_relaxed) - _dequeue.load(std::memory_order_relaxed) + _overflowed.load(std::memory_order_relaxed));
+        }
+
+    private:
+        static uint32_t RoundUp(const uint32_t value)
+        {
+            uint32_t result = 2;
+
+            while (result < value) {
+                result <<= 1;
+            }
+
+            return (result);
+        }
+        inline void Lock(Cell& cell)
+        {
+            uint8_t expected = cell.guard.load(std::memory_order_relaxed) & (~LOCKED);
+
+            while (cell.guard.compare_exchange_weak(expected, (expected | LOCKED), std::memory_order_acquire) == false) {
+                expected &= (~LOCKED);
+                std::this_thread::yield();
+            }
+        }
+        bool Push(const CONTEXT& entry)
+        {
+            uint32_t position = _enqueue.load(std::memory_order_relaxed);
+
+            while (true) {
+                Cell& cell(_cells[position & (_slots - 1)]);
+                const int32_t difference = static_cast<int32_t>(cell.sequence.load(std::memory_order_acquire) - position);
+
+                if (difference == 0) {
+                    if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                        cell.data = entry;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return (true);
+                    }
+                } else if (difference < 0) {
+                    // The ring is full..
+                    return (false);
+                } else {
+                    position = _enqueue.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        bool Pop(CONTEXT& result)
+        {
+            bool revoked = true;
+
+            while (revoked == true) {
+                uint32_t position = _dequeue.load(std::memory_order_relaxed);
+                Cell* cell = nullptr;
+
+                while (cell == nullptr) {
+                    Cell& candidate(_cells[position & (_slots - 1)]);
+                    const int32_t difference = static_cast<int32_t>(candidate.sequence.load(std::memory_order_acquire) - (position + 1));
+
+                    if (difference == 0) {
+                        if (_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                            cell = &candidate;
+                        }
+                    } else if (difference < 0) {
+                        // The ring is empty, continue with the entries that did not fit..
+                        return (PopOverflow(result));
+                    } else {
+                        position = _dequeue.load(std::memory_order_relaxed);
+                    }
+                }
+
+                Lock(*cell);
+
+                revoked = ((cell->guard.load(std::memory_order_relaxed) & REVOKED) != 0);
+
+                if (revoked == false) {
+                    result = cell->data;
+                }
+                cell->data = CONTEXT();
+                cell->guard.store(0, std::memory_order_release);
+                cell->sequence.store(position + _slots, std::memory_order_release);
+            }
+
+            return (true);
+        }
+
+        bool PopOverflow(CONTEXT& result)
+        {
+            bool popped = false;
+
+            if (_overflowed.load(std::memory_order_acquire) != 0) {
+                _overflowLock.Lock();
+
+                if (_overflow.empty() == false) {
+                    result = _overflow.front();
+                    _overflow.pop_front();
+                    _overflowed.fetch_sub(1, std::memory_order_release);
+                    popped = true;
+                }
+
+                _overflowLock.Unlock();
+            }
+
+            return (popped);
+        }
+
+    private:
+        const uint32_t _slots;
+        Cell* _cells;
+        std::atomic<uint32_t> _enqueue;
+        std::atomic<uint32_t> _dequeue;
+        std::atomic<bool> _disabled;
+        Parking _readers;
+        Parking _writers;
+        Core::CriticalSection _overflowLock;
+        std::list<CONTEXT> _overflow;
+        std::atomic<uint32_t> _overflowed;
+    };
+}
+} // namespace Core
+
+#endif // __LOCKFREEQUEUE_H
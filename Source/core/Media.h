@@ -83,11 +83,11 @@ namespace Core {
             {
                 _parent.Reevaluate();
             }
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -359,9 +359,9 @@ namespace Core {
             _receiveSignal.SetEvent();
         }
         // Methods to extract and insert data into the socket buffers
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
@@ -383,9 +383,9 @@ namespace Core {
 
             return (result);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
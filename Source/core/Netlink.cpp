@@ -146,9 +146,9 @@ namespace Core {
     }
 
     // Methods to extract and insert data into the socket buffers
-    /* virtual */ uint16_t SocketNetlink::SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+    /* virtual */ uint32_t SocketNetlink::SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
     {
-        uint16_t result = 0;
+        uint32_t result = 0;
 
         if (_pending.size() > 0) {
 
@@ -162,7 +162,7 @@ namespace Core {
             }
 
             if (index != _pending.end()) {
-                result = index->Serialize(dataFrame, maxSendSize);
+                result = index->Serialize(dataFrame, static_cast<uint16_t>(std::min(maxSendSize, static_cast<uint32_t>(0xFFFF))));
             }
 
             _adminLock.Unlock();
@@ -176,11 +176,12 @@ namespace Core {
         return (result);
     }
 
-    /* virtual */ uint16_t SocketNetlink::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+    /* virtual */ uint32_t SocketNetlink::ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
     {
 
-        uint16_t result = receivedSize;
-        Netlink::Frames frames(dataFrame, receivedSize);
+        // Netlink messages are datagrams, they never exceed 64KB.
+        uint32_t result = receivedSize;
+        Netlink::Frames frames(dataFrame, static_cast<uint16_t>(receivedSize));
 
 #ifdef DEBUG_FRAMES
         DumpFrame("RECEIVED", dataFrame, result);
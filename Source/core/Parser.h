@@ -128,6 +128,24 @@ namespace Core {
                 }
 
                 while (((_state & SKIP_WHITESPACE) == 0) && (current < maxLength)) {
+                    if (((_state & (ESCAPED | QUOTED | UPPERCASE | LOWERCASE)) == 0) && (_byteCounter == 0)) {
+                        // Characters that need no inspection are taken in one go, straight from the stream.
+                        uint16_t end = current;
+
+                        while ((end < maxLength) && (IsPlain(stream[end]) == true)) {
+                            end++;
+                        }
+
+                        if (end != current) {
+                            const size_t length = _buffer.length();
+
+                            _buffer.resize(length + (end - current));
+                            std::copy(&stream[current], &stream[end], &_buffer[length]);
+                            current = end;
+                            continue;
+                        }
+                    }
+
                     TCHAR character = ((_state & UPPERCASE) != 0 ? toupper(stream[current]) : ((_state & LOWERCASE) != 0 ? tolower(stream[current]) : stream[current]));
 
                     if ((_state & ESCAPED) == ESCAPED) {
@@ -202,6 +220,13 @@ namespace Core {
             return (current);
         }
 
+    private:
+        // Anything that might be whitespace, quoting or (part of) one of the terminators is not plain.
+        inline bool IsPlain(const uint8_t character) const
+        {
+            return ((character != '\0') && (character != ' ') && (character != '\t') && (character != '\\') && (character != '\"') && (character != '\r') && (character != '\n') && (((_state & SPLITCHAR) == 0) || (character != static_cast<uint8_t>(_splitChar))));
+        }
+
     private:
         uint16_t _state;
         uint32_t _byteCounter;
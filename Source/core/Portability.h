@@ -531,6 +531,27 @@ namespace Core {
         std::transform(inplace.begin(), inplace.end(), inplace.begin(), ::tolower);
     }
 
+    // Most (de)serializers take at most 64KB per call, while a port can offer a larger buffer. Hands
+    // the buffer over in chunks, as long as each chunk is used completely, so a short count still
+    // marks the end of a message (or of what could be taken). The handler gets the offset in the
+    // buffer and the chunk size and returns what it handled.
+    template <typename HANDLER>
+    uint32_t Chunked(const uint32_t length, HANDLER&& handler)
+    {
+        uint32_t result = 0;
+        bool more = (length > 0);
+
+        while (more == true) {
+            const uint16_t size = static_cast<uint16_t>(std::min(length - result, static_cast<uint32_t>(0xFFFF)));
+            const uint16_t handled = handler(result, size);
+
+            result += handled;
+            more = ((handled == size) && (result < length));
+        }
+
+        return (result);
+    }
+
     const uint32_t infinite = -1;
     static const string emptyString;
 
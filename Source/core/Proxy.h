@@ -2,8 +2,11 @@
 #define __PROXY_H
 
 // ---- Include system wide include files ----
+#include <atomic>
 #include <map>
 #include <memory>
+#include <list>
+#include <vector>
 
 // ---- Include local include files ----
 #include "StateTrigger.h"
@@ -1026,9 +1029,7 @@ namespace Core {
 
                     baseElement->__Clear<ELEMENT>();
 
-                    Core::ProxyType<ProxyObjectType> returnObject(static_cast<IReferenceCounted*>(baseElement), baseElement);
-
-                    _queue.Return(returnObject);
+                    _queue.Return(baseElement);
 
                     return (Core::ERROR_DESTRUCTION_SUCCEEDED);
                 }
@@ -1064,106 +1065,527 @@ namespace Core {
     private:
         typedef ProxyObjectType<PROXYPOOLELEMENT> ProxyPoolElement;
 
-    public:
-        ProxyPoolType(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
-        ProxyPoolType<PROXYPOOLELEMENT>& operator=(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
+        // A magazine is a small stack of idle elements. It moves as a whole between the cache
+        // of a thread and the depot of the pool.
+        class Magazine {
+        public:
+            static constexpr uint8_t Size = 16;
 
-        ProxyPoolType(const uint32_t initialQueueSize)
-            : _createdElements(0)
-            , _queue(initialQueueSize)
-            , _lock()
-        {
-        }
-        ~ProxyPoolType()
-        {
-        }
+            Magazine(const Magazine&) = delete;
+            Magazine& operator=(const Magazine&) = delete;
 
-    public:
-        Core::ProxyType<PROXYPOOLELEMENT> Element()
-        {
-            Core::ProxyType<PROXYPOOLELEMENT> result;
+            Magazine()
+                : _count(0)
+            {
+            }
+            // Like the pool always did, idle elements are not destructed with it. Their destructors
+            // may refer to objects that are gone by then.
+            ~Magazine()
+            {
+            }
 
-            _lock.Lock();
+        public:
+            inline bool IsEmpty() const
+            {
+                return (_count == 0);
+            }
+            inline bool IsFull() const
+            {
+                return (_count == Size);
+            }
+            inline uint8_t Count() const
+            {
+                return (_count);
+            }
+            inline ProxyPoolElement* Pop()
+            {
+                ASSERT(_count > 0);
+                return (_elements[--_count]);
+            }
+            inline void Push(ProxyPoolElement* element)
+            {
+                ASSERT(_count < Size);
+                _elements[_count++] = element;
+            }
 
-            if (_queue.Count() == 0) {
+        private:
+            ProxyPoolElement* _elements[Size];
+            uint8_t _count;
+        };
 
-                _createdElements++;
+        // The counters of a thread cache. Only its own thread writes them, without synchronisation,
+        // they are summed when the pool is queried.
+        struct Counters {
+            std::atomic<uint32_t> Reused;
+            std::atomic<int32_t> Outstanding;
+        };
 
-                _lock.Unlock();
+        // The depot keeps the magazines that are not loaded by a thread. Its slots are taken and
+        // filled with atomic operations only. Elements that do not fit in the slots, or that are
+        // returned without a thread cache, go to the overflow list, which does take the lock.
+        // The depot outlives the pool as long as thread caches refer to it.
+        class Depot {
+        public:
+            static constexpr uint8_t Slots = 16;
+
+            Depot(const Depot&) = delete;
+            Depot& operator=(const Depot&) = delete;
+
+            Depot(const uint32_t initialQueueSize)
+                : _refCount(1)
+                , _closed(false)
+                , _created(0)
+                , _reused(0)
+                , _outstanding(0)
+                , _overflow()
+                , _counters()
+                , _lock()
+            {
+                for (uint8_t index = 0; index < Slots; index++) {
+                    _stocked[index] = nullptr;
+                    _empty[index] = nullptr;
+                }
+                _overflow.reserve(initialQueueSize);
+            }
+            ~Depot()
+            {
+                for (uint8_t index = 0; index < Slots; index++) {
+                    delete _stocked[index].load();
+                    delete _empty[index].load();
+                }
+            }
 
-                result = ProxyPoolElement::Create(*this);
+        public:
+            inline void AddRef()
+            {
+                _refCount++;
+            }
+            inline void Release()
+            {
+                if (--_refCount == 0) {
+                    delete this;
+                }
+            }
+            inline void Close()
+            {
+                _closed = true;
+            }
+            inline bool IsClosed() const
+            {
+                return (_closed.load());
+            }
 
-                // TRACE_L1("Created a new element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
-            } else {
-                Core::ProxyType<ProxyPoolElement> listLoad;
+            // Hands out a magazine holding elements, if there is one.
+            Magazine* Stocked()
+            {
+                return (Take(_stocked));
+            }
+            // Stores a magazine holding elements, returns false if all slots are taken.
+            bool Stocked(Magazine* magazine)
+            {
+                return (Put(_stocked, magazine));
+            }
+            Magazine* Empty()
+            {
+                Magazine* result = Take(_empty);
+                return (result != nullptr ? result : new Magazine());
+            }
+            void Empty(Magazine* magazine)
+            {
+                ASSERT(magazine->IsEmpty() == true);
+
+                if (Put(_empty, magazine) == false) {
+                    delete magazine;
+                }
+            }
+            ProxyPoolElement* Pop()
+            {
+                ProxyPoolElement* result = nullptr;
 
-                _queue.Remove(0, listLoad);
+                _lock.Lock();
+
+                if (_overflow.empty() == false) {
+                    result = _overflow.back();
+                    _overflow.pop_back();
+                }
 
                 _lock.Unlock();
 
-                result = Core::proxy_cast<PROXYPOOLELEMENT>(listLoad);
+                return (result);
+            }
+            void Push(ProxyPoolElement* element)
+            {
+                _lock.Lock();
+                _overflow.push_back(element);
+                _lock.Unlock();
+            }
+            void Spill(Magazine& magazine)
+            {
+                _lock.Lock();
+                while (magazine.IsEmpty() == false) {
+                    _overflow.push_back(magazine.Pop());
+                }
+                _lock.Unlock();
+            }
+            Counters* Attach()
+            {
+                _lock.Lock();
+
+                _counters.emplace_back();
+                Counters* result = &(_counters.back());
+                result->Reused = 0;
+                result->Outstanding = 0;
 
-                // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+                _lock.Unlock();
+
+                return (result);
             }
+            // The counts of a thread cache that goes away are kept by the depot.
+            void Detach(Counters* counters)
+            {
+                _lock.Lock();
 
-            return (result);
-        }
-        template <typename Arg1>
-        Core::ProxyType<PROXYPOOLELEMENT> Element(Arg1 argument1)
-        {
-            Core::ProxyType<PROXYPOOLELEMENT> result;
+                typename std::list<Counters>::iterator index(_counters.begin());
 
-            _lock.Lock();
+                while ((index != _counters.end()) && (&(*index) != counters)) {
+                    index++;
+                }
 
-            if (_queue.Count() == 0) {
+                ASSERT(index != _counters.end());
 
-                _createdElements++;
+                _reused += counters->Reused.load(std::memory_order_relaxed);
+                _outstanding += counters->Outstanding.load(std::memory_order_relaxed);
+                _counters.erase(index);
 
                 _lock.Unlock();
+            }
+            inline void Account(const uint32_t created, const uint32_t reused, const int32_t outstanding)
+            {
+                if (created != 0) {
+                    _created += created;
+                }
+                if (reused != 0) {
+                    _reused += reused;
+                }
+                if (outstanding != 0) {
+                    _outstanding += outstanding;
+                }
+            }
+            inline uint32_t Created() const
+            {
+                return (_created.load());
+            }
+            uint32_t Reused() const
+            {
+                _lock.Lock();
 
-                result = ProxyPoolElement::Create(*this, argument1);
+                uint32_t result = _reused.load();
 
-                // TRACE_L1("Created a new element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
-            } else {
-                Core::ProxyType<ProxyPoolElement> listLoad;
+                for (const Counters& counters : _counters) {
+                    result += counters.Reused.load(std::memory_order_relaxed);
+                }
 
-                _queue.Remove(0, listLoad);
+                _lock.Unlock();
+
+                return (result);
+            }
+            uint32_t Outstanding() const
+            {
+                _lock.Lock();
+
+                int32_t result = _outstanding.load();
+
+                for (const Counters& counters : _counters) {
+                    result += counters.Outstanding.load(std::memory_order_relaxed);
+                }
 
                 _lock.Unlock();
 
-                result = Core::proxy_cast<PROXYPOOLELEMENT>(listLoad);
+                return (static_cast<uint32_t>(result));
+            }
+            uint32_t Capacity() const
+            {
+                uint32_t result = 0;
+
+                _lock.Lock();
+
+                result = static_cast<uint32_t>(_overflow.capacity()) + (Slots * Magazine::Size);
 
-                // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+                _lock.Unlock();
+
+                return (result);
             }
 
-            return (result);
+        private:
+            static Magazine* Take(std::atomic<Magazine*> slots[])
+            {
+                Magazine* result = nullptr;
+
+                for (uint8_t index = 0; (index < Slots) && (result == nullptr); index++) {
+                    if (slots[index].load() != nullptr) {
+                        result = slots[index].exchange(nullptr);
+                    }
+                }
+
+                return (result);
+            }
+            static bool Put(std::atomic<Magazine*> slots[], Magazine* magazine)
+            {
+                bool result = false;
+
+                for (uint8_t index = 0; (index < Slots) && (result == false); index++) {
+                    Magazine* expected = nullptr;
+                    result = ((slots[index].load() == nullptr) && (slots[index].compare_exchange_strong(expected, magazine) == true));
+                }
+
+                return (result);
+            }
+
+        private:
+            std::atomic<uint32_t> _refCount;
+            std::atomic<bool> _closed;
+            std::atomic<uint32_t> _created;
+            std::atomic<uint32_t> _reused;
+            std::atomic<int32_t> _outstanding;
+            std::atomic<Magazine*> _stocked[Slots];
+            std::atomic<Magazine*> _empty[Slots];
+            std::vector<ProxyPoolElement*> _overflow;
+            std::list<Counters> _counters;
+            mutable Core::CriticalSection _lock;
+        };
+
+        // Every thread keeps a loaded and a previous magazine for the pools it used last, so most
+        // elements are handed out and returned without any synchronisation.
+        class ThreadCache {
+        public:
+            static constexpr uint8_t Pools = 4;
+
+            struct Entry {
+                Depot* Owner;
+                Magazine* Loaded;
+                Magazine* Previous;
+                Counters* Counts;
+            };
+
+            ThreadCache(const ThreadCache&) = delete;
+            ThreadCache& operator=(const ThreadCache&) = delete;
+
+            ThreadCache()
+            {
+                for (Entry& entry : _entries) {
+                    entry.Owner = nullptr;
+                }
+            }
+            ~ThreadCache()
+            {
+                _closed = true;
+
+                for (Entry& entry : _entries) {
+                    if (entry.Owner != nullptr) {
+                        Retire(entry);
+                    }
+                }
+            }
+
+        public:
+            Entry* Find(Depot* owner)
+            {
+                Entry* result = nullptr;
+                Entry* available = nullptr;
+
+                for (uint8_t index = 0; (index < Pools) && (result == nullptr); index++) {
+                    Entry& entry(_entries[index]);
+
+                    if (entry.Owner == owner) {
+                        result = &entry;
+                    } else {
+                        if ((entry.Owner != nullptr) && (entry.Owner->IsClosed() == true)) {
+                            Retire(entry);
+                        }
+                        if ((entry.Owner == nullptr) && (available == nullptr)) {
+                            available = &entry;
+                        }
+                    }
+                }
+
+                if ((result == nullptr) && (available != nullptr)) {
+                    owner->AddRef();
+                    available->Owner = owner;
+                    available->Loaded = owner->Empty();
+                    available->Previous = owner->Empty();
+                    available->Counts = owner->Attach();
+                    result = available;
+                }
+
+                return (result);
+            }
+
+        private:
+            static void Retire(Entry& entry)
+            {
+                Depot* owner = entry.Owner;
+                Magazine* magazines[] = { entry.Loaded, entry.Previous };
+
+                for (Magazine* magazine : magazines) {
+                    if (owner->IsClosed() == true) {
+                        delete magazine;
+                    } else if (magazine->IsEmpty() == true) {
+                        owner->Empty(magazine);
+                    } else if (owner->Stocked(magazine) == false) {
+                        owner->Spill(*magazine);
+                        owner->Empty(magazine);
+                    }
+                }
+
+                owner->Detach(entry.Counts);
+                owner->Release();
+
+                entry.Owner = nullptr;
+            }
+
+        private:
+            Entry _entries[Pools];
+        };
+
+        // Elements can be returned after the cache of the thread is destructed, e.g. by static
+        // destructors. From then on, they go straight to the depot.
+        static thread_local bool _closed;
+
+        static ThreadCache& Cache()
+        {
+            static thread_local ThreadCache cache;
+            return (cache);
+        }
+
+    public:
+        ProxyPoolType(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
+        ProxyPoolType<PROXYPOOLELEMENT>& operator=(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
+
+        ProxyPoolType(const uint32_t initialQueueSize)
+            : _depot(new Depot(initialQueueSize))
+        {
+        }
+        ~ProxyPoolType()
+        {
+            _depot->Close();
+            _depot->Release();
         }
-        void Return(Core::ProxyType<ProxyPoolElement>& element) const
+
+    public:
+        Core::ProxyType<PROXYPOOLELEMENT> Element()
         {
-            _lock.Lock();
-            // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
-            _queue.Add(element);
-            _lock.Unlock();
+            ProxyPoolElement* element = Acquire();
+
+            return (element != nullptr ? Core::ProxyType<PROXYPOOLELEMENT>(static_cast<IReferenceCounted*>(element), static_cast<PROXYPOOLELEMENT*>(element)) : ProxyPoolElement::Create(*this));
         }
+        template <typename Arg1>
+        Core::ProxyType<PROXYPOOLELEMENT> Element(Arg1 argument1)
+        {
+            ProxyPoolElement* element = Acquire();
+
+            return (element != nullptr ? Core::ProxyType<PROXYPOOLELEMENT>(static_cast<IReferenceCounted*>(element), static_cast<PROXYPOOLELEMENT*>(element)) : ProxyPoolElement::Create(*this, argument1));
+        }
+        void Return(ProxyPoolElement* element) const
+        {
+            typename ThreadCache::Entry* entry = (_closed == false ? Cache().Find(_depot) : nullptr);
+
+            if (entry == nullptr) {
+                _depot->Push(element);
+                _depot->Account(0, 0, -1);
+            } else {
+                if ((entry->Loaded->IsFull() == true) && (entry->Previous->IsFull() == false)) {
+                    std::swap(entry->Loaded, entry->Previous);
+                }
+                if (entry->Loaded->IsFull() == true) {
+                    // Both magazines are full, hand one to the depot.
+                    if (_depot->Stocked(entry->Previous) == false) {
+                        _depot->Spill(*(entry->Previous));
+                        _depot->Empty(entry->Previous);
+                    }
+                    entry->Previous = entry->Loaded;
+                    entry->Loaded = _depot->Empty();
+                }
+
+                Count(entry->Counts->Outstanding, -1);
+                entry->Loaded->Push(element);
+            }
+        }
+        // Elements created, because there were none to reuse.
         inline uint32_t CreatedElements() const
         {
-            return (_createdElements);
+            return (_depot->Created());
+        }
+        // Elements handed out again.
+        inline uint32_t ReusedElements() const
+        {
+            return (_depot->Reused());
         }
+        // Elements handed out and not returned yet.
+        inline uint32_t OutstandingElements() const
+        {
+            return (_depot->Outstanding());
+        }
+        // Elements waiting to be reused, by the depot or in the cache of a thread.
         inline uint32_t QueuedElements() const
         {
-            return (_queue.Count());
+            const uint32_t outstanding = _depot->Outstanding();
+            const uint32_t created = _depot->Created();
+
+            return (created > outstanding ? created - outstanding : 0);
         }
         inline uint32_t CurrentQueueSize() const
         {
-            return (_queue.CurrentQueueSize());
+            return (_depot->Capacity());
         }
 
     private:
-        uint32_t _createdElements;
-        mutable Core::ProxyList<ProxyPoolElement> _queue;
-        mutable Core::CriticalSection _lock;
+        ProxyPoolElement* Acquire()
+        {
+            ProxyPoolElement* result = nullptr;
+            typename ThreadCache::Entry* entry = (_closed == false ? Cache().Find(_depot) : nullptr);
+
+            if (entry != nullptr) {
+                if ((entry->Loaded->IsEmpty() == true) && (entry->Previous->IsEmpty() == false)) {
+                    std::swap(entry->Loaded, entry->Previous);
+                }
+                if (entry->Loaded->IsEmpty() == true) {
+                    // Both magazines are empty, get a stocked one from the depot.
+                    Magazine* stocked = _depot->Stocked();
+
+                    if (stocked != nullptr) {
+                        _depot->Empty(entry->Previous);
+                        entry->Previous = entry->Loaded;
+                        entry->Loaded = stocked;
+                    }
+                }
+                if (entry->Loaded->IsEmpty() == false) {
+                    result = entry->Loaded->Pop();
+                    Count(entry->Counts->Reused, 1u);
+                    Count(entry->Counts->Outstanding, 1);
+                }
+            }
+
+            if (result == nullptr) {
+                result = _depot->Pop();
+                _depot->Account((result == nullptr ? 1 : 0), (result == nullptr ? 0 : 1), 1);
+            }
+
+            return (result);
+        }
+        // Only the thread owning the counter writes it, there is no need for a read-modify-write.
+        template <typename TYPE>
+        inline static void Count(std::atomic<TYPE>& counter, const TYPE delta)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+    private:
+        Depot* _depot;
     };
 
+    template <typename PROXYPOOLELEMENT>
+    thread_local bool ProxyPoolType<PROXYPOOLELEMENT>::_closed = false;
+
     template <typename PROXYKEY, typename PROXYELEMENT>
     class ProxyMapType {
     private:
@@ -5,6 +5,8 @@ namespace WPEFramework {
 
 namespace Core {
 
+    /* static */ uint8_t ResourceMonitor::_defaultReactors = 1;
+
     /* static */ ResourceMonitor& ResourceMonitor::Instance()
     {
         // Tests build/destroy the ResourceMonitor for each test. In production the
@@ -7,6 +7,17 @@
 #include "Thread.h"
 #include "Trace.h"
 
+// The epoll based monitor is only available on Linux, it can be selected at build time
+// by defining CORE_EPOLL. It scales with the number of events instead of the number of
+// registered resources.
+#if defined(CORE_EPOLL) && defined(__LINUX__) && !defined(__APPLE__)
+#define __CORE_EPOLL__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <vector>
+
 namespace WPEFramework {
 
 namespace Core {
@@ -66,7 +77,22 @@ namespace Core {
             Parent& _parent;
         };
 
+#ifdef __CORE_EPOLL__
+        struct Entry {
+            RESOURCE* resource;
+            uint16_t monitor;
+            uint16_t events;
+        };
+
+        typedef std::unordered_map<int, Entry> EntryMap;
+        typedef std::vector< std::pair<int, RESOURCE*> > PendingList;
+#endif
+
     public:
+        // Resources can OR this into their Events() to get edge triggered notifications. Only
+        // honoured by the epoll monitor, the poll monitor always reports level triggered.
+        static constexpr uint16_t EDGE_TRIGGERED = 0x4000;
+
         struct Metadata {
             signed int descriptor;
             uint16_t monitor;
@@ -82,8 +108,16 @@ namespace Core {
             , _monitorRuns(0)
             , _watchDog()
             , _name(_T("Monitor::") + ClassNameOnly(typeid(RESOURCE).name()).Text())
-#ifdef __WINDOWS__
+#if defined(__WINDOWS__)
             , _action(WSACreateEvent())
+#elif defined(__CORE_EPOLL__)
+            , _resources()
+            , _pendingLock()
+            , _pending()
+            , _evaluate()
+            , _sweep(false)
+            , _epollDescriptor(-1)
+            , _signalDescriptor(-1)
 #else
             , _descriptorArrayLength(FileDescriptorAllocation)
             , _descriptorArray(static_cast<struct pollfd*>(::malloc(sizeof(::pollfd) * (_descriptorArrayLength + 1))))
@@ -96,7 +130,7 @@ namespace Core {
         {
 
             // All resources should be gone !!!
-            ASSERT(_resourceList.size() == 0);
+            ASSERT(Count() == 0);
 
             if (_monitor != nullptr) {
 
@@ -107,13 +141,23 @@ namespace Core {
                 _adminLock.Lock();
 
                 _resourceList.clear();
+#ifdef __CORE_EPOLL__
+                _resources.clear();
+#endif
 
                 _adminLock.Unlock();
 
                 delete _monitor;
             }
 
-#ifdef __LINUX__
+#if defined(__CORE_EPOLL__)
+            if (_epollDescriptor != -1) {
+                ::close(_epollDescriptor);
+            }
+            if (_signalDescriptor != -1) {
+                ::close(_signalDescriptor);
+            }
+#elif defined(__LINUX__)
             ::free(_descriptorArray);
             if (_signalDescriptor != -1) {
                 ::close(_signalDescriptor);
@@ -137,7 +181,127 @@ namespace Core {
         {
             return (_monitor != nullptr ? _monitor->Id() : 0);
         }
-        uint32_t Count() const 
+#ifdef __CORE_EPOLL__
+        uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(_resources.size()));
+        }
+        bool Info(const uint32_t position, Metadata& info) const
+        {
+            uint32_t count = position;
+
+            _adminLock.Lock();
+
+            typename EntryMap::const_iterator index(_resources.cbegin());
+            while ( (count != 0) && (index != _resources.cend()) ) { count--; index++; }
+
+            bool found = (index != _resources.cend());
+
+            if (found == true) {
+                info.descriptor = index->first;
+                info.classname  = typeid(*(index->second.resource)).name();
+                info.monitor = index->second.monitor;
+                info.events  = index->second.events;
+            }
+
+            _adminLock.Unlock();
+
+            return (found);
+        }
+        void Register(RESOURCE& resource)
+        {
+            const int descriptor = resource.Descriptor();
+
+            _adminLock.Lock();
+
+            typename EntryMap::iterator index(_resources.find(descriptor));
+
+            // Make sure this entry does not exist, only register resources once !!!
+            ASSERT((index == _resources.end()) || (index->second.resource != &resource));
+
+            if (index != _resources.end()) {
+                // The descriptor got reused, so the resource that owned it before must have
+                // closed it already. The kernel already dropped it from the epoll set.
+                TRACE_L1("Descriptor %d reused before its previous owner was unregistered", descriptor);
+                _resources.erase(index);
+            }
+
+            Entry& entry(_resources[descriptor]);
+            entry.resource = &resource;
+            entry.monitor = 0;
+            entry.events = 0;
+
+            // The Events() of the resource are evaluated by the monitor thread, as was always the case.
+            _pendingLock.Lock();
+            _pending.push_back(std::pair<int, RESOURCE*>(descriptor, &resource));
+            _pendingLock.Unlock();
+
+            if (_resources.size() == 1) {
+                if (_monitor == nullptr) {
+                    _monitor = new MonitorWorker(*this);
+
+                    // Wait till we are at least initialized
+                    _monitor->Wait(Thread::BLOCKED | Thread::STOPPED);
+                }
+
+                _monitor->Run();
+            } else {
+                Signal();
+            }
+
+            _adminLock.Unlock();
+        }
+        bool Unregister(RESOURCE& resource)
+        {
+            _adminLock.Lock();
+
+            typename EntryMap::iterator index(_resources.find(resource.Descriptor()));
+
+            if ((index == _resources.end()) || (index->second.resource != &resource)) {
+                // The descriptor might already be closed/changed, fall back to looking for the resource.
+                index = _resources.begin();
+                while ((index != _resources.end()) && (index->second.resource != &resource)) {
+                    index++;
+                }
+            }
+
+            bool found = (index != _resources.end());
+
+            if (found == true) {
+                if (index->second.monitor != 0) {
+                    ::epoll_ctl(_epollDescriptor, EPOLL_CTL_DEL, index->first, nullptr);
+                }
+                _resources.erase(index);
+            }
+
+            _adminLock.Unlock();
+
+            return (found);
+        }
+        // Re-evaluate all registered resources.
+        inline void Break()
+        {
+            ASSERT(_monitor != nullptr);
+
+            _pendingLock.Lock();
+            _sweep = true;
+            _pendingLock.Unlock();
+
+            Signal();
+        }
+        // Re-evaluate only the given resource, this does not depend on the number of registered resources.
+        inline void Break(RESOURCE& resource)
+        {
+            ASSERT(_monitor != nullptr);
+
+            _pendingLock.Lock();
+            _pending.push_back(std::pair<int, RESOURCE*>(resource.Descriptor(), &resource));
+            _pendingLock.Unlock();
+
+            Signal();
+        }
+#else
+        uint32_t Count() const
         {
             return (static_cast<uint32_t>(_resourceList.size()));
         }
@@ -194,14 +358,16 @@ namespace Core {
 
             _adminLock.Unlock();
         }
-        void Unregister(RESOURCE& resource)
+        bool Unregister(RESOURCE& resource)
         {
             _adminLock.Lock();
 
             // Make sure this entry does not exist, only register resources once !!!
             typename std::list<RESOURCE*>::iterator index(std::find(_resourceList.begin(), _resourceList.end(), &resource));
 
-            if (index != _resourceList.end()) {
+            bool found = (index != _resourceList.end());
+
+            if (found == true) {
 #ifdef __WINDOWS__
                 _resourceList.erase(index);
 #else
@@ -211,6 +377,8 @@ namespace Core {
             }
 
             _adminLock.Unlock();
+
+            return (found);
         }
         inline void Break()
         {
@@ -230,6 +398,12 @@ namespace Core {
             ::WSASetEvent(_action);
 #endif
         };
+        inline void Break(RESOURCE& /* resource */)
+        {
+            Break();
+        }
+
+#endif
 
     private:
         HAS_MEMBER(Arm, hasArm);
@@ -262,7 +436,171 @@ namespace Core {
         {
         }
 
-#ifdef __LINUX__
+#if defined(__CORE_EPOLL__)
+        inline void Signal()
+        {
+            const uint64_t value = 1;
+            ssize_t VARIABLE_IS_NOT_USED result = ::write(_signalDescriptor, &value, sizeof(value));
+        }
+        bool Initialize()
+        {
+            _epollDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+            _signalDescriptor = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            ASSERT(_epollDescriptor != -1);
+            ASSERT(_signalDescriptor != -1);
+
+            if ((_epollDescriptor != -1) && (_signalDescriptor != -1)) {
+                struct epoll_event info;
+
+                info.events = EPOLLIN;
+                info.data.fd = _signalDescriptor;
+
+                if (::epoll_ctl(_epollDescriptor, EPOLL_CTL_ADD, _signalDescriptor, &info) != 0) {
+                    TRACE_L1("Error on adding the signal descriptor to epoll. Error %d", errno);
+                    ::close(_signalDescriptor);
+                    _signalDescriptor = -1;
+                }
+            }
+
+            return ((_epollDescriptor != -1) && (_signalDescriptor != -1));
+        }
+
+        // Evaluate the events of a resource and update the epoll set accordingly. Returns
+        // false if the resource is no longer monitored.
+        bool Update(const int descriptor, RESOURCE* resource)
+        {
+            bool result = false;
+            typename EntryMap::iterator index(_resources.find(descriptor));
+
+            if ((index != _resources.end()) && (index->second.resource == resource)) {
+
+                uint16_t events = resource->Events();
+
+                // Evaluating the events might have called back into the Register/Unregister..
+                index = _resources.find(descriptor);
+
+                if ((index != _resources.end()) && (index->second.resource == resource)) {
+                    if (events == 0) {
+                        if (index->second.monitor != 0) {
+                            ::epoll_ctl(_epollDescriptor, EPOLL_CTL_DEL, descriptor, nullptr);
+                        }
+                        _resources.erase(index);
+                    } else {
+                        if (events != index->second.monitor) {
+                            struct epoll_event info;
+
+                            info.events = (events & (~EDGE_TRIGGERED)) | ((events & EDGE_TRIGGERED) != 0 ? static_cast<uint32_t>(EPOLLET) : 0u);
+                            info.data.fd = descriptor;
+
+                            int result = ::epoll_ctl(_epollDescriptor, (index->second.monitor == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD), descriptor, &info);
+
+                            if ((result != 0) && (errno == EEXIST)) {
+                                // A reused descriptor that was not yet dropped from the set..
+                                result = ::epoll_ctl(_epollDescriptor, EPOLL_CTL_MOD, descriptor, &info);
+                            }
+                            if (result != 0) {
+                                TRACE_L1("epoll_ctl failed for descriptor %d with error <%d>", descriptor, errno);
+                            }
+                            index->second.monitor = events;
+                        }
+                        result = true;
+                    }
+                }
+            }
+
+            return (result);
+        }
+
+        // Evaluate all resources that are registered or triggered since the last run.
+        void Evaluate()
+        {
+            _pendingLock.Lock();
+            _evaluate.swap(_pending);
+            bool sweep = _sweep;
+            _sweep = false;
+            _pendingLock.Unlock();
+
+            if (sweep == true) {
+                _evaluate.clear();
+                for (const std::pair<const int, Entry>& entry : _resources) {
+                    _evaluate.push_back(std::pair<int, RESOURCE*>(entry.first, entry.second.resource));
+                }
+            }
+
+            for (const std::pair<int, RESOURCE*>& entry : _evaluate) {
+                if (Update(entry.first, entry.second) == true) {
+                    Arm<WATCHDOG>();
+
+                    // A break was issued by this RESOURCE, give it a chance to act on it..
+                    entry.second->Handle(0);
+
+                    Reset<WATCHDOG>();
+                }
+            }
+
+            _evaluate.clear();
+        }
+
+        uint32_t Worker()
+        {
+            uint32_t delay = 0;
+
+            _monitorRuns++;
+
+            _adminLock.Lock();
+
+            Evaluate();
+
+            if (_resources.size() > 0) {
+                _adminLock.Unlock();
+
+                int result = ::epoll_wait(_epollDescriptor, _eventArray, FileDescriptorAllocation, -1);
+
+                _adminLock.Lock();
+
+                if (result == -1) {
+                    if (errno != EINTR) {
+                        TRACE_L1("epoll_wait failed with error <%d>", errno);
+                    }
+                }
+
+                for (int slot = 0; slot < result; slot++) {
+                    const int descriptor = _eventArray[slot].data.fd;
+
+                    if (descriptor == _signalDescriptor) {
+                        uint64_t value;
+                        ssize_t VARIABLE_IS_NOT_USED bytes = ::read(_signalDescriptor, &value, sizeof(value));
+                    } else {
+                        typename EntryMap::iterator index(_resources.find(descriptor));
+
+                        // The entry might have been removed from observing in the mean time...
+                        if (index != _resources.end()) {
+                            RESOURCE* entry = index->second.resource;
+                            uint16_t flagsSet = static_cast<uint16_t>(_eventArray[slot].events);
+
+                            index->second.events = flagsSet;
+
+                            Arm<WATCHDOG>();
+
+                            entry->Handle(flagsSet);
+
+                            Reset<WATCHDOG>();
+
+                            Update(descriptor, entry);
+                        }
+                    }
+                }
+            } else {
+                _monitor->Block();
+                delay = Core::infinite;
+            }
+
+            _adminLock.Unlock();
+
+            return (delay);
+        }
+#elif defined(__LINUX__)
         bool Initialize()
         {
 #ifdef __APPLE__
@@ -311,7 +649,7 @@ namespace Core {
         }
 #endif
 
-#ifdef __LINUX__
+#if defined(__LINUX__) && !defined(__CORE_EPOLL__)
         uint32_t Worker()
         {
             uint32_t delay = 0;
@@ -348,7 +686,7 @@ namespace Core {
                     index = _resourceList.erase(index);
                 } else {
                     _descriptorArray[filledFileDescriptors].fd = entry->Descriptor();
-                    _descriptorArray[filledFileDescriptors].events = events;
+                    _descriptorArray[filledFileDescriptors].events = (events & (~EDGE_TRIGGERED));
                     _descriptorArray[filledFileDescriptors].revents = 0;
                     filledFileDescriptors++;
                     index++;
@@ -502,7 +840,16 @@ namespace Core {
         WATCHDOG _watchDog;
         string _name;
 
-#ifdef __LINUX__
+#if defined(__CORE_EPOLL__)
+        EntryMap _resources;
+        Core::CriticalSection _pendingLock;
+        PendingList _pending;
+        PendingList _evaluate;
+        bool _sweep;
+        int _epollDescriptor;
+        int _signalDescriptor;
+        struct epoll_event _eventArray[FileDescriptorAllocation];
+#elif defined(__LINUX__)
         uint32_t _descriptorArrayLength;
         struct ::pollfd* _descriptorArray;
         int _signalDescriptor;
@@ -516,6 +863,144 @@ namespace Core {
 #endif
     };
 
+    // Spreads the resources over a number of reactors, each running its own monitor thread. The
+    // reactor is selected by the descriptor of the resource, so a slow Handle() only stalls the
+    // resources that share its reactor. With a single reactor this behaves as a plain monitor.
+    template <typename RESOURCE, typename WATCHDOG = Void>
+    class ResourceMonitorPoolType {
+    private:
+        typedef ResourceMonitorType<RESOURCE, WATCHDOG> Reactor;
+
+        ResourceMonitorPoolType() = delete;
+        ResourceMonitorPoolType(const ResourceMonitorPoolType&) = delete;
+        ResourceMonitorPoolType& operator=(const ResourceMonitorPoolType&) = delete;
+
+    public:
+        typedef typename Reactor::Metadata Metadata;
+
+        ResourceMonitorPoolType(const uint8_t reactors)
+            : _reactors()
+        {
+            ASSERT(reactors > 0);
+
+            const uint8_t count = (reactors == 0 ? 1 : reactors);
+
+            for (uint8_t index = 0; index < count; index++) {
+                _reactors.push_back(new Reactor());
+            }
+        }
+        ~ResourceMonitorPoolType()
+        {
+            for (Reactor* reactor : _reactors) {
+                delete reactor;
+            }
+        }
+
+    public:
+        uint8_t Reactors() const
+        {
+            return (static_cast<uint8_t>(_reactors.size()));
+        }
+        const TCHAR* Name() const
+        {
+            return (_reactors[0]->Name());
+        }
+        uint32_t Runs() const
+        {
+            uint32_t result = 0;
+
+            for (const Reactor* reactor : _reactors) {
+                result += reactor->Runs();
+            }
+
+            return (result);
+        }
+        ::ThreadId Id() const
+        {
+            return (_reactors[0]->Id());
+        }
+        ::ThreadId Id(const uint8_t index) const
+        {
+            ASSERT(index < _reactors.size());
+
+            return (_reactors[index]->Id());
+        }
+        bool IsMonitorThread(const ::ThreadId id) const
+        {
+            bool result = false;
+
+            for (const Reactor* reactor : _reactors) {
+                if (reactor->Id() == id) {
+                    result = true;
+                    break;
+                }
+            }
+
+            return (result);
+        }
+        uint32_t Count() const
+        {
+            uint32_t result = 0;
+
+            for (const Reactor* reactor : _reactors) {
+                result += reactor->Count();
+            }
+
+            return (result);
+        }
+        bool Info(const uint32_t position, Metadata& info) const
+        {
+            uint32_t offset = position;
+            typename std::vector<Reactor*>::const_iterator index(_reactors.cbegin());
+
+            while ((index != _reactors.cend()) && (offset >= (*index)->Count())) {
+                offset -= (*index)->Count();
+                index++;
+            }
+
+            return ((index != _reactors.cend()) && ((*index)->Info(offset, info) == true));
+        }
+        void Register(RESOURCE& resource)
+        {
+            Select(resource).Register(resource);
+        }
+        void Unregister(RESOURCE& resource)
+        {
+            Reactor& selected(Select(resource));
+
+            if ((selected.Unregister(resource) == false) && (_reactors.size() > 1)) {
+                // The descriptor might have changed since it was registered, try the others.
+                for (Reactor* reactor : _reactors) {
+                    if ((reactor != &selected) && (reactor->Unregister(resource) == true)) {
+                        break;
+                    }
+                }
+            }
+        }
+        inline void Break()
+        {
+            for (Reactor* reactor : _reactors) {
+                // Reactors that never monitored a resource, have nothing to evaluate.
+                if (reactor->Id() != 0) {
+                    reactor->Break();
+                }
+            }
+        }
+        inline void Break(RESOURCE& resource)
+        {
+            Select(resource).Break(resource);
+        }
+
+    private:
+        inline Reactor& Select(const RESOURCE& resource)
+        {
+            return (*(_reactors[static_cast<uint32_t>(resource.Descriptor()) % _reactors.size()]));
+        }
+
+    private:
+        std::vector<Reactor*> _reactors;
+    };
+
 #ifdef WATCHDOG_ENABLED
     class ResourceMonitorHandler {
     private:
@@ -538,15 +1023,15 @@ namespace Core {
         }
     };
 
-    typedef ResourceMonitorType<IResource, WatchDogType<ResourceMonitorHandler>> ResourceMonitorBase;
+    typedef ResourceMonitorPoolType<IResource, WatchDogType<ResourceMonitorHandler>> ResourceMonitorBase;
 #else
-    typedef ResourceMonitorType<IResource> ResourceMonitorBase;
+    typedef ResourceMonitorPoolType<IResource> ResourceMonitorBase;
 #endif
 
     class EXTERNAL ResourceMonitor : public ResourceMonitorBase {
     private:
         ResourceMonitor()
-            : ResourceMonitorBase()
+            : ResourceMonitorBase(_defaultReactors)
         {
         }
         ResourceMonitor(const ResourceMonitor&) = delete;
@@ -557,6 +1042,21 @@ namespace Core {
     public:
         static ResourceMonitor& Instance();
         ~ResourceMonitor() {}
+
+        // The number of reactor threads is fixed once the Instance() is created.
+        static uint8_t DefaultReactors()
+        {
+            return (_defaultReactors);
+        }
+        static void DefaultReactors(const uint8_t reactors)
+        {
+            ASSERT(reactors > 0);
+
+            _defaultReactors = (reactors == 0 ? 1 : reactors);
+        }
+
+    private:
+        static uint8_t _defaultReactors;
     };
 }
 } // namespace WPEFramework::Core
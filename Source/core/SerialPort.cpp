@@ -645,7 +645,7 @@ namespace Core {
             // subscribtion.
             m_State |= SerialPort::EXCEPTION;
             m_State &= ~SerialPort::OPEN;
-            ResourceMonitor::Instance().Break();
+            ResourceMonitor::Instance().Break(*this);
         } 
 #endif
 
@@ -677,7 +677,7 @@ namespace Core {
             // Right, a wait till connection is closed is requested..
             while ((waiting > 0) && (m_State != 0)) {
                 // Make sure we aren't in the monitor thread waiting for close completion.
-                ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+                ASSERT(ResourceMonitor::Instance().IsMonitorThread(Core::Thread::ThreadId()) == false);
 
                 uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -711,7 +711,7 @@ namespace Core {
 #else
     if ((m_State & (SerialPort::OPEN | SerialPort::EXCEPTION | SerialPort::WRITESLOT)) == SerialPort::OPEN) {
         m_State |= SerialPort::WRITESLOT;
-        ResourceMonitor::Instance().Break();
+        ResourceMonitor::Instance().Break(*this);
     }
 #endif
 
@@ -766,7 +766,7 @@ void SerialPort::Write(const uint16_t writtenBytes)
 
     do {
         if (m_SendOffset == m_SendBytes) {
-            m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+            m_SendBytes = static_cast<uint16_t>(SendData(m_SendBuffer, m_SendBufferSize));
             m_SendOffset = 0;
         }
 
@@ -840,7 +840,7 @@ void SerialPort::Read(const uint16_t readBytes)
         }
 
         if (m_ReadBytes != 0) {
-            uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
+            uint16_t handledBytes = static_cast<uint16_t>(ReceiveData(m_ReceiveBuffer, m_ReadBytes));
 
             ASSERT(m_ReadBytes >= handledBytes);
 
@@ -866,7 +866,7 @@ void SerialPort::Read(const uint16_t readBytes)
 
             do {
                 if (m_SendOffset == m_SendBytes) {
-                    m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+                    m_SendBytes = static_cast<uint16_t>(SendData(m_SendBuffer, m_SendBufferSize));
                     m_SendOffset = 0;
                 }
 
@@ -917,7 +917,7 @@ void SerialPort::Read(const uint16_t readBytes)
                     m_ReadBytes += l_Size;
 
                     if (m_ReadBytes != 0) {
-                        uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
+                        uint16_t handledBytes = static_cast<uint16_t>(ReceiveData(m_ReceiveBuffer, m_ReadBytes));
 
                         ASSERT(m_ReadBytes >= handledBytes);
 
@@ -10,6 +10,7 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <net/if.h>
+#include <netinet/tcp.h>
 #define __ERRORRESULT__ errno
 #define __ERROR_AGAIN__ EAGAIN
 #define __ERROR_WOULDBLOCK__ EWOULDBLOCK
@@ -48,6 +49,50 @@ namespace Core {
 #define WATCHDOG_ENABLED
 #endif
 
+#ifdef __LINUX__
+    // The buffers and message headers recvmmsg fills, set up once for all reads.
+    struct SocketPort::BatchInfo {
+        BatchInfo() = delete;
+        BatchInfo(const BatchInfo&) = delete;
+        BatchInfo& operator=(const BatchInfo&) = delete;
+
+        BatchInfo(const uint8_t count, const uint32_t size)
+            : Count(count)
+            , Buffer(static_cast<uint8_t*>(::malloc(count * size)))
+            , Headers(count)
+            , Vectors(count)
+            , Addresses(count)
+            , Datagrams(count)
+        {
+            for (uint8_t index = 0; index < count; index++) {
+                Vectors[index].iov_base = &(Buffer[index * size]);
+                Vectors[index].iov_len = size;
+
+                ::memset(&(Headers[index]), 0, sizeof(struct mmsghdr));
+                Headers[index].msg_hdr.msg_iov = &(Vectors[index]);
+                Headers[index].msg_hdr.msg_iovlen = 1;
+                Headers[index].msg_hdr.msg_name = &(Addresses[index]);
+
+                Datagrams[index].Data = &(Buffer[index * size]);
+            }
+        }
+        ~BatchInfo()
+        {
+            ::free(Buffer);
+        }
+
+        const uint8_t Count;
+        uint8_t* Buffer;
+        std::vector<struct mmsghdr> Headers;
+        std::vector<struct iovec> Vectors;
+        std::vector<NodeId::SocketInfo> Addresses;
+        std::vector<Datagram> Datagrams;
+    };
+#else
+    struct SocketPort::BatchInfo {
+    };
+#endif
+
     //////////////////////////////////////////////////////////////////////
     // SocketPort::Initialization
     //////////////////////////////////////////////////////////////////////
@@ -169,8 +214,8 @@ namespace Core {
         const enumType socketType,
         const NodeId& refLocalNode,
         const NodeId& refremoteNode,
-        const uint16_t nSendBufferSize,
-        const uint16_t nReceiveBufferSize)
+        const uint32_t nSendBufferSize,
+        const uint32_t nReceiveBufferSize)
         : m_LocalNode(refLocalNode)
         , m_RemoteNode(refremoteNode)
         , m_ReceiveBufferSize(nReceiveBufferSize)
@@ -182,6 +227,7 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_Batch(nullptr)
     {
         TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
     }
@@ -190,8 +236,8 @@ namespace Core {
         const enumType socketType,
         const SOCKET& refConnector,
         const NodeId& remoteNode,
-        const uint16_t nSendBufferSize,
-        const uint16_t nReceiveBufferSize)
+        const uint32_t nSendBufferSize,
+        const uint32_t nReceiveBufferSize)
         : m_LocalNode(remoteNode.AnyInterface())
         , m_RemoteNode(remoteNode)
         , m_ReceiveBufferSize(nReceiveBufferSize)
@@ -203,6 +249,7 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_Batch(nullptr)
     {
         NodeId::SocketInfo localAddress;
         socklen_t localSize = sizeof(localAddress);
@@ -231,6 +278,8 @@ namespace Core {
         ASSERT(m_Socket == INVALID_SOCKET);
 
         ::free(m_SendBuffer);
+
+        delete m_Batch;
     }
 
     //////////////////////////////////////////////////////////////////////
@@ -386,6 +435,12 @@ namespace Core {
 
             if ((m_State != 0) && ((m_State & SHUTDOWN) == 0)) {
 
+                if (((m_State & (LINK | OPEN | EXCEPTION)) == (LINK | OPEN)) && (m_SendOffset != m_SendBytes)) {
+                    // The link is closed while gathering data to send, e.g. when the last message queued
+                    // reports it is done, do not drop what was already gathered.
+                    Transmit(0);
+                }
+
                 if ((m_State & (LINK | OPEN)) != (LINK | OPEN)) {
                     // This is a connectionless link, do not expect a close from the otherside.
                     // No use to wait on anything !!, Signal a FORCED CLOSURE (EXCEPTION && SHUTDOWN)
@@ -401,7 +456,7 @@ namespace Core {
 #endif
                 }
 
-                ResourceMonitor::Instance().Break();
+                ResourceMonitor::Instance().Break(*this);
             }
 
             if (waitTime > 0) {
@@ -413,7 +468,7 @@ namespace Core {
 
                     // We probably did not get a response from the otherside on the close
                     // sloppy but let's forcefully close it
-                    ResourceMonitor::Instance().Break();
+                    ResourceMonitor::Instance().Break(*this);
 
                     closed = (WaitForClosure(Core::infinite) == Core::ERROR_NONE);
 
@@ -434,11 +489,38 @@ namespace Core {
         if ((m_State & (SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) {
 
             m_State |= SocketPort::WRITESLOT;
-            ResourceMonitor::Instance().Break();
+            ResourceMonitor::Instance().Break(*this);
         }
         m_syncAdmin.Unlock();
     }
 
+    /* virtual */ void SocketPort::ReceiveBatch(const Datagram batch[], const uint8_t count)
+    {
+        for (uint8_t index = 0; index < count; index++) {
+            m_ReceivedNode = batch[index].Remote;
+
+            ReceiveData(batch[index].Data, batch[index].Length);
+        }
+    }
+
+    void SocketPort::Batch(const uint8_t count)
+    {
+        m_syncAdmin.Lock();
+
+        delete m_Batch;
+        m_Batch = nullptr;
+
+#ifdef __LINUX__
+        if ((count > 1) && (m_ReceiveBufferSize != 0)) {
+            m_Batch = new BatchInfo(count, m_ReceiveBufferSize);
+        }
+#else
+        TRACE_L1("Batched receive is not supported on this platform, receiving %d datagrams one by one.", count);
+#endif
+
+        m_syncAdmin.Unlock();
+    }
+
     //////////////////////////////////////////////////////////////////////
     // PRIVATE SocketPort interface
     //////////////////////////////////////////////////////////////////////
@@ -450,21 +532,26 @@ namespace Core {
         uint32_t receiveBuffer = m_ReceiveBufferSize;
         uint32_t sendBuffer = m_SendBufferSize;
 
-        if (m_ReceiveBufferSize == static_cast<uint16_t>(~0)) {
+        if (m_ReceiveBufferSize == static_cast<uint32_t>(~0)) {
             ::getsockopt(socket, SOL_SOCKET, SO_RCVBUF, (char*)&value, &valueLength);
 
             receiveBuffer = static_cast<uint32_t>(value);
 
+            // The buffers are allocated at the size the kernel uses, so that is what we read and write at most.
+            m_ReceiveBufferSize = receiveBuffer;
+
             TRACE_L1("Receive buffer size. %d", receiveBuffer);
         } else if ((receiveBuffer != 0) && (::setsockopt(socket, SOL_SOCKET, SO_RCVBUF, (const char*)&receiveBuffer, sizeof(receiveBuffer)) == SOCKET_ERROR)) {
             TRACE_L1("Error could not set Receive buffer size (%d).", receiveBuffer);
         }
 
-        if (m_SendBufferSize == static_cast<uint16_t>(~0)) {
+        if (m_SendBufferSize == static_cast<uint32_t>(~0)) {
             ::getsockopt(socket, SOL_SOCKET, SO_SNDBUF, (char*)&value, &valueLength);
 
             sendBuffer = static_cast<uint32_t>(value);
 
+            m_SendBufferSize = sendBuffer;
+
             TRACE_L1("Send buffer size. %d", sendBuffer);
         } else if ((sendBuffer != 0) && (::setsockopt(socket, SOL_SOCKET, SO_SNDBUF, (const char*)&sendBuffer, sizeof(sendBuffer)) == SOCKET_ERROR)) {
             TRACE_L1("Error could not set Send buffer size (%d).", sendBuffer);
@@ -600,7 +687,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsOpen() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsMonitorThread(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -635,7 +722,7 @@ namespace Core {
                 break;
             }
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsMonitorThread(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -664,7 +751,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsClosed() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsMonitorThread(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -784,6 +871,7 @@ namespace Core {
     void SocketPort::Write()
     {
         bool dataLeftToSend = true;
+        bool corked = false;
 
         m_syncAdmin.Lock();
 
@@ -793,50 +881,109 @@ namespace Core {
             if (m_SendOffset == m_SendBytes) {
                 m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
                 m_SendOffset = 0;
+
+                // A stream has no message boundaries. Gather whatever else is queued into the rest of
+                // the buffer, so several messages go to the kernel in a single call.
+                if (m_SocketType == SocketPort::STREAM) {
+                    uint32_t added = m_SendBytes;
+
+                    while ((added != 0) && (m_SendBytes < m_SendBufferSize)) {
+                        added = SendData(&(m_SendBuffer[m_SendBytes]), m_SendBufferSize - m_SendBytes);
+                        m_SendBytes += added;
+                    }
+                }
+
                 dataLeftToSend = (m_SendOffset != m_SendBytes);
 
                 ASSERT(m_SendBytes <= m_SendBufferSize);
             }
 
             if (dataLeftToSend == true) {
-                int32_t sendSize;
-
-                // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
-                // if the buffer free (SEND flag) is active, so the buffer should always fit.
-                if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
-                    ASSERT(m_RemoteNode.IsValid() == true);
-
-                    sendSize = ::sendto(m_Socket,
-                        reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
-                        m_SendBytes - m_SendOffset, 0,
-                        static_cast<const NodeId&>(m_RemoteNode),
-                        m_RemoteNode.Size());
+                int flags = 0;
 
-                } else {
-                    sendSize = ::send(m_Socket,
-                        reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
-                        m_SendBytes - m_SendOffset, 0);
+#ifdef __LINUX__
+                // If the buffer is full, more is likely to follow. Do not let the kernel push out a
+                // partial segment for the tail of it.
+                if ((m_SendBytes == m_SendBufferSize) && (IsTCP() == true) && (IsCorking() == true)) {
+                    flags = MSG_MORE;
                 }
+#endif
+                corked = (flags != 0);
 
-                if (sendSize >= 0) {
-                    m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
-                } else {
-                    uint32_t l_Result = __ERRORRESULT__;
-
-                    if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
-                        m_State |= SocketPort::WRITE;
-                    } else {
-                        printf("Write exception. %d\n", l_Result);
-                        m_State |= SocketPort::EXCEPTION;
-                        StateChange();
-                    }
-                }
+                Transmit(flags);
             }
         }
 
+#ifdef __LINUX__
+        if ((corked == true) && ((dataLeftToSend == false) || ((m_State & SocketPort::WRITE) != 0))) {
+            // Nothing followed the last full buffer, or the kernel buffer is full of what it holds back.
+            // Releasing the cork pushes out what is pending, by the rules (Nagle or not) the socket has.
+            int flag = 0;
+            ::setsockopt(m_Socket, IPPROTO_TCP, TCP_CORK, reinterpret_cast<const char*>(&flag), sizeof(flag));
+        }
+#endif
+
         m_syncAdmin.Unlock();
     }
 
+#ifdef __LINUX__
+    bool SocketPort::IsCorking()
+    {
+        // Holding back a partial segment only pays off if the kernel queues at least two full ones.
+        // With a smaller send buffer it fills up before a segment is complete, and the link waits
+        // for the delayed acknowledgement of the peer every time.
+        if ((m_State & SocketPort::CORKCHECKED) == 0) {
+            int sendBuffer = 0;
+            int segmentSize = 0;
+            socklen_t length = sizeof(int);
+
+            ::getsockopt(m_Socket, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<char*>(&sendBuffer), &length);
+            length = sizeof(int);
+            ::getsockopt(m_Socket, IPPROTO_TCP, TCP_MAXSEG, reinterpret_cast<char*>(&segmentSize), &length);
+
+            m_State |= (((segmentSize > 0) && (sendBuffer >= (2 * segmentSize))) ? (SocketPort::CORKCHECKED | SocketPort::CORKING) : SocketPort::CORKCHECKED);
+        }
+
+        return ((m_State & SocketPort::CORKING) != 0);
+    }
+#endif
+
+    void SocketPort::Transmit(const int flags)
+    {
+        int32_t sendSize;
+
+        // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
+        // if the buffer free (SEND flag) is active, so the buffer should always fit.
+        if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
+            ASSERT(m_RemoteNode.IsValid() == true);
+
+            sendSize = ::sendto(m_Socket,
+                reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
+                m_SendBytes - m_SendOffset, flags,
+                static_cast<const NodeId&>(m_RemoteNode),
+                m_RemoteNode.Size());
+
+        } else {
+            sendSize = ::send(m_Socket,
+                reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
+                m_SendBytes - m_SendOffset, flags);
+        }
+
+        if (sendSize >= 0) {
+            m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+        } else {
+            uint32_t l_Result = __ERRORRESULT__;
+
+            if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
+                m_State |= SocketPort::WRITE;
+            } else {
+                printf("Write exception. %d\n", l_Result);
+                m_State |= SocketPort::EXCEPTION;
+                StateChange();
+            }
+        }
+    }
+
     void SocketPort::Read()
     {
         m_syncAdmin.Lock();
@@ -846,6 +993,11 @@ namespace Core {
         while ((m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
             uint32_t l_Size;
 
+            if ((m_Batch != nullptr) && ((m_State & SocketPort::LINK) == 0)) {
+                ReadBatch();
+                continue;
+            }
+
             if (m_ReadBytes == m_ReceiveBufferSize) {
                 m_ReadBytes = 0;
             }
@@ -889,7 +1041,7 @@ namespace Core {
             }
 
             if (m_ReadBytes != 0) {
-                uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
+                uint32_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
 
                 ASSERT(m_ReadBytes >= handledBytes);
 
@@ -897,7 +1049,7 @@ namespace Core {
 
                 if ((m_ReadBytes != 0) && (handledBytes != 0)) {
                     // Oops not all data was consumed, Lets remove the read data
-                    ::memcpy(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
+                    ::memmove(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
                 }
             }
         }
@@ -905,6 +1057,41 @@ namespace Core {
         m_syncAdmin.Unlock();
     }
 
+    void SocketPort::ReadBatch()
+    {
+#ifdef __LINUX__
+        BatchInfo& batch(*m_Batch);
+
+        for (uint8_t index = 0; index < batch.Count; index++) {
+            batch.Headers[index].msg_hdr.msg_namelen = sizeof(NodeId::SocketInfo);
+        }
+
+        int received = ::recvmmsg(m_Socket, batch.Headers.data(), batch.Count, 0, nullptr);
+
+        if (received > 0) {
+            for (uint8_t index = 0; index < static_cast<uint8_t>(received); index++) {
+                batch.Datagrams[index].Length = static_cast<uint32_t>(batch.Headers[index].msg_len);
+
+                if (batch.Headers[index].msg_hdr.msg_namelen != 0) {
+                    batch.Datagrams[index].Remote = batch.Addresses[index];
+                }
+            }
+
+            ReceiveBatch(batch.Datagrams.data(), static_cast<uint8_t>(received));
+        } else {
+            uint32_t l_Result = __ERRORRESULT__;
+
+            if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__) || (l_Result == 0)) {
+                m_State |= SocketPort::READ;
+            } else {
+                m_State |= SocketPort::EXCEPTION;
+                StateChange();
+                printf("Read exception. %d\n", l_Result);
+            }
+        }
+#endif
+    }
+
     bool SocketPort::Closed()
     {
         bool result = true;
@@ -1121,8 +1308,8 @@ namespace Core {
     SocketDatagram::SocketDatagram(const bool rawSocket,
         const NodeId& localNode,
         const NodeId& remoteNode,
-        const uint16_t sendBufferSize,
-        const uint16_t receiveBufferSize)
+        const uint32_t sendBufferSize,
+        const uint32_t receiveBufferSize)
         : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::DATAGRAM), localNode, remoteNode, sendBufferSize, receiveBufferSize)
     {
     }
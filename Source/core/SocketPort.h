@@ -30,6 +30,8 @@ namespace WPEFramework {
 namespace Core {
     class EXTERNAL SocketPort : public IResource {
     private:
+        struct BatchInfo;
+
         // -------------------------------------------------------------------------
         // This object should not be copied, assigned or created with a default
         // constructor. Prevent them from being used, generatoed by the compiler.
@@ -49,6 +51,8 @@ namespace Core {
             LINK = 0x040,
             MONITOR = 0x080,
             WRITESLOT = 0x100,
+            CORKING = 0x200,
+            CORKCHECKED = 0x400,
             UPDATE = 0x8000
 
         } enumState;
@@ -66,14 +70,14 @@ namespace Core {
         SocketPort(const enumType socketType,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
 
         SocketPort(const enumType socketType,
             const SOCKET& connector,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
 
         virtual ~SocketPort();
 
@@ -154,11 +158,11 @@ namespace Core {
         {
             return (m_ReceivedNode);
         }
-        inline uint16_t SendBufferSize() const
+        inline uint32_t SendBufferSize() const
         {
             return (m_SendBufferSize);
         }
-        inline uint16_t ReceiveBufferSize() const
+        inline uint32_t ReceiveBufferSize() const
         {
             return (m_ReceiveBufferSize);
         }
@@ -189,12 +193,23 @@ namespace Core {
         void Trigger();
 
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
 
+        // A datagram, as received in a batch.
+        struct Datagram {
+            NodeId Remote;
+            uint8_t* Data;
+            uint32_t Length;
+        };
+
+        // All datagrams received with a single system call, see SocketDatagram::Batch. By default
+        // they are handed one by one to ReceiveData, with ReceivedNode() set to their sender.
+        virtual void ReceiveBatch(const Datagram batch[], const uint8_t count);
+
         // In case of a single connection should be accepted, these methods help
         // changing the socket from a Listening socket to a connected socket and
         // back in case the socket closes.
@@ -207,6 +222,8 @@ namespace Core {
     protected:
         virtual bool Initialize();
 
+        void Batch(const uint8_t count);
+
     private:
         virtual IResource::handle Descriptor() const override
         {
@@ -222,7 +239,16 @@ namespace Core {
         void Opened();
         void Accepted();
         void Read();
+        void ReadBatch();
         void Write();
+        void Transmit(const int flags);
+#ifdef __LINUX__
+        bool IsCorking();
+#endif
+        inline bool IsTCP() const
+        {
+            return ((m_SocketType == SocketPort::STREAM) && ((m_LocalNode.Type() == NodeId::TYPE_IPV4) || (m_LocalNode.Type() == NodeId::TYPE_IPV6)));
+        }
         void BufferAlignment(SOCKET socket);
         SOCKET ConstructSocket(NodeId& localNode, const string& interfaceName);
         uint32_t WaitForOpen(const uint32_t time) const;
@@ -232,8 +258,8 @@ namespace Core {
     private:
         NodeId m_LocalNode;
         NodeId m_RemoteNode;
-        uint16_t m_ReceiveBufferSize;
-        uint16_t m_SendBufferSize;
+        uint32_t m_ReceiveBufferSize;
+        uint32_t m_SendBufferSize;
         enumType m_SocketType;
         SOCKET m_Socket;
         mutable CriticalSection m_syncAdmin;
@@ -241,9 +267,10 @@ namespace Core {
         NodeId m_ReceivedNode;
         uint8_t* m_SendBuffer;
         uint8_t* m_ReceiveBuffer;
-        uint16_t m_ReadBytes;
-        uint16_t m_SendBytes;
-        uint16_t m_SendOffset;
+        uint32_t m_ReadBytes;
+        uint32_t m_SendBytes;
+        uint32_t m_SendOffset;
+        BatchInfo* m_Batch;
     };
 
     class EXTERNAL SocketStream : public SocketPort {
@@ -256,8 +283,8 @@ namespace Core {
         SocketStream(const bool rawSocket,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize)
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize)
             : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM), localNode, remoteNode, sendBufferSize, receiveBufferSize)
         {
         }
@@ -265,8 +292,8 @@ namespace Core {
         SocketStream(const bool rawSocket,
             const SOCKET& connector,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize)
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize)
             : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM),
                   connector, remoteNode, sendBufferSize, receiveBufferSize)
         {
@@ -278,8 +305,8 @@ namespace Core {
 
     public:
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
@@ -295,14 +322,21 @@ namespace Core {
         SocketDatagram(const bool rawSocket,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
         virtual ~SocketDatagram();
 
     public:
+        // Receive up to count datagrams with a single system call (recvmmsg), into buffers of the
+        // receive buffer size each. A count of 0 or 1 receives them one by one, which is the default.
+        inline void Batch(const uint8_t count)
+        {
+            SocketPort::Batch(count);
+        }
+
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
@@ -336,14 +370,14 @@ namespace Core {
             {
                 SocketPort::LocalNode(localNode);
             }
-            virtual uint16_t SendData(uint8_t* /* dataFrame */, const uint16_t /* maxSendSize */)
+            virtual uint32_t SendData(uint8_t* /* dataFrame */, const uint32_t /* maxSendSize */)
             {
                 // This should not happen on this socket !!!!!
                 ASSERT(false);
 
                 return (0);
             }
-            virtual uint16_t ReceiveData(uint8_t* /* dataFrame */, const uint16_t /* receivedSize */)
+            virtual uint32_t ReceiveData(uint8_t* /* dataFrame */, const uint32_t /* receivedSize */)
             {
                 // This should not happen on this socket !!!!!
                 ASSERT(false);
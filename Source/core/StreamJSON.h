@@ -169,12 +169,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -266,16 +266,18 @@ namespace Core {
         {
             return ((_serializer.IsIdle() == true) && (_deserializer.IsIdle() == true));
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            return (_serializer.Serialize(dataFrame, maxSendSize));
+            return (Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                return (_serializer.Serialize(&(dataFrame[offset]), size));
+            }));
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            uint16_t handled = 0;
+            uint32_t handled = 0;
 
             do {
-                handled += _deserializer.Deserialize(&dataFrame[handled], (receivedSize - handled));
+                handled += _deserializer.Deserialize(&dataFrame[handled], static_cast<uint16_t>(std::min(receivedSize - handled, static_cast<uint32_t>(0xFFFF))));
 
                 // The dataframe can hold more items....
             } while (handled < receivedSize);
@@ -212,12 +212,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -424,9 +424,9 @@ namespace Core {
         {
             return (_sendQueue.size() == 0);
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
@@ -453,7 +453,7 @@ namespace Core {
                 if ((maxSendSize != result) && (_offset >= (sendObject.size() * sizeof(TCHAR))) && (_offset < ((sendObject.size() + (_terminator.SizeOf())) * sizeof(TCHAR)))) {
                     uint8_t markerSize = (static_cast<uint8_t>(_terminator.SizeOf()) * sizeof(TCHAR));
                     uint8_t markerOffset = ((sendObject.size() * sizeof(TCHAR)) - _offset);
-                    uint16_t size = ((markerSize - markerOffset) > (maxSendSize - result) ? (maxSendSize - result) : (markerSize - markerOffset));
+                    uint32_t size = ((markerSize - markerOffset) > (maxSendSize - result) ? (maxSendSize - result) : (markerSize - markerOffset));
 
                     _offset += SendCharacters(&(dataFrame[result]), &(_terminator.Marker()[(markerOffset / sizeof(TCHAR))]), (markerOffset % sizeof(TCHAR)), size);
                     result += size;
@@ -480,9 +480,9 @@ namespace Core {
         {
             entry = (dataFrame[0]);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            for (uint16_t index = 0; index < receivedSize; index += sizeof(TCHAR)) {
+            for (uint32_t index = 0; index < receivedSize; index += sizeof(TCHAR)) {
                 TCHAR character;
                 Convert(&dataFrame[index], character);
 
@@ -514,7 +514,7 @@ namespace Core {
             }
             return (receivedSize);
         }
-        inline uint16_t SendCharacters(uint8_t* dataFrame, const TCHAR stream[], const uint8_t delta, const uint16_t total)
+        inline uint32_t SendCharacters(uint8_t* dataFrame, const TCHAR stream[], const uint8_t delta, const uint32_t total)
         {
             // TODO: Align in case we are not a multibyte character string..
             // For now we assume that this never happens, only multibyte support for now.
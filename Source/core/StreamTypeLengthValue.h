@@ -289,11 +289,11 @@ namespace Core {
             {
                 _parent.StateChange();
             }
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -481,14 +481,16 @@ namespace Core {
         }
 
         // Methods to extract and insert data into the socket buffers
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _responses.Lock();
 
             if ((_current != nullptr) && (_current != reinterpret_cast<typename DATAEXCHANGE::Request*>(~0))) {
-                result = _current->Serialize(dataFrame, maxSendSize);
+                result = Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                    return (_current->Serialize(&(dataFrame[offset]), size));
+                });
 
                 if (result == 0) {
                     Send(*_current);
@@ -501,17 +503,26 @@ namespace Core {
 
             return (result);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData)
         {
+            uint32_t offset = 0;
+
             _responses.Lock();
 
-            if (_buffer.Deserialize(dataFrame, availableData) == true) {
-                do {
-                    if (_responses.Evaluate(_buffer) == false) {
-                        Received(_buffer);
-                    }
-                } while (_buffer.Next() == true);
-            }
+            do {
+                const uint16_t size = static_cast<uint16_t>(std::min(availableData - offset, static_cast<uint32_t>(0xFFFF)));
+
+                if (_buffer.Deserialize(&(dataFrame[offset]), size) == true) {
+                    do {
+                        if (_responses.Evaluate(_buffer) == false) {
+                            Received(_buffer);
+                        }
+                    } while (_buffer.Next() == true);
+                }
+
+                offset += size;
+
+            } while (offset < availableData);
 
             _responses.Unlock();
 
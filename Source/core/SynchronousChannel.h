@@ -89,21 +89,25 @@ namespace Core {
             {
                 return (_response);
             }
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
-                uint16_t result = _message.Serialize(dataFrame, maxSendSize);
+                uint32_t result = Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                    return (_message.Serialize(&(dataFrame[offset]), size));
+                });
 
                 if (result < maxSendSize) {
                     _state = (_response == nullptr ? COMPLETE : INBOUND);
                 }
                 return (result);
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData)
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 if (_response != nullptr) {
-                    result = _response->Deserialize(dataFrame, availableData);
+                    result = Chunked(availableData, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                        return (_response->Deserialize(&(dataFrame[offset]), size));
+                    });
                     IInbound::state newState = _response->IsCompleted();
                     if (newState == IInbound::COMPLETED) {
                         _state = COMPLETE;
@@ -317,9 +321,9 @@ namespace Core {
         }
 
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
@@ -347,9 +351,9 @@ namespace Core {
 
             return (result);
         }
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData) override
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData) override
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
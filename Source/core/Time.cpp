@@ -712,19 +712,52 @@ namespace Core {
         return (systemTime);
     }
 
+    /* static */ uint64_t Time::Monotonic()
+    {
+        static const uint64_t frequency = []() -> uint64_t {
+            LARGE_INTEGER value;
+            ::QueryPerformanceFrequency(&value);
+            return (static_cast<uint64_t>(value.QuadPart));
+        }();
+        LARGE_INTEGER counter;
+
+        ::QueryPerformanceCounter(&counter);
+
+        return (((static_cast<uint64_t>(counter.QuadPart) / frequency) * MicroSecondsPerSecond) + (((static_cast<uint64_t>(counter.QuadPart) % frequency) * MicroSecondsPerSecond) / frequency));
+    }
+
 #endif
 
 #ifdef __POSIX__
     Time::Time(const struct timespec& time, bool localTime)
+        : _time()
+        , _ticks((static_cast<uint64_t>(time.tv_sec) * MicroSecondsPerSecond) + (time.tv_nsec / NanoSecondsPerMicroSecond) + OffsetTicksForEpoch)
+        , _state(PENDING)
+        , _localTime(localTime)
     {
-        if (localTime) {
-            localtime_r(&time.tv_sec, &_time);
+    }
+
+    void Time::Expand() const
+    {
+        uint8_t expected = PENDING;
+
+        if (_state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acquire) == true) {
+            // This is the seconds since 1970...
+            time_t epochTimestamp = static_cast<time_t>((_ticks - OffsetTicksForEpoch) / MicroSecondsPerSecond);
+
+            if (_localTime) {
+                localtime_r(&epochTimestamp, &_time);
+            } else {
+                gmtime_r(&epochTimestamp, &_time);
+            }
+
+            _state.store(EXPANDED, std::memory_order_release);
         } else {
-            gmtime_r(&time.tv_sec, &_time);
+            // Another thread is filling in the fields, it will not take long.
+            while (_state.load(std::memory_order_acquire) != EXPANDED) {
+                ::sched_yield();
+            }
         }
-
-        // Calculate ticks..
-        _ticks = (static_cast<uint64_t>(time.tv_sec) * MicroSecondsPerSecond) + (time.tv_nsec / NanoSecondsPerMicroSecond) + OffsetTicksForEpoch;
     }
 
     // GMT specific version of mktime(), taken from BSD source code
@@ -769,6 +802,10 @@ namespace Core {
     }
 
     Time::Time(const uint16_t year, const uint8_t month, const uint8_t day, const uint8_t hour, const uint8_t minute, const uint8_t second, const uint16_t millisecond, const bool localTime)
+        : _time()
+        , _ticks(0)
+        , _state(EXPANDED)
+        , _localTime(localTime)
     {
         struct tm source {
         };
@@ -797,25 +834,18 @@ namespace Core {
     }
 
     Time::Time(const struct timeval& info)
+        : _time()
+        , _ticks((static_cast<uint64_t>(info.tv_sec) * static_cast<uint64_t>(MicroSecondsPerSecond)) + static_cast<uint64_t>(info.tv_usec) + OffsetTicksForEpoch)
+        , _state(PENDING)
+        , _localTime(false)
     {
-        _ticks = (static_cast<uint64_t>(info.tv_sec) * static_cast<uint64_t>(MicroSecondsPerSecond)) + static_cast<uint64_t>(info.tv_usec) + OffsetTicksForEpoch;
-
-        // This is the seconds since 1970...
-        struct tm* ptm = gmtime(&info.tv_sec);
-
-        _time = *ptm;
     }
     Time::Time(const uint64_t time, const bool localTime /*= false*/)
         : _time()
         , _ticks(time)
+        , _state(PENDING)
+        , _localTime(localTime)
     {
-        // This is the seconds since 1970...
-        time_t epochTimestamp = static_cast<time_t>((time - OffsetTicksForEpoch) / MicroSecondsPerSecond);
-
-        if (localTime)
-            localtime_r(&epochTimestamp, &_time);
-        else
-            gmtime_r(&epochTimestamp, &_time);
     }
 
     uint64_t Time::Ticks() const
@@ -825,12 +855,12 @@ namespace Core {
 
     uint8_t Time::DayOfWeek() const
     {
-        return (static_cast<uint8_t>(_time.tm_wday));
+        return (static_cast<uint8_t>(Expanded().tm_wday));
     }
 
     uint16_t Time::DayOfYear() const
     {
-        return (static_cast<uint16_t>(_time.tm_yday));
+        return (static_cast<uint16_t>(Expanded().tm_yday));
     }
 
     string Time::ToRFC1123(const bool localTime) const
@@ -845,7 +875,7 @@ namespace Core {
         if (localTime != IsLocalTime()) {
             // We need to convert from local to GMT or vv
             time_t epochTimestamp;
-            struct tm originalTime = _time;
+            struct tm originalTime = Expanded();
             if (IsLocalTime())
                 epochTimestamp = mktime(&originalTime);
             else
@@ -874,7 +904,7 @@ namespace Core {
         if (localTime != IsLocalTime()) {
             // We need to convert from local to GMT or vv
             time_t epochTimestamp;
-            struct tm originalTime = _time;
+            struct tm originalTime = Expanded();
             if (IsLocalTime())
                 epochTimestamp = mktime(&originalTime);
             else
@@ -895,19 +925,27 @@ namespace Core {
     {
         TCHAR buffer[200];
 
-        _tcsftime(buffer, sizeof(buffer), formatter, &_time);
+        _tcsftime(buffer, sizeof(buffer), formatter, &(Expanded()));
 
         return (string(buffer));
     }
 
     /* static */ Time Time::Now()
     {
-        struct timeval currentTime;
-        gettimeofday(&currentTime, nullptr);
+        struct timespec currentTime;
+        clock_gettime(CLOCK_REALTIME, &currentTime);
 
         return (Time(currentTime));
     }
 
+    /* static */ uint64_t Time::Monotonic()
+    {
+        struct timespec currentTime;
+        clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+        return ((static_cast<uint64_t>(currentTime.tv_sec) * MicroSecondsPerSecond) + (currentTime.tv_nsec / NanoSecondsPerMicroSecond));
+    }
+
 #endif
 
     string Time::ToRFC1123() const
@@ -924,14 +962,23 @@ namespace Core {
     {
         // Calculate the new time !!
         uint64_t newTime = Ticks() + static_cast<uint64_t>(timeInMilliseconds) * MilliSecondsPerSecond;
+#ifdef __POSIX__
+        // Keep the ticks only, IsLocalTime() would fill in the calendar fields for nothing.
+        return (operator=(Time(newTime, _localTime)));
+#else
         return (operator=(Time(newTime, IsLocalTime())));
+#endif
     }
 
     Time& Time::Sub(const uint32_t timeInMilliseconds)
     {
         // Calculate the new time !!
         uint64_t newTime = Ticks() - static_cast<uint64_t>(timeInMilliseconds) * MilliSecondsPerSecond;
+#ifdef __POSIX__
+        return (operator=(Time(newTime, _localTime)));
+#else
         return (operator=(Time(newTime, IsLocalTime())));
+#endif
     }
 
     uint64_t Time::NTPTime() const
@@ -4,6 +4,8 @@
 #include "Portability.h"
 #include "TextFragment.h"
 
+#include <atomic>
+
 namespace WPEFramework {
 namespace Core {
     class EXTERNAL Time {
@@ -57,6 +59,8 @@ namespace Core {
         inline Time()
             : _time()
             , _ticks(0)
+            , _state(EXPANDED)
+            , _localTime(false)
         {
         }
         inline bool IsValid() const
@@ -65,33 +69,51 @@ namespace Core {
         }
         inline bool IsLocalTime() const
         {
-            if (_time.tm_zone == nullptr)
+            const struct tm& time(Expanded());
+            if (time.tm_zone == nullptr)
                 return false;
-            uint32_t value = (static_cast<uint8_t>(_time.tm_zone[0]) << 16) | (static_cast<uint8_t>(_time.tm_zone[1]) << 8) | (static_cast<uint8_t>(_time.tm_zone[2]) << 0);
+            uint32_t value = (static_cast<uint8_t>(time.tm_zone[0]) << 16) | (static_cast<uint8_t>(time.tm_zone[1]) << 8) | (static_cast<uint8_t>(time.tm_zone[2]) << 0);
             return (value != (('G' << 16) | ('M' << 8) | ('T'))) && (value != (('U' << 16) | ('T' << 8) | ('C')));
         }
 #endif
 
-        inline Time(const Time& copy)
-            : _time(copy._time)
 #ifndef __WINDOWS__
+        inline Time(const Time& copy)
+            : _time()
             , _ticks(copy._ticks)
+            , _state(PENDING)
+            , _localTime(copy._localTime)
+        {
+            if (copy._state.load(std::memory_order_acquire) == EXPANDED) {
+                _time = copy._time;
+                _state.store(EXPANDED, std::memory_order_relaxed);
+            }
+        }
 #else
+        inline Time(const Time& copy)
+            : _time(copy._time)
             , _isLocalTime(copy._isLocalTime)
-#endif
         {
         }
+#endif
         inline ~Time()
         {
         }
 
         inline Time& operator=(const Time& RHS)
         {
-            _time = RHS._time;
-
 #ifndef __WINDOWS__
+            // The fields of RHS are only copied if another thread is not filling them in.
+            if (RHS._state.load(std::memory_order_acquire) == EXPANDED) {
+                _time = RHS._time;
+                _state.store(EXPANDED, std::memory_order_relaxed);
+            } else {
+                _state.store(PENDING, std::memory_order_relaxed);
+            }
             _ticks = RHS._ticks;
+            _localTime = RHS._localTime;
 #else
+            _time = RHS._time;
             _isLocalTime = RHS._isLocalTime;
 #endif
             return (*this);
@@ -140,7 +162,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint8_t>(_time.wSecond));
 #else
-            return (static_cast<uint8_t>(_time.tm_sec));
+            return (static_cast<uint8_t>(Expanded().tm_sec));
 #endif
         }
         inline uint8_t Minutes() const
@@ -148,7 +170,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint8_t>(_time.wMinute));
 #else
-            return (static_cast<uint8_t>(_time.tm_min));
+            return (static_cast<uint8_t>(Expanded().tm_min));
 #endif
         }
         inline uint8_t Hours() const
@@ -156,7 +178,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint8_t>(_time.wHour));
 #else
-            return (static_cast<uint8_t>(_time.tm_hour));
+            return (static_cast<uint8_t>(Expanded().tm_hour));
 #endif
         }
         inline uint8_t Day() const
@@ -164,7 +186,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint8_t>(_time.wDay));
 #else
-            return (static_cast<uint8_t>(_time.tm_mday));
+            return (static_cast<uint8_t>(Expanded().tm_mday));
 #endif
         }
         inline uint8_t Month() const
@@ -172,7 +194,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint8_t>(_time.wMonth));
 #else
-            return (static_cast<uint8_t>(_time.tm_mon + 1));
+            return (static_cast<uint8_t>(Expanded().tm_mon + 1));
 #endif
         }
         inline uint32_t Year() const
@@ -180,7 +202,7 @@ namespace Core {
 #ifdef __WINDOWS__
             return (static_cast<uint32_t>(_time.wYear));
 #else
-            return (static_cast<uint32_t>(_time.tm_year + 1900));
+            return (static_cast<uint32_t>(Expanded().tm_year + 1900));
 #endif
         }
 
@@ -192,6 +214,10 @@ namespace Core {
 
         // Time in microseconds!
         uint64_t Ticks() const;
+
+        // Microseconds since an unspecified starting point. Unlike Ticks() this clock does not
+        // follow changes to the wall clock, use it to measure intervals.
+        static uint64_t Monotonic();
         bool FromRFC1123(const string& buffer);
         bool FromRFC1036(const string& buffer);
         bool FromANSI(const string& buffer, const bool localTime);
@@ -277,8 +303,28 @@ namespace Core {
 #else
         inline const struct tm& Handle() const
         {
+            return (Expanded());
+        }
+#endif
+
+    private:
+#ifdef __POSIX__
+        enum state : uint8_t {
+            EXPANDED,
+            PENDING,
+            EXPANDING
+        };
+
+        // Most users only need the ticks, the calendar fields are filled in on first access. A const
+        // Time can be shared between threads, so only one of them fills them in and publishes them.
+        inline const struct tm& Expanded() const
+        {
+            if (_state.load(std::memory_order_acquire) != EXPANDED) {
+                Expand();
+            }
             return (_time);
         }
+        void Expand() const;
 #endif
 
     private:
@@ -286,8 +332,10 @@ namespace Core {
         mutable SYSTEMTIME _time;
         bool _isLocalTime;
 #else
-        struct tm _time;
+        mutable struct tm _time;
         uint64_t _ticks;
+        mutable std::atomic<uint8_t> _state;
+        bool _localTime;
 #endif
     };
 }
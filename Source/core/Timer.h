@@ -8,6 +8,8 @@
 #include "Sync.h"
 #include "Thread.h"
 #include "Time.h"
+#include "TypeTraits.h"
+#include <type_traits>
 #include <utility>
 
 // ---- Referenced classes and types ----
@@ -27,84 +29,79 @@
 //
 namespace WPEFramework {
 namespace Core {
+    // -------------------------------------------------------------------
+    // The scheduled entries are kept in a hierarchical timing wheel (4 levels
+    // of 256 slots, 1 ms per slot on the lowest level, ~49 days in total).
+    // Scheduling an entry and revoking it through its Handle are O(1).
+    // Entries further away are cascaded to the lower levels as time passes.
+    // Entries that expire within the same millisecond, are handled in the
+    // order they were scheduled. An entry is never handled before its time.
+    // The wheel turns on the monotonic clock. The wall clock time an entry is
+    // scheduled for is translated once, when it is put on the wheel, so a step
+    // of the wall clock does not delay or advance the entries already on it.
+    // Revoking or triggering by content looks in a hash table of the entries.
+    // If the CONTENT offers a "uint32_t Hash() const", consistent with its
+    // operator==, that is O(1) as well, otherwise all entries are compared.
+    // -------------------------------------------------------------------
     template <typename CONTENT>
     class TimerType {
     private:
         TimerType(const TimerType&);
         TimerType& operator=(const TimerType&);
 
-    private:
-        template <typename ACTIVECONTENT>
-        class TimedInfo {
-        public:
-            inline TimedInfo()
-                : m_ScheduleTime(0)
-                , m_Info()
-            {
-            }
-
-            inline TimedInfo(const uint64_t time, const ACTIVECONTENT& contents)
-                : m_ScheduleTime(time)
-                , m_Info(contents)
-            {
-            }
-
-            inline TimedInfo(const uint64_t time, ACTIVECONTENT&& contents)
-                : m_ScheduleTime(time)
-                , m_Info(std::move(contents))
-            {
-            }
-
-            inline TimedInfo(const TimedInfo& copy)
-                : m_ScheduleTime(copy.m_ScheduleTime)
-                , m_Info(copy.m_Info)
+        static constexpr uint8_t Levels = 4;
+        static constexpr uint8_t SlotBits = 8;
+        static constexpr uint16_t Slots = (1 << SlotBits);
+        static constexpr uint64_t Span = (static_cast<uint64_t>(1) << (Levels * SlotBits)) - 1;
+        static constexpr uint32_t MinimumBuckets = 16;
+
+        struct Slot;
+
+        struct Entry {
+            Entry()
+                : Next(nullptr)
+                , Previous(nullptr)
+                , HashNext(nullptr)
+                , HashPrevious(nullptr)
+                , Owner(nullptr)
+                , ScheduleTime(0)
+                , Expires(0)
+                , Sequence(0)
+                , Hash(0)
             {
             }
 
-            inline TimedInfo(TimedInfo&& copy)
-                : m_ScheduleTime(copy.m_ScheduleTime)
-                , m_Info(std::move(copy.m_Info))
+            template <typename... Args>
+            inline void Construct(const uint64_t time, Args&&... args)
             {
+                ScheduleTime = time;
+                new (&Storage) CONTENT(std::forward<Args>(args)...);
             }
-
-            inline ~TimedInfo()
+            inline void Destruct()
             {
+                Content().~CONTENT();
+                Sequence++;
             }
-
-            inline TimedInfo& operator=(const TimedInfo& RHS)
-            {
-                m_ScheduleTime = RHS.m_ScheduleTime;
-                m_Info = RHS.m_Info;
-
-                return (*this);
-            }
-
-            inline TimedInfo& operator=(TimedInfo&& RHS)
-            {
-                m_ScheduleTime = RHS.m_ScheduleTime;
-                m_Info = std::move(RHS.m_Info);
-
-                return (*this);
-            }
-
-            inline uint64_t ScheduleTime() const
+            inline CONTENT& Content()
             {
-                return (m_ScheduleTime);
+                return (*reinterpret_cast<CONTENT*>(&Storage));
             }
 
-            inline void ScheduleTime(const uint64_t scheduleTime)
-            {
-                m_ScheduleTime = scheduleTime;
-            }
-
-            inline ACTIVECONTENT& Content()
-            {
-                return (m_Info);
-            }
+            Entry* Next;
+            Entry* Previous;
+            Entry* HashNext;
+            Entry* HashPrevious;
+            Slot* Owner;
+            uint64_t ScheduleTime;
+            uint64_t Expires;
+            uint32_t Sequence;
+            uint32_t Hash;
+            typename std::aligned_storage<sizeof(CONTENT), alignof(CONTENT)>::type Storage;
+        };
 
-        private:
-            uint64_t m_ScheduleTime;
-            ACTIVECONTENT m_Info;
+        struct Slot {
+            Entry* Head;
+            Entry* Tail;
         };
 
         class TimeWorker : public Thread {
@@ -131,15 +128,65 @@ namespace Core {
             TimerType<CONTENT>& m_Parent;
         };
 
-        typedef TimedInfo<CONTENT> TimeInfoBlocks;
-        typedef typename std::list<TimeInfoBlocks> SubscriberList;
+    public:
+        // Identifies a scheduled entry, so it can be revoked without searching for it.
+        class Handle {
+        public:
+            Handle()
+                : _entry(nullptr)
+                , _sequence(0)
+            {
+            }
+            Handle(const Handle& copy)
+                : _entry(copy._entry)
+                , _sequence(copy._sequence)
+            {
+            }
+            ~Handle()
+            {
+            }
+
+            Handle& operator=(const Handle& RHS)
+            {
+                _entry = RHS._entry;
+                _sequence = RHS._sequence;
+
+                return (*this);
+            }
+
+        public:
+            inline bool IsValid() const
+            {
+                return (_entry != nullptr);
+            }
+
+        private:
+            friend class TimerType<CONTENT>;
+
+            Handle(Entry* entry)
+                : _entry(entry)
+                , _sequence(entry->Sequence)
+            {
+            }
+
+            Entry* _entry;
+            uint32_t _sequence;
+        };
 
     public:
         TimerType(const uint32_t stackSize, const TCHAR* timerName)
-            : m_PendingQueue()
+            : m_Wheel()
+            , m_LevelCount()
+            , m_Due()
+            , m_Buckets(new Entry*[MinimumBuckets]())
+            , m_BucketCount(MinimumBuckets)
+            , m_Free(nullptr)
+            , m_Current(Time::Monotonic() / Time::TicksPerMillisecond)
+            , m_Count(0)
             , m_TimerThread(*this, stackSize, timerName)
             , m_Admin()
             , m_NextTrigger(NUMBER_MAX_UNSIGNED(uint64_t))
+            , m_NextTick(NUMBER_MAX_UNSIGNED(uint64_t))
         {
             // Everything is initialized, go...
             m_TimerThread.Block();
@@ -151,67 +198,84 @@ namespace Core {
             m_TimerThread.Stop();
 
             // Force kill on all pending stuff...
-            m_PendingQueue.clear();
+            Clear();
             m_Admin.Unlock();
 
             m_TimerThread.Wait(Thread::BLOCKED|Thread::STOPPED, Core::infinite);
-        }
 
-        inline void Schedule(const Time& time, CONTENT&& info)
-        {
-            Schedule(time.Ticks(), std::move(info));
+            // An entry that was being handled while stopping, might have been rescheduled.
+            Clear();
+
+            while (m_Free != nullptr) {
+                Entry* entry = m_Free;
+                m_Free = entry->Next;
+                delete entry;
+            }
+
+            delete[] m_Buckets;
         }
 
-        inline void Schedule(const Time& time, const CONTENT& info)
+        inline Handle Schedule(const Time& time, CONTENT&& info)
         {
-            Schedule(time.Ticks(), info);
+            return (Schedule(time.Ticks(), std::move(info)));
         }
 
-        inline void Schedule(const uint64_t& time, CONTENT&& info)
+        inline Handle Schedule(const Time& time, const CONTENT& info)
         {
-            Schedule(TimedInfo<CONTENT>(time, std::move(info)));
+            return (Schedule(time.Ticks(), info));
         }
 
-        inline void Schedule(const uint64_t& time, const CONTENT& info)
+        inline Handle Schedule(const uint64_t& time, CONTENT&& info)
         {
-            Schedule(std::move(TimedInfo<CONTENT>(time, info)));
+            m_Admin.Lock();
+
+            Entry* entry = Allocate();
+            entry->Construct(time, std::move(info));
+            Handle result(entry);
+            Add(entry);
+
+            m_Admin.Unlock();
+
+            return (result);
         }
 
-    private:
-        void Schedule(TimedInfo<CONTENT>&& timeInfo)
+        inline Handle Schedule(const uint64_t& time, const CONTENT& info)
         {
             m_Admin.Lock();
 
-            if (ScheduleEntry(std::move(timeInfo)) == true) {
-                m_TimerThread.Run();
-            }
+            Entry* entry = Allocate();
+            entry->Construct(time, info);
+            Handle result(entry);
+            Add(entry);
 
             m_Admin.Unlock();
-        }
 
-    public:
+            return (result);
+        }
 
-        void Trigger(const uint64_t& time, const CONTENT& info)
+        Handle Trigger(const uint64_t& time, const CONTENT& info)
         {
-            TimedInfo<CONTENT> newEntry(time, info);
-
             m_Admin.Lock();
 
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
+            Entry* index = m_Buckets[Bucket(HashOf(info))];
 
-            while ((index != m_PendingQueue.end()) && ((*index).Content() != info)) {
-                ++index;
+            while ((index != nullptr) && (index->Content() != info)) {
+                index = index->HashNext;
             }
 
-            if (index != m_PendingQueue.end()) {
-                m_PendingQueue.erase(index);
+            if (index != nullptr) {
+                Unlink(index);
+                Release(index);
             }
 
-            if (ScheduleEntry(std::move(newEntry)) == true) {
-                m_TimerThread.Run();
-            }
+            Entry* entry = Allocate();
+            entry->Construct(time, info);
+            Handle result(entry);
+            Add(entry);
 
             m_Admin.Unlock();
+
+            return (result);
         }
 
         bool Revoke(const CONTENT& info)
@@ -220,17 +284,38 @@ namespace Core {
 
             m_Admin.Lock();
 
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
-
             // Since we have the admin lock, we are pretty sure that there is not any
             // context running, so we can be pretty sure that if it was scheduled, it
             // is gone !!!
-            if (RemoveEntry(index, info) == true) {
+            Entry* index = m_Buckets[Bucket(HashOf(info))];
 
-                foundElement = true;
+            while (index != nullptr) {
+                Entry* entry = index;
+                index = index->HashNext;
 
-                // If we added the new time up front, retrigger the scheduler.
-                m_TimerThread.Run();
+                if (entry->Content() == info) {
+                    Unlink(entry);
+                    Release(entry);
+                    foundElement = true;
+                }
+            }
+
+            m_Admin.Unlock();
+
+            return (foundElement);
+        }
+
+        bool Revoke(const Handle& handle)
+        {
+            bool foundElement = false;
+
+            m_Admin.Lock();
+
+            // A handle to an entry that is being handled or already released, is ignored.
+            if ((handle._entry != nullptr) && (handle._entry->Sequence == handle._sequence) && (handle._entry->Owner != nullptr)) {
+                Unlink(handle._entry);
+                Release(handle._entry);
+                foundElement = true;
             }
 
             m_Admin.Unlock();
@@ -245,7 +330,7 @@ namespace Core {
 
         uint32_t Pending() const
         {
-            return (m_PendingQueue.size());
+            return (m_Count);
         }
 
         ::ThreadId ThreadId() const
@@ -265,41 +350,48 @@ namespace Core {
             // Ranging from 0-Core::infinite
             m_TimerThread.Block();
 
-            while ((m_PendingQueue.empty() == false) && (m_PendingQueue.front().ScheduleTime() <= now)) {
-                TimedInfo<CONTENT> info(std::move(m_PendingQueue.front()));
+            Advance(Time::Monotonic() / Time::TicksPerMillisecond);
+
+            while (m_Due.Head != nullptr) {
+                Entry* entry = m_Due.Head;
 
                 // Make sure we loose the current one before we do the call, that one might add ;-)
-                m_PendingQueue.pop_front();
+                Unlink(entry);
 
                 m_Admin.Unlock();
 
-                uint64_t reschedule = info.Content().Timed(info.ScheduleTime());
+                uint64_t reschedule = entry->Content().Timed(entry->ScheduleTime);
 
                 m_Admin.Lock();
 
                 if (reschedule != 0) {
                     ASSERT(reschedule > now);
 
-                    info.ScheduleTime(reschedule);
-                    ScheduleEntry(std::move(info));
+                    entry->ScheduleTime = reschedule;
+                    Link(entry);
+                } else {
+                    Release(entry);
                 }
             }
 
             // Calculate the delay...
-            if (m_PendingQueue.empty() == true) {
+            if (m_Count == 0) {
                 m_NextTrigger = NUMBER_MAX_UNSIGNED(uint64_t);
+                m_NextTick = NUMBER_MAX_UNSIGNED(uint64_t);
             } else {
                 // Refresh the time, just to be on the safe side...
-                uint64_t delta = Time::Now().Ticks();
+                uint64_t delta = Time::Monotonic();
+                uint64_t next = NextTick() * Time::TicksPerMillisecond;
 
-                if (delta >= m_PendingQueue.front().ScheduleTime()) {
-                    m_NextTrigger = delta;
+                m_NextTick = next / Time::TicksPerMillisecond;
+
+                if (delta >= next) {
+                    m_NextTrigger = Time::Now().Ticks();
                     delayTime = 0;
                 } else {
-                    // The windows counter is in 100ns intervals dus we mmoeten even delen door  1000 (us) * 10 ns = 10.000
-                    // om de waarde in ms te krijgen.
-                    m_NextTrigger = m_PendingQueue.front().ScheduleTime();
-                    delayTime = static_cast<uint32_t>((m_NextTrigger - delta) / Time::TicksPerMillisecond);
+                    // Round up, waking up before the slot is due, just costs another round.
+                    m_NextTrigger = Time::Now().Ticks() + (next - delta);
+                    delayTime = static_cast<uint32_t>((next - delta + Time::TicksPerMillisecond - 1) / Time::TicksPerMillisecond);
                 }
             }
 
@@ -309,52 +401,298 @@ namespace Core {
         }
 
     private:
-        bool ScheduleEntry(TimedInfo<CONTENT>&& infoBlock)
+        inline Entry* Allocate()
         {
-            bool reevaluate = false;
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
+            Entry* entry = m_Free;
 
-            while ((index != m_PendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
-                ++index;
+            if (entry == nullptr) {
+                entry = new Entry();
+            } else {
+                m_Free = entry->Next;
             }
 
-            if (index == m_PendingQueue.begin()) {
-                m_PendingQueue.push_front(std::move(infoBlock));
+            return (entry);
+        }
+        inline void Release(Entry* entry)
+        {
+            entry->Destruct();
+            entry->Next = m_Free;
+            m_Free = entry;
+        }
+        void Add(Entry* entry)
+        {
+            Link(entry);
 
-                // If we added the new time up front, retrigger the scheduler.
-                reevaluate = true;
-            } else if (index == m_PendingQueue.end()) {
-                m_PendingQueue.push_back(std::move(infoBlock));
+            // If the new entry is due before the next planned wakeup, retrigger the scheduler.
+            if (entry->Expires < m_NextTick) {
+                m_NextTick = entry->Expires;
+                m_NextTrigger = entry->ScheduleTime;
+                m_TimerThread.Run();
+            }
+        }
+        void Link(Entry* entry)
+        {
+            if ((TraitHash::value == true) && (m_Count >= (2 * m_BucketCount))) {
+                Rehash(2 * m_BucketCount);
+            }
+
+            entry->Hash = HashOf(entry->Content());
+            Hook(entry);
+            m_Count++;
+
+            entry->Expires = Expiry(entry->ScheduleTime);
+
+            Place(entry);
+        }
+        void Unlink(Entry* entry)
+        {
+            Remove(entry);
+
+            if (entry->HashPrevious != nullptr) {
+                entry->HashPrevious->HashNext = entry->HashNext;
             } else {
-                m_PendingQueue.insert(index, std::move(infoBlock));
+                m_Buckets[Bucket(entry->Hash)] = entry->HashNext;
+            }
+            if (entry->HashNext != nullptr) {
+                entry->HashNext->HashPrevious = entry->HashPrevious;
+            }
+            m_Count--;
+        }
+        inline uint32_t Bucket(const uint32_t hash) const
+        {
+            return (hash & (m_BucketCount - 1));
+        }
+        inline void Hook(Entry* entry)
+        {
+            Entry*& head(m_Buckets[Bucket(entry->Hash)]);
+
+            entry->HashPrevious = nullptr;
+            entry->HashNext = head;
+            if (head != nullptr) {
+                head->HashPrevious = entry;
+            }
+            head = entry;
+        }
+        void Rehash(const uint32_t buckets)
+        {
+            Entry** old = m_Buckets;
+            const uint32_t count = m_BucketCount;
+
+            m_Buckets = new Entry*[buckets]();
+            m_BucketCount = buckets;
+
+            for (uint32_t index = 0; index < count; index++) {
+                Entry* entry = old[index];
+
+                while (entry != nullptr) {
+                    Entry* next = entry->HashNext;
+                    Hook(entry);
+                    entry = next;
+                }
             }
 
-            return (reevaluate);
+            delete[] old;
         }
-        bool RemoveEntry(typename SubscriberList::iterator& index, const CONTENT& info)
+
+        // -----------------------------------------------------
+        // Check for a Hash method on the CONTENT, compile time
+        // -----------------------------------------------------
+        HAS_MEMBER(Hash, hasHash);
+
+        typedef hasHash<CONTENT, uint32_t (CONTENT::*)() const> TraitHash;
+
+        template <typename SUBJECT = CONTENT>
+        static inline typename Core::TypeTraits::enable_if<TimerType<SUBJECT>::TraitHash::value, uint32_t>::type
+        HashOf(const SUBJECT& content)
         {
-            bool changedHead = false;
+            return (content.Hash());
+        }
 
-            while (index != m_PendingQueue.end()) {
-                if (index->Content() == info) {
-                    changedHead = (index == m_PendingQueue.begin());
+        template <typename SUBJECT = CONTENT>
+        static inline typename Core::TypeTraits::enable_if<!TimerType<SUBJECT>::TraitHash::value, uint32_t>::type
+        HashOf(const SUBJECT&)
+        {
+            return (0);
+        }
+        // The (rounded up) tick of the monotonic clock on which the given wall clock time is due.
+        static uint64_t Expiry(const uint64_t scheduleTime)
+        {
+            const uint64_t wallClock = Time::Now().Ticks();
+            const uint64_t monotonic = Time::Monotonic() + (scheduleTime > wallClock ? (scheduleTime - wallClock) : 0);
 
-                    // Remove this... Found it, remove it.
-                    index = m_PendingQueue.erase(index);
+            return ((monotonic / Time::TicksPerMillisecond) + ((monotonic % Time::TicksPerMillisecond) != 0 ? 1 : 0));
+        }
+        // Put the entry in the slot that matches its expiry.
+        void Place(Entry* entry)
+        {
+            uint64_t expires = entry->Expires;
+
+            if (expires < m_Current) {
+                expires = m_Current;
+            } else if ((expires - m_Current) > Span) {
+                // Out of reach, park it on the top level, it is placed again once cascaded.
+                expires = m_Current + Span;
+            }
+
+            uint64_t delta = expires - m_Current;
+            uint8_t level = 0;
+
+            while ((level < (Levels - 1)) && (delta >= (static_cast<uint64_t>(1) << ((level + 1) * SlotBits)))) {
+                level++;
+            }
+
+            Append(m_Wheel[level][(expires >> (level * SlotBits)) & (Slots - 1)], entry);
+            m_LevelCount[level]++;
+        }
+        inline uint8_t Level(const Slot* slot) const
+        {
+            return (static_cast<uint8_t>((slot - &(m_Wheel[0][0])) / Slots));
+        }
+        inline void Append(Slot& slot, Entry* entry)
+        {
+            entry->Owner = &slot;
+            entry->Next = nullptr;
+            entry->Previous = slot.Tail;
+            if (slot.Tail != nullptr) {
+                slot.Tail->Next = entry;
+            } else {
+                slot.Head = entry;
+            }
+            slot.Tail = entry;
+        }
+        void Remove(Entry* entry)
+        {
+            Slot* slot = entry->Owner;
+
+            ASSERT(slot != nullptr);
+
+            if (entry->Previous != nullptr) {
+                entry->Previous->Next = entry->Next;
+            } else {
+                slot->Head = entry->Next;
+            }
+            if (entry->Next != nullptr) {
+                entry->Next->Previous = entry->Previous;
+            } else {
+                slot->Tail = entry->Previous;
+            }
+            if (slot != &m_Due) {
+                m_LevelCount[Level(slot)]--;
+            }
+
+            entry->Owner = nullptr;
+        }
+        void Cascade(const uint8_t level)
+        {
+            Slot& slot(m_Wheel[level][(m_Current >> (level * SlotBits)) & (Slots - 1)]);
+
+            while (slot.Head != nullptr) {
+                Entry* entry = slot.Head;
+                Remove(entry);
+                Place(entry);
+            }
+        }
+        // Walk the wheel up to (and including) the given tick, collecting everything that expired.
+        void Advance(const uint64_t target)
+        {
+            while (m_Current <= target) {
+                uint8_t level = 0;
+
+                while ((level < Levels) && (m_LevelCount[level] == 0)) {
+                    level++;
+                }
+
+                if (level == Levels) {
+                    // Nothing on the wheel, nothing to cascade.
+                    m_Current = target + 1;
+                } else if (level > 0) {
+                    // The lower levels are empty, skip to the next tick that cascades this level.
+                    const uint64_t mask = (static_cast<uint64_t>(1) << (level * SlotBits)) - 1;
+                    const uint64_t boundary = (m_Current + mask) & (~mask);
+
+                    if (boundary > target) {
+                        m_Current = target + 1;
+                    } else {
+                        m_Current = boundary;
+                        Tick();
+                    }
                 } else {
+                    Tick();
+                }
+            }
+        }
+        void Tick()
+        {
+            uint8_t level = 1;
 
-                    ++index;
+            while ((level < Levels) && ((m_Current & ((static_cast<uint64_t>(1) << (level * SlotBits)) - 1)) == 0)) {
+                Cascade(level);
+                level++;
+            }
+
+            Slot& slot(m_Wheel[0][m_Current & (Slots - 1)]);
+
+            while (slot.Head != nullptr) {
+                Entry* entry = slot.Head;
+                Remove(entry);
+                Append(m_Due, entry);
+            }
+
+            m_Current++;
+        }
+        // The tick on which the wheel has to be evaluated again (expiry or cascade).
+        uint64_t NextTick() const
+        {
+            uint64_t result = NUMBER_MAX_UNSIGNED(uint64_t);
+
+            for (uint8_t level = 0; level < Levels; level++) {
+                if (m_LevelCount[level] != 0) {
+                    const uint8_t shift = level * SlotBits;
+                    // On the higher levels, the current slot is already cascaded, unless we are on its boundary.
+                    const uint8_t skip = ((level == 0) || ((m_Current & ((static_cast<uint64_t>(1) << shift) - 1)) == 0) ? 0 : 1);
+                    const uint64_t base = (m_Current >> shift);
+                    uint16_t offset = skip;
+
+                    while ((offset < (Slots + skip)) && (m_Wheel[level][(base + offset) & (Slots - 1)].Head == nullptr)) {
+                        offset++;
+                    }
+
+                    if (offset < (Slots + skip)) {
+                        const uint64_t tick = ((base + offset) << shift);
+
+                        if (tick < result) {
+                            result = tick;
+                        }
+                    }
                 }
             }
 
-            return (changedHead);
+            return (result < m_Current ? m_Current : result);
+        }
+        void Clear()
+        {
+            for (uint32_t index = 0; index < m_BucketCount; index++) {
+                while (m_Buckets[index] != nullptr) {
+                    Entry* entry = m_Buckets[index];
+                    Unlink(entry);
+                    Release(entry);
+                }
+            }
         }
 
     private:
-        SubscriberList m_PendingQueue;
+        Slot m_Wheel[Levels][Slots];
+        uint32_t m_LevelCount[Levels];
+        Slot m_Due;
+        Entry** m_Buckets;
+        uint32_t m_BucketCount;
+        Entry* m_Free;
+        uint64_t m_Current;
+        uint32_t m_Count;
         TimeWorker m_TimerThread;
         CriticalSection m_Admin;
         uint64_t m_NextTrigger;
+        uint64_t m_NextTick;
     };
 
     template <typename HANDLER>
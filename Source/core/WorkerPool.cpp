@@ -6,8 +6,10 @@ namespace WPEFramework {
 
 	    /* static */ WorkerPool* WorkerPool::_instance = nullptr;
 
-		WorkerPool::WorkerPool(const uint8_t threadCount, uint32_t* counters)
+		WorkerPool::WorkerPool(const uint8_t threadCount, uint32_t* counters, uint32_t* steals, const bool workStealing)
 			: _handleQueue(16)
+			, _locals(workStealing == true ? new LocalQueue[threadCount] : nullptr)
+			, _idle(0)
 			, _occupation(0)
 			, _timer(1024 * 1024, _T("WorkerPool::Timer"))
 		{
@@ -15,13 +17,94 @@ namespace WPEFramework {
 
 			_metadata.Slots = threadCount;
 			_metadata.Slot = counters;
+			_metadata.Steals = steals;
 			_instance = this;
+
+			::memset(counters, 0, threadCount * sizeof(uint32_t));
+			::memset(steals, 0, threadCount * sizeof(uint32_t));
 		}
 
 		WorkerPool ::~WorkerPool()
 		{
 			_handleQueue.Disable();
+
+			if (_locals != nullptr) {
+				delete[] _locals;
+			}
+
 			_instance = nullptr;
 		}
+
+		WorkerPool::LocalQueue* WorkerPool::Local()
+		{
+			LocalQueue* result = nullptr;
+
+			if (_locals != nullptr) {
+				const ::ThreadId current = Core::Thread::ThreadId();
+				uint8_t index = 0;
+
+				while ((index < _metadata.Slots) && (_locals[index].Owner() != current)) {
+					index++;
+				}
+
+				if (index < _metadata.Slots) {
+					result = &(_locals[index]);
+				}
+			}
+
+			return (result);
+		}
+
+		// Look if one of the others has more than it can handle.
+		bool WorkerPool::Steal(const uint8_t index, Job& job)
+		{
+			bool found = false;
+
+			for (uint8_t offset = 1; (found == false) && (offset < _metadata.Slots); offset++) {
+				if (_locals[(index + offset) % _metadata.Slots].Steal(job) == true) {
+					_metadata.Steals[index]++;
+					found = true;
+				}
+			}
+
+			return (found);
+		}
+
+		bool WorkerPool::Next(const uint8_t index, Job& job)
+		{
+			// An empty job on the shared queue is only there to wake up an idle thread.
+			bool found = (_locals[index].Pop(job) == true) || ((_handleQueue.Extract(job, 0) == true) && (job.IsValid() == true)) || (Steal(index, job) == true);
+
+			if (found == false) {
+				// From now on, new jobs go to the global queue, so we get them there. A job
+				// pushed to a local queue before the submitter saw us idle is found by scanning
+				// once more, one pushed later comes with an empty job to wake us up.
+				// Only a Disable() will make us return without a job.
+				_idle++;
+
+				found = Steal(index, job);
+
+				while ((found == false) && (_handleQueue.Extract(job, Core::infinite) == true)) {
+					found = (job.IsValid() == true) || (Steal(index, job) == true);
+				}
+
+				_idle--;
+			}
+
+			return (found);
+		}
+
+		bool WorkerPool::RemoveLocal(const Job& job)
+		{
+			bool removed = false;
+
+			if (_locals != nullptr) {
+				for (uint8_t index = 0; (removed == false) && (index < _metadata.Slots); index++) {
+					removed = _locals[index].Remove(job);
+				}
+			}
+
+			return (removed);
+		}
 	}
 }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "LockFreeQueue.h"
 #include "Thread.h"
 #include "Timer.h"
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <functional>
 
 namespace WPEFramework {
@@ -44,10 +47,21 @@ namespace Core {
             {
                 return (_job == RHS._job);
             }
+            inline bool IsValid() const
+            {
+                return (_job.IsValid());
+            }
             bool operator!=(const Job& RHS) const
             {
                 return (!operator==(RHS));
             }
+            // Equal jobs point to the same object, so its address identifies them on the timer.
+            uint32_t Hash() const
+            {
+                const uintptr_t address = (_job.IsValid() == true ? reinterpret_cast<uintptr_t>(_job.operator->()) : 0);
+
+                return (static_cast<uint32_t>((address >> 4) ^ (static_cast<uint64_t>(address) >> 32)));
+            }
             uint64_t Timed(const uint64_t /* scheduledTime */)
             {
                WorkerPool::Instance().Submit(_job);
@@ -155,7 +169,98 @@ namespace Core {
             uint8_t _index;
         };
 
-        typedef Core::QueueType<Job> MessageQueue;
+        // In the work stealing mode, each slot owns a deque. Jobs submitted from a pool
+        // thread are pushed on (and popped from) the back of its own deque, idle threads
+        // steal from the front of the deques of the others.
+        class LocalQueue {
+        private:
+            LocalQueue(const LocalQueue&) = delete;
+            LocalQueue& operator=(const LocalQueue&) = delete;
+
+        public:
+            LocalQueue()
+                : _lock()
+                , _jobs()
+                , _owner(0)
+            {
+            }
+            ~LocalQueue()
+            {
+            }
+
+        public:
+            inline ::ThreadId Owner() const
+            {
+                return (_owner);
+            }
+            inline void Owner(const ::ThreadId owner)
+            {
+                _owner = owner;
+            }
+            void Push(const Job& job)
+            {
+                _lock.Lock();
+                _jobs.push_back(job);
+                _lock.Unlock();
+            }
+            bool Pop(Job& job)
+            {
+                bool result = false;
+
+                _lock.Lock();
+                if (_jobs.empty() == false) {
+                    job = _jobs.back();
+                    _jobs.pop_back();
+                    result = true;
+                }
+                _lock.Unlock();
+
+                return (result);
+            }
+            bool Steal(Job& job)
+            {
+                bool result = false;
+
+                _lock.Lock();
+                if (_jobs.empty() == false) {
+                    job = _jobs.front();
+                    _jobs.pop_front();
+                    result = true;
+                }
+                _lock.Unlock();
+
+                return (result);
+            }
+            bool Remove(const Job& job)
+            {
+                bool result = false;
+
+                _lock.Lock();
+                std::deque<Job>::iterator index(std::find(_jobs.begin(), _jobs.end(), job));
+                if (index != _jobs.end()) {
+                    _jobs.erase(index);
+                    result = true;
+                }
+                _lock.Unlock();
+
+                return (result);
+            }
+            uint32_t Length() const
+            {
+                _lock.Lock();
+                uint32_t result = static_cast<uint32_t>(_jobs.size());
+                _lock.Unlock();
+
+                return (result);
+            }
+
+        private:
+            mutable Core::CriticalSection _lock;
+            std::deque<Job> _jobs;
+            ::ThreadId _owner;
+        };
+
+        typedef Core::LockFreeQueueType<Job> MessageQueue;
 
     public:
         struct Metadata {
@@ -163,6 +268,7 @@ namespace Core {
             uint32_t Occupation;
             uint8_t Slots;
             uint32_t* Slot;
+            uint32_t* Steals;
         };
 
     public:
@@ -178,7 +284,22 @@ namespace Core {
     public:
         inline void Submit(const Core::ProxyType<Core::IDispatch>& job)
         {
-            _handleQueue.Insert(Job(job), Core::infinite);
+            // Keep jobs submitted by a pool thread local, unless a thread is waiting for work.
+            LocalQueue* local = (_idle.load(std::memory_order_relaxed) == 0 ? Local() : nullptr);
+
+            if (local != nullptr) {
+                local->Push(Job(job));
+
+                // A thread might have gone idle after we looked. If it did not see the job in
+                // its last scan, an empty job wakes it up to scan again.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (_idle.load() != 0) {
+                    _handleQueue.Insert(Job(), Core::infinite);
+                }
+            } else {
+                _handleQueue.Insert(Job(job), Core::infinite);
+            }
         }
         inline void Schedule(const Core::Time& time, const Core::ProxyType<Core::IDispatch>& job)
         {
@@ -187,14 +308,23 @@ namespace Core {
         inline uint32_t Revoke(const Core::ProxyType<Core::IDispatch>& job, const uint32_t waitTime = Core::infinite)
         {
             Job compare(job);
-            return (_timer.Revoke(compare) == true || _handleQueue.Remove(compare) ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+            return (_timer.Revoke(compare) == true || _handleQueue.Remove(compare) || RemoveLocal(compare) ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
         }
         inline const WorkerPool::Metadata& Snapshot()
         {
             _metadata.Occupation = _occupation.load();
             _metadata.Pending = _handleQueue.Length();
+            if (_locals != nullptr) {
+                for (uint8_t index = 0; index < _metadata.Slots; index++) {
+                    _metadata.Pending += _locals[index].Length();
+                }
+            }
             return (_metadata);
         }
+        inline bool IsWorkStealing() const
+        {
+            return (_locals != nullptr);
+        }
 	void Join() {
             Process(0);
 	}
@@ -234,7 +364,7 @@ namespace Core {
         }
 
     protected:
-        WorkerPool(const uint8_t threadCount, uint32_t* counters);
+        WorkerPool(const uint8_t threadCount, uint32_t* counters, uint32_t* steals, const bool workStealing);
 
         virtual Minion& Index(const uint8_t index) = 0;
         virtual bool Running() = 0;
@@ -243,7 +373,11 @@ namespace Core {
         {
             Job newRequest;
 
-            while ((Running() == true) && (_handleQueue.Extract(newRequest, Core::infinite) == true)) {
+            if (_locals != nullptr) {
+                _locals[index].Owner(Core::Thread::ThreadId());
+            }
+
+            while ((Running() == true) && ((_locals == nullptr) ? (_handleQueue.Extract(newRequest, Core::infinite) == true) : (Next(index, newRequest) == true))) {
 
                 _metadata.Slot[index]++;
 
@@ -253,10 +387,22 @@ namespace Core {
 
                 _occupation--;
             }
+
+            if (_locals != nullptr) {
+                _locals[index].Owner(0);
+            }
         }
 
+    private:
+        LocalQueue* Local();
+        bool Steal(const uint8_t index, Job& job);
+        bool Next(const uint8_t index, Job& job);
+        bool RemoveLocal(const Job& job);
+
     private:
         MessageQueue _handleQueue;
+        LocalQueue* _locals;
+        std::atomic<uint8_t> _idle;
         std::atomic<uint8_t> _occupation;
         Core::TimerType<Job> _timer;
         Metadata _metadata;
@@ -271,8 +417,8 @@ namespace Core {
         WorkerPoolType<THREAD_COUNT>& operator=(const WorkerPoolType<THREAD_COUNT>&) = delete;
 
     public:
-        WorkerPoolType(const uint32_t stackSize)
-            : WorkerPool(THREAD_COUNT, &(_counters[0]))
+        WorkerPoolType(const uint32_t stackSize, const bool workStealing = false)
+            : WorkerPool(THREAD_COUNT, &(_counters[0]), &(_steals[0]), workStealing)
             , _minions()
         {
         }
@@ -299,6 +445,7 @@ namespace Core {
     private:
         Minion _minions[THREAD_COUNT - 1];
         uint32_t _counters[THREAD_COUNT];
+        uint32_t _steals[THREAD_COUNT];
     };
 }
 }
@@ -39,6 +39,7 @@
 #include "KeyValue.h"
 #include "Library.h"
 #include "Link.h"
+#include "LockFreeQueue.h"
 #include "LockableContainer.h"
 #include "Measurement.h"
 #include "Media.h"
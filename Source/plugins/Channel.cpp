@@ -1,10 +1,21 @@
 #include "Channel.h"
+#include "Service.h"
 
 namespace WPEFramework {
+
+ENUM_CONVERSION_BEGIN(PluginHost::Channel::EventPolicy)
+
+    { PluginHost::Channel::DROP, _TXT("drop") },
+    { PluginHost::Channel::COALESCE, _TXT("coalesce") },
+
+    ENUM_CONVERSION_END(PluginHost::Channel::EventPolicy)
+
 namespace PluginHost {
 
     /* static */ RequestPool Channel::_requestAllocator(10);
 
+    /* static */ constexpr uint32_t Channel::Batch::MaxCalls;
+
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
@@ -19,6 +30,18 @@ namespace PluginHost {
         , _text()
         , _offset(0)
         , _sendQueue()
+        , _sending(false)
+        , _congested(false)
+        , _policy(COALESCE)
+        , _highWatermark(0)
+        , _lowWatermark(0)
+        , _queuedBytes(0)
+        , _dropped(0)
+        , _coalesced(0)
+        , _sent(0)
+        , _latency(0)
+        , _pipeline()
+        , _responding(false)
     {
     }
 #ifdef __WINDOWS__
@@ -29,5 +52,151 @@ namespace PluginHost {
     {
         Close(0);
     }
+
+    void Channel::Respond(const Core::ProxyType<Web::Request>& request, const Core::ProxyType<Web::Response>& response)
+    {
+        _adminLock.Lock();
+
+        std::list<Pipelined>::iterator index(_pipeline.begin());
+
+        while ((index != _pipeline.end()) && ((index->Request != request) || (index->Response.IsValid() == true))) {
+            index++;
+        }
+
+        // If the channel was closed in the mean time, the request is gone and so is the need to respond.
+        if (index != _pipeline.end()) {
+            index->Response = response;
+        }
+
+        // Submitting takes the lock of the link, which sends with that lock held and then takes ours, so
+        // submit without holding our lock. Only one thread at a time submits, to keep the order.
+        if (_responding == false) {
+            std::list<Core::ProxyType<Web::Response>> ready;
+
+            _responding = true;
+
+            do {
+                ready.clear();
+
+                index = _pipeline.begin();
+
+                while ((index != _pipeline.end()) && (index->Response.IsValid() == true)) {
+                    if (index->Submitted == false) {
+                        index->Submitted = true;
+                        ready.push_back(index->Response);
+                    }
+                    index++;
+                }
+
+                _adminLock.Unlock();
+
+                for (const Core::ProxyType<Web::Response>& entry : ready) {
+                    BaseClass::Submit(entry);
+                }
+
+                _adminLock.Lock();
+
+            } while (ready.empty() == false);
+
+            _responding = false;
+        }
+
+        _adminLock.Unlock();
+    }
+
+    Channel::Batch::Batch()
+        : _responses()
+        , _pending(0)
+    {
+    }
+
+    /* virtual */ Channel::Batch::~Batch()
+    {
+    }
+
+    void Channel::Batch::Execute(const Core::JSONRPC::Batch& batch)
+    {
+        Core::JSON::ArrayType<Core::JSON::String>::ConstIterator entry(batch.Calls.Elements());
+        uint32_t calls = 0;
+
+        // Length() is 16 bits wide, count the calls ourselves, but not beyond what we would accept.
+        while ((calls <= MaxCalls) && (entry.Next() == true)) {
+            calls++;
+        }
+
+        if (calls == 0) {
+            Refuse(Core::ERROR_INVALID_DESIGNATOR, _T("Invalid Request"));
+        } else if (calls > MaxCalls) {
+            Refuse(Core::ERROR_INVALID_INPUT_LENGTH, _T("Batch holds more than ") + Core::NumberType<uint32_t>(MaxCalls).Text() + _T(" calls"));
+        } else {
+            uint32_t index = 0;
+
+            entry.Reset();
+
+            _responses.resize(calls);
+            _pending = calls;
+
+            while ((entry.Next() == true) && (index < calls)) {
+                Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>> call(Factories::Instance().JSONRPC());
+
+                call->Clear();
+
+                if ((call->FromString(entry.Current().Value()) == false) || (call->IsBatch() == true) || (call->Designator.IsSet() == false)) {
+                    call->Designator.Clear();
+                    call->Parameters.Clear();
+                    call->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                    call->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
+                    call->Error.Text = _T("Invalid Request");
+                    Completed(index, Core::ProxyType<Core::JSONRPC::Message>(call));
+                } else {
+                    Call(index, call);
+                }
+
+                index++;
+            }
+        }
+    }
+
+    void Channel::Batch::Completed(const uint32_t index, const Core::ProxyType<Core::JSONRPC::Message>& response)
+    {
+        ASSERT(index < _responses.size());
+
+        // Every call owns its own slot, no need to lock.
+        _responses[index] = response;
+
+        if (Core::InterlockedDecrement(_pending) == 0) {
+            Send();
+        }
+    }
+
+    void Channel::Batch::Refuse(const uint32_t code, const string& text)
+    {
+        // A batch that is refused is answered with a single message, not with an array.
+        Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>> body(Factories::Instance().JSONRPC());
+
+        body->Clear();
+        body->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        body->Error.SetError(code);
+        body->Error.Text = text;
+
+        Reply(body);
+    }
+
+    void Channel::Batch::Send()
+    {
+        Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>> body(Factories::Instance().JSONRPC());
+
+        body->Clear();
+
+        for (const Core::ProxyType<Core::JSONRPC::Message>& response : _responses) {
+            if (response.IsValid() == true) {
+                body->Add(*response);
+            }
+        }
+
+        _responses.clear();
+
+        Reply(body);
+    }
 }
 }
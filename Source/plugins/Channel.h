@@ -11,6 +11,134 @@ namespace PluginHost {
     private:
         typedef Web::WebSocketLinkType<Core::SocketStream, Request, Web::Response, RequestPool&> BaseClass;
 
+    public:
+        // A notification that goes out to more than one channel is serialized once, into this immutable
+        // text. Serializing it does not change its state, so all channels can send it out from the same
+        // instance, each at its own pace.
+        class EXTERNAL Notification : public Core::JSON::IElement {
+        public:
+            Notification() = delete;
+            Notification(const Notification&) = delete;
+            Notification& operator=(const Notification&) = delete;
+
+            Notification(const string& designator, const string& text)
+                : _designator(designator)
+                , _text(text)
+            {
+                ASSERT(_text.length() < 0xFFFF);
+            }
+            ~Notification() override
+            {
+            }
+
+        public:
+            const string& Designator() const
+            {
+                return (_designator);
+            }
+            uint32_t Length() const
+            {
+                return (static_cast<uint32_t>(_text.length()));
+            }
+
+            void Clear() override
+            {
+                ASSERT(false);
+            }
+            bool IsSet() const override
+            {
+                return (true);
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            {
+                uint16_t result = static_cast<uint16_t>(_text.copy(stream, maxLength, offset));
+
+                offset += result;
+
+                if (offset >= _text.length()) {
+                    offset = 0;
+                }
+
+                return (result);
+            }
+            uint16_t Deserialize(const char[], const uint16_t, uint16_t&, Core::OptionalType<Core::JSON::Error>&) override
+            {
+                ASSERT(false);
+                return (0);
+            }
+
+        private:
+            const string _designator;
+            const string _text;
+        };
+
+        // Splits a JSON-RPC batch in to its calls and collects their responses. Each valid call is handed
+        // to Call(), which may complete it on any thread, whichever call completes last answers the batch
+        // as a whole. An empty batch, or one with more than MaxCalls calls, is answered with a single error
+        // without executing any of its calls.
+        class EXTERNAL Batch {
+        public:
+            static constexpr uint32_t MaxCalls = 256;
+
+        public:
+            Batch(const Batch&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            Batch();
+            virtual ~Batch();
+
+        public:
+            void Execute(const Core::JSONRPC::Batch& batch);
+
+            // Notifications are not answered, they complete with an invalid response.
+            void Completed(const uint32_t index, const Core::ProxyType<Core::JSONRPC::Message>& response);
+
+        protected:
+            // Every call handed out must be completed, exactly once.
+            virtual void Call(const uint32_t index, const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& call) = 0;
+
+            // Called once per batch, with a body that is not set if all calls were notifications.
+            virtual void Reply(const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& body) = 0;
+
+        private:
+            void Refuse(const uint32_t code, const string& text);
+            void Send();
+
+        private:
+            std::vector<Core::ProxyType<Core::JSONRPC::Message>> _responses;
+            volatile uint32_t _pending;
+        };
+
+        // What to do with events offered to a channel that has more queued than its high watermark,
+        // until it drained below its low watermark again. Responses are always queued.
+        enum EventPolicy {
+            DROP,
+            COALESCE
+        };
+
+    private:
+        // HTTP allows a client to send its next request before the previous one is answered, but the
+        // responses must go out in the order of the requests, regardless of which completes first.
+        struct Pipelined {
+            Pipelined(const Core::ProxyType<Web::Request>& request)
+                : Request(request)
+                , Response()
+                , Submitted(false)
+            {
+            }
+
+            Core::ProxyType<Web::Request> Request;
+            Core::ProxyType<Web::Response> Response;
+            bool Submitted;
+        };
+
+        // Everything that is waiting to be sent out. Responses are sent before events, events that are
+        // queued for the same designator can be coalesced. The shared notifications are kept as they
+        // are, anything else is serialized to text when it is queued, so its size is known.
         class EXTERNAL Package {
         private:
             Package() = delete;
@@ -18,13 +146,21 @@ namespace PluginHost {
             Package& operator=(const Package&) = delete;
 
         public:
-            explicit Package(const Core::ProxyType<Core::JSON::IElement>& json)
+            Package(const Core::ProxyType<Core::JSON::IElement>& json, const uint32_t size, const string& designator)
                 : _json(true)
+                , _event(true)
+                , _size(size)
+                , _queued(Core::Time::Monotonic())
+                , _designator(designator)
                 , _info(json)
             {
             }
-            explicit Package(const string& text) 
+            Package(const string& text, const bool event, const string& designator)
                 : _json(false)
+                , _event(event)
+                , _size(static_cast<uint32_t>(text.length()))
+                , _queued(Core::Time::Monotonic())
+                , _designator(designator)
                 , _info(text)
             {
             }
@@ -38,6 +174,26 @@ namespace PluginHost {
             }
 
         public:
+            inline bool IsJSON() const
+            {
+                return (_json);
+            }
+            inline bool IsEvent() const
+            {
+                return (_event);
+            }
+            inline uint32_t Size() const
+            {
+                return (_size);
+            }
+            inline uint64_t Queued() const
+            {
+                return (_queued);
+            }
+            inline const string& Designator() const
+            {
+                return (_designator);
+            }
             const string& Text() const
             {
                 return (_info.text);
@@ -49,6 +205,10 @@ namespace PluginHost {
 
         private:
             bool _json;
+            bool _event;
+            uint32_t _size;
+            uint64_t _queued;
+            string _designator;
             union Info {
                 Info(const Core::ProxyType<Core::JSON::IElement>& value)
                     : json(value)
@@ -211,37 +371,29 @@ namespace PluginHost {
         {
             return ((_state & 0x8000) != 0);
         }
-        inline void Submit(const string& text)
+        // Text sent to a channel is the answer to text received, unless it is marked as an event.
+        inline void Submit(const string& text, const bool event = false)
         {
             if (IsOpen() == true) {
-
-                _adminLock.Lock();
-
-                _sendQueue.emplace_back(text);
-
-                bool trigger = (_sendQueue.size() == 1);
-
-                _adminLock.Unlock();
-
-                if (trigger == true) {
-                    BaseClass::Trigger();
-                }
+                Enqueue(text, event, EMPTY_STRING);
             }
         }
+        // JSON-RPC messages without an id, and shared notifications, are events, anything else is an answer.
         inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
         {
             if (IsOpen() == true) {
+                Core::ProxyType<Notification> notification(Core::proxy_cast<Notification>(entry));
 
-                _adminLock.Lock();
-
-                _sendQueue.emplace_back(entry);
-
-                bool trigger = (_sendQueue.size() == 1);
+                if (notification.IsValid() == true) {
+                    Enqueue(entry, notification->Length(), notification->Designator());
+                } else {
+                    Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(entry));
+                    bool event = ((message.IsValid() == true) && (message->Id.IsSet() == false) && (message->Designator.IsSet() == true));
+                    string text;
 
-                _adminLock.Unlock();
+                    entry->ToString(text);
 
-                if (trigger == true) {
-                    BaseClass::Trigger();
+                    Enqueue(text, event, (event == true ? message->Designator.Value() : EMPTY_STRING));
                 }
             }
         }
@@ -254,6 +406,33 @@ namespace PluginHost {
             BaseClass::Trigger();
         }
 
+        // Outbound queue statistics: the messages waiting, the events dropped or coalesced because the
+        // channel could not keep up, and the average time (in microseconds) a message was queued.
+        inline uint32_t QueueDepth() const
+        {
+            _adminLock.Lock();
+            uint32_t result = static_cast<uint32_t>(_sendQueue.size());
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        inline uint32_t Dropped() const
+        {
+            return (_dropped);
+        }
+        inline uint32_t Coalesced() const
+        {
+            return (_coalesced);
+        }
+        inline uint32_t Latency() const
+        {
+            _adminLock.Lock();
+            uint32_t result = (_sent == 0 ? 0 : static_cast<uint32_t>(_latency / _sent));
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
     protected:
         inline void SetId(const uint32_t id)
         {
@@ -271,6 +450,46 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
+        // A request is received, its response goes out after those of all requests received before it.
+        inline void Pipeline(const Core::ProxyType<Web::Request>& request)
+        {
+            _adminLock.Lock();
+            _pipeline.emplace_back(request);
+            _adminLock.Unlock();
+        }
+        void Respond(const Core::ProxyType<Web::Request>& request, const Core::ProxyType<Web::Response>& response);
+        // A response is sent, returns true if its request asked to close the connection afterwards.
+        inline bool Responded(const Core::ProxyType<Web::Response>& response)
+        {
+            bool close = false;
+
+            _adminLock.Lock();
+
+            if ((_pipeline.empty() == false) && (_pipeline.front().Submitted == true) && (_pipeline.front().Response == response)) {
+                close = (_pipeline.front().Request->Connection.Value() == Web::Request::CONNECTION_CLOSE);
+                _pipeline.pop_front();
+            }
+
+            _adminLock.Unlock();
+
+            return (close);
+        }
+        // The channel is closed, none of the outstanding requests needs a response anymore.
+        inline void Abandon()
+        {
+            _adminLock.Lock();
+            _pipeline.clear();
+            _adminLock.Unlock();
+        }
+        // A high watermark of 0 leaves the outbound queue unbounded.
+        inline void Outbound(const uint32_t highWatermark, const uint32_t lowWatermark, const EventPolicy policy)
+        {
+            ASSERT(lowWatermark <= highWatermark);
+
+            _highWatermark = highWatermark;
+            _lowWatermark = lowWatermark;
+            _policy = policy;
+        }
         inline void State(const ChannelState state, const bool notification)
         {
             Binary(state == RAW);
@@ -284,49 +503,59 @@ namespace PluginHost {
 
                 switch (State()) {
                 case JSON:
-                case JSONRPC: {
-                    // Seems we are sending JSON structs
-                    size = _serializer.Serialize(reinterpret_cast<char*>(dataFrame), maxSendSize);
-
-                    if (_serializer.IsIdle() == true) {
+                case JSONRPC:
+                case TEXT: {
+                    _adminLock.Lock();
+                    bool json = ((_serializer.IsIdle() == false) || (_sendQueue.front().IsJSON() == true));
+                    _adminLock.Unlock();
 
-                        // See if there is more to do..
+                    if (json == true) {
+                        // Seems we are sending JSON structs
+                        size = _serializer.Serialize(reinterpret_cast<char*>(dataFrame), maxSendSize);
+
+                        if (_serializer.IsIdle() == true) {
+
+                            // See if there is more to do, an answer might have overtaken before we got to it..
+                            _adminLock.Lock();
+                            if (_sending == true) {
+                                Dequeue();
+                            }
+                            bool trigger(_sendQueue.size() > 0);
+                            _adminLock.Unlock();
+
+                            if (trigger == true) {
+                                BaseClass::Trigger();
+                            }
+                        } else {
+                            ASSERT(size != 0);
+                        }
+                    } else {
+                        // Seems we need to send plain strings...
                         _adminLock.Lock();
-                        _sendQueue.pop_front();
-                        bool trigger(_sendQueue.size() > 0);
+                        Package& data(_sendQueue.front());
+                        uint32_t neededBytes(static_cast<uint32_t>(data.Text().length() - _offset));
+
+                        if (neededBytes <= maxSendSize) {
+                            ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), neededBytes);
+                            size = static_cast<uint16_t>(neededBytes);
+                            _offset = 0;
+
+                            // See if there is more to do..
+                            Dequeue();
+                        } else {
+                            ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), maxSendSize);
+                            _offset += maxSendSize;
+                            size = maxSendSize;
+                        }
+                        bool trigger((_offset == 0) && (_sendQueue.size() > 0));
                         _adminLock.Unlock();
 
                         if (trigger == true) {
                             BaseClass::Trigger();
                         }
-                    } else {
-                        ASSERT(size != 0);
-                    }
 
-                    break;
-                }
-                case TEXT: {
-                    // Seems we need to send plain strings...
-                    _adminLock.Lock();
-                    Package& data(_sendQueue.front());
-                    uint16_t neededBytes(static_cast<uint16_t>(data.Text().length() - _offset));
-
-                    if (neededBytes <= maxSendSize) {
-                        ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), neededBytes);
-                        size = neededBytes;
-                        _offset = 0;
-
-                        // See if there is more to do..
-                        _sendQueue.pop_front();
-                    } else {
-                        uint16_t addedBytes = maxSendSize - size;
-                        ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), addedBytes);
-                        _offset += addedBytes;
-                        size = addedBytes;
+                        ASSERT(size != 0);
                     }
-                    _adminLock.Unlock();
-
-                    ASSERT(size != 0);
 
                     break;
                 }
@@ -396,8 +625,8 @@ namespace PluginHost {
 
         // We are in an upgraded mode, we are a websocket. Time to "deserialize and serialize
         // INBOUND and OUTBOUND information.
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
         // If it is a WebSocket, protocol TEXT, This is the feeding back virtual
         virtual void Received(const string& text) = 0;
@@ -414,15 +643,92 @@ namespace PluginHost {
 
             _adminLock.Lock();
 
-            if (_sendQueue.size() > 0) {
+            if ((_sendQueue.size() > 0) && (_sendQueue.front().IsJSON() == true)) {
                 result = _sendQueue.front().JSON();
-
+                _sending = true;
             }
             _adminLock.Unlock();
 
 			return (result);
 		}
 
+        // Whatever is at the front of the queue and already (partly) sent, can not be overtaken or replaced.
+        inline bool IsSending() const
+        {
+            return ((_sending == true) || (_offset != 0));
+        }
+        template <typename... Args>
+        void Enqueue(Args&&... args)
+        {
+            _adminLock.Lock();
+
+            std::list<Package>::iterator index(_sendQueue.emplace(_sendQueue.end(), std::forward<Args>(args)...));
+
+            if (index->IsEvent() == false) {
+                // Answers go before all events that are not on their way yet.
+                std::list<Package>::iterator position(_sendQueue.begin());
+
+                if (IsSending() == true) {
+                    position++;
+                }
+                while ((position != index) && (position->IsEvent() == false)) {
+                    position++;
+                }
+                if (position != index) {
+                    _sendQueue.splice(position, _sendQueue, index);
+                }
+                _queuedBytes += index->Size();
+            } else if (_congested == false) {
+                _queuedBytes += index->Size();
+                _congested = ((_highWatermark != 0) && (_queuedBytes >= _highWatermark));
+            } else {
+                std::list<Package>::iterator position(_sendQueue.begin());
+
+                if (_policy == COALESCE) {
+                    if (IsSending() == true) {
+                        position++;
+                    }
+                    while ((position != index) && ((position->IsEvent() == false) || (position->Designator().empty() == true) || (position->Designator() != index->Designator()))) {
+                        position++;
+                    }
+                }
+
+                if ((_policy == COALESCE) && (position != index)) {
+                    // The latest event replaces the one still waiting for the same designator.
+                    _queuedBytes += index->Size() - position->Size();
+                    _sendQueue.erase(position);
+                    _coalesced++;
+                } else {
+                    // Nothing to coalesce with, so the event adds to a queue that is already too long.
+                    _sendQueue.erase(index);
+                    _dropped++;
+                }
+            }
+
+            bool trigger = (_sendQueue.size() == 1);
+
+            _adminLock.Unlock();
+
+            if (trigger == true) {
+                BaseClass::Trigger();
+            }
+        }
+        // Should be called with the _adminLock taken.
+        void Dequeue()
+        {
+            const Package& sent(_sendQueue.front());
+
+            _latency += (Core::Time::Monotonic() - sent.Queued());
+            _sent++;
+            _queuedBytes -= sent.Size();
+            _sendQueue.pop_front();
+            _sending = false;
+
+            if ((_congested == true) && (_queuedBytes <= _lowWatermark)) {
+                _congested = false;
+            }
+        }
+
     private:
         mutable Core::CriticalSection _adminLock;
         uint32_t _ID;
@@ -433,12 +739,32 @@ namespace PluginHost {
         string _text;
         uint32_t _offset;
         std::list<Package> _sendQueue;
+        bool _sending;
+        bool _congested;
+        EventPolicy _policy;
+        uint32_t _highWatermark;
+        uint32_t _lowWatermark;
+        uint32_t _queuedBytes;
+        uint32_t _dropped;
+        uint32_t _coalesced;
+        uint32_t _sent;
+        uint64_t _latency;
+        std::list<Pipelined> _pipeline;
+        bool _responding;
 
         // All requests needed by any instance of this webserver are coming from this web server. They are extracted
         // from a pool. If the request is nolonger needed, the request returns to this pool.
         static RequestPool _requestAllocator;
     };
 }
+
+namespace Core {
+
+    template <>
+    EXTERNAL /* static */ const EnumerateConversion<PluginHost::Channel::EventPolicy>*
+    EnumerateType<PluginHost::Channel::EventPolicy>::Table(const uint16_t);
+
+} // namespace Core
 } // namespace Server
 
 #endif // __PLUGIN_FRAMEWORK_CHANNEL__
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Channel.h"
 #include "IShell.h"
 #include "Module.h"
 
@@ -58,24 +59,35 @@ namespace PluginHost {
             STATE_CUSTOM
         };
 
+        // Designators that resolved to a custom method before, so the next invoke does not have to
+        // parse the designator, walk the versions and look up the method again.
+        struct Resolved {
+            Core::JSONRPC::Handler* Source;
+            Core::JSONRPC::Handler::MethodId Method;
+            uint32_t Generation;
+        };
+        typedef std::unordered_map<string, Resolved> ResolvedMap;
+
     public:
         JSONRPC(const JSONRPC&) = delete;
         JSONRPC& operator=(const JSONRPC&) = delete;
         JSONRPC()
             : _adminLock()
             , _handlers()
+            , _resolved()
             , _service(nullptr)
         {
             std::vector<uint8_t> versions = { 1 };
 
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, [&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
         }
         JSONRPC(const std::vector<uint8_t> versions)
             : _adminLock()
             , _handlers()
+            , _resolved()
             , _service(nullptr)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, [&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
         }
         virtual ~JSONRPC()
         {
@@ -111,12 +123,12 @@ namespace PluginHost {
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, [&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions, const Core::JSONRPC::Handler& source)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions, source);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, [&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions, source);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler* GetHandler(uint8_t version)
@@ -253,13 +265,14 @@ namespace PluginHost {
             Registration info;
             Core::ProxyType<Core::JSONRPC::Message> response(Message());
             Core::JSONRPC::Handler* source = nullptr;
+            Core::JSONRPC::Handler::MethodId method = nullptr;
 
             if (inbound.Id.IsSet() == true) {
                 response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
                 response->Id = inbound.Id.Value();
             }
 
-            switch (Destination(inbound.Designator.Value(), source)) {
+            switch (Destination(inbound.Designator.Value(), source, method)) {
             case STATE_INCORRECT_HANDLER:
                 response->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
                 response->Error.Text = _T("Destined invoke failed.");
@@ -289,7 +302,7 @@ namespace PluginHost {
                 break;
             case STATE_CUSTOM:
                 string result;
-                uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
+                uint32_t code = source->Invoke(method, Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
                 if (response.IsValid() == true) {
                     if (code == static_cast<uint32_t>(~0)) {
                         response.Release();
@@ -306,7 +319,48 @@ namespace PluginHost {
         }
 
     private:
-        state Destination(const string& designator, Core::JSONRPC::Handler*& source)
+        state Destination(const string& designator, Core::JSONRPC::Handler*& source, Core::JSONRPC::Handler::MethodId& method)
+        {
+            state result = STATE_INCORRECT_HANDLER;
+            const string callsign(Core::JSONRPC::Message::Callsign(designator));
+
+            if (callsign.empty() || (callsign == _callsign)) {
+                // Key on what the designator resolves to: the version as a number and the method. The
+                // same call can be written in many ways ("1", "01", an index), they share an entry.
+                const string name(Core::JSONRPC::Message::Method(designator));
+                string key(1, static_cast<TCHAR>(Core::JSONRPC::Message::Version(designator)));
+                key += name;
+
+                _adminLock.Lock();
+
+                ResolvedMap::const_iterator entry(_resolved.find(key));
+
+                if ((entry != _resolved.end()) && (entry->second.Source->Generation() == entry->second.Generation)) {
+                    source = entry->second.Source;
+                    method = entry->second.Method;
+                    result = STATE_CUSTOM;
+                }
+
+                _adminLock.Unlock();
+
+                if (result != STATE_CUSTOM) {
+                    result = Resolve(designator, source);
+
+                    if (result == STATE_CUSTOM) {
+                        method = source->Resolve(name);
+
+                        ASSERT(method != nullptr);
+
+                        _adminLock.Lock();
+                        _resolved[key] = { source, method, source->Generation() };
+                        _adminLock.Unlock();
+                    }
+                }
+            }
+
+            return (result);
+        }
+        state Resolve(const string& designator, Core::JSONRPC::Handler*& source)
         {
             state result = STATE_INCORRECT_HANDLER;
             string callsign(Core::JSONRPC::Message::Callsign(designator));
@@ -362,6 +416,37 @@ namespace PluginHost {
 
             _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message));
         }
+        void Notify(const std::vector<uint32_t>& ids, const string& designator, const string& parameters)
+        {
+            string text;
+
+            if (ids.size() > 1) {
+                Core::ProxyType<Core::JSONRPC::Message> message(_jsonRPCMessageFactory.Element());
+
+                if (!parameters.empty()) {
+                    message->Parameters = parameters;
+                }
+
+                message->Designator = designator;
+                message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                message->ToString(text);
+            }
+
+            if ((text.empty() == true) || (text.length() >= 0xFFFF)) {
+                // A single subscriber, or too large to be sent by offset, build it for every channel.
+                for (const uint32_t id : ids) {
+                    Notify(id, designator, parameters);
+                }
+            } else {
+                Core::ProxyType<Core::JSON::IElement> frame(Core::ProxyType<Channel::Notification>::Create(designator, text));
+
+                ASSERT(_service != nullptr);
+
+                for (const uint32_t id : ids) {
+                    _service->Submit(id, frame);
+                }
+            }
+        }
         virtual void Activate(IShell* service) override
         {
             ASSERT(_service == nullptr);
@@ -381,6 +466,10 @@ namespace PluginHost {
 
             _handlers.front().Close();
             _service = nullptr;
+
+            _adminLock.Lock();
+            _resolved.clear();
+            _adminLock.Unlock();
         }
         virtual void Closed(const uint32_t id) override
         {
@@ -395,6 +484,7 @@ namespace PluginHost {
     private:
         mutable Core::CriticalSection _adminLock;
         std::list<Core::JSONRPC::Handler> _handlers;
+        ResolvedMap _resolved;
         IShell* _service;
         string _callsign;
 
@@ -133,6 +133,10 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("depth"), &Depth);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("latency"), &Latency);
     }
     MetaData::Channel::Channel(const MetaData::Channel& copy)
         : Core::JSON::Container()
@@ -141,12 +145,20 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Depth(copy.Depth)
+        , Dropped(copy.Dropped)
+        , Coalesced(copy.Coalesced)
+        , Latency(copy.Latency)
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &JSONState);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("depth"), &Depth);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("latency"), &Latency);
     }
     MetaData::Channel::~Channel()
     {
@@ -159,6 +171,10 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Depth = RHS.Depth;
+        Dropped = RHS.Dropped;
+        Coalesced = RHS.Coalesced;
+        Latency = RHS.Latency;
 
         return (*this);
     }
@@ -113,6 +113,10 @@ namespace PluginHost {
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            Core::JSON::DecUInt32 Depth;
+            Core::JSON::DecUInt32 Dropped;
+            Core::JSON::DecUInt32 Coalesced;
+            Core::JSON::DecUInt32 Latency;
         };
 
         class EXTERNAL Bridge : public Core::JSON::Container {
@@ -75,7 +75,7 @@ namespace PluginHost {
             std::list<Channel*>::iterator index(_notifiers.begin());
 
             while (index != _notifiers.end()) {
-                (*index)->Submit(message);
+                (*index)->Submit(message, true);
                 index++;
             }
         }
@@ -84,23 +84,25 @@ namespace PluginHost {
     }
 #endif
 
-    void Service::FileToServe(const string& webServiceRequest, Web::Response& response)
+    void Service::FileToServe(const Web::Request& request, Web::Response& response)
     {
         Web::MIMETypes result;
+        const string& webServiceRequest(request.Path);
         uint16_t offset = static_cast<uint16_t>(_config.WebPrefix().length()) + (_webURLPath.empty() ? 1 : static_cast<uint16_t>(_webURLPath.length()) + 2);
         string fileToService = _webServerFilePath;
 
         if ((webServiceRequest.length() <= offset) || (Web::MIMETypeForFile(webServiceRequest.substr(offset, -1), fileToService, result) == false)) {
-            Core::ProxyType<Web::FileBody> fileBody(Factories::Instance().FileBody());
-
             // No filename gives, be default, we go for the index.html page..
-            *fileBody = fileToService + _T("index.html");
-            response.ContentType = Web::MIME_HTML;
-            response.Body<Web::FileBody>(fileBody);
-        } else {
+            fileToService += _T("index.html");
+            result = Web::MIME_HTML;
+        }
+
+        response.ContentType = result;
+
+        // Small files are served from memory, the rest is streamed from disk.
+        if (Core::SingletonType<Web::FileCache>::Instance().Serve(fileToService, request, response) == false) {
             Core::ProxyType<Web::FileBody> fileBody(Factories::Instance().FileBody());
             *fileBody = fileToService;
-            response.ContentType = result;
             response.Body<Web::FileBody>(fileBody);
         }
     }
@@ -36,7 +36,7 @@ namespace PluginHost {
         {
             return (_fileBodyFactory.Element());
         }
-        inline Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> JSONRPC()
+        inline Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>> JSONRPC()
         {
             return (_jsonRPCFactory.Element());
         }
@@ -47,7 +47,7 @@ namespace PluginHost {
         Core::ProxyPoolType<Web::Request> _requestFactory;
         Core::ProxyPoolType<Web::Response> _responseFactory;
         Core::ProxyPoolType<Web::FileBody> _fileBodyFactory;
-        Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> _jsonRPCFactory;
+        Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Batch>> _jsonRPCFactory;
     };
 
     class EXTERNAL Service : public IShell {
@@ -460,7 +460,7 @@ namespace PluginHost {
             _processedObjects++;
         }
 #endif
-        void FileToServe(const string& webServiceRequest, Web::Response& response);
+        void FileToServe(const Web::Request& request, Web::Response& response);
 
     private:
         mutable Core::CriticalSection _adminLock;
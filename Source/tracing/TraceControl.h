@@ -33,6 +33,19 @@
             &__message__);                                                             \
     }
 
+// Traces a compact record: the call site is registered once, after that only the arguments of
+// the format are written. The text is formatted by whoever reads the trace.
+#define TRACE_COMPACT(CATEGORY, PARAMETERS)                                            \
+    if (WPEFramework::Trace::TraceType<CATEGORY, &WPEFramework::Core::System::MODULE_NAME>::IsEnabled() == true) { \
+        static WPEFramework::Trace::CallSite __site__(                                 \
+            __FILE__,                                                                  \
+            __LINE__,                                                                  \
+            __FUNCTION__,                                                              \
+            WPEFramework::Trace::TraceType<CATEGORY, &WPEFramework::Core::System::MODULE_NAME>::ModuleName(),   \
+            WPEFramework::Trace::TraceType<CATEGORY, &WPEFramework::Core::System::MODULE_NAME>::CategoryName()); \
+        __site__.Trace PARAMETERS;                                                     \
+    }
+
 // ---- Helper functions ----
 
 // ---- Class Definition ----
@@ -131,6 +144,16 @@ namespace Trace {
             s_TraceControl.Enabled(status);
         }
 
+        inline static const char* CategoryName()
+        {
+            return (s_TraceControl.Category());
+        }
+
+        inline static const char* ModuleName()
+        {
+            return (s_TraceControl.Module());
+        }
+
         virtual const char* Category() const
         {
             return (s_TraceControl.Category());
@@ -172,6 +195,49 @@ namespace Trace {
 
     template <typename CATEGORY, const char** MODULENAME>
     EXTERNAL_HIDDEN typename TraceType<CATEGORY, MODULENAME>::template TraceControl<CATEGORY, MODULENAME> TraceType<CATEGORY, MODULENAME>::s_TraceControl;
+
+    class CallSite {
+    public:
+        CallSite() = delete;
+        CallSite(const CallSite&) = delete;
+        CallSite& operator=(const CallSite&) = delete;
+
+        CallSite(const char fileName[], const uint32_t lineNumber, const char className[], const char module[], const char category[])
+            : _fileName(fileName)
+            , _lineNumber(lineNumber)
+            , _className(className)
+            , _module(module)
+            , _category(category)
+            , _id(0)
+        {
+        }
+        ~CallSite()
+        {
+        }
+
+    public:
+        template <typename... ARGUMENTS>
+        void Trace(const char format[], const ARGUMENTS&... arguments)
+        {
+            uint32_t id = _id.load();
+
+            if (id == 0) {
+                // Racing threads might both register, the reader knows both.
+                id = TraceUnit::Instance().Register(_fileName, _lineNumber, _className, _module, _category, format);
+                _id.store(id);
+            }
+
+            TraceUnit::Instance().Trace(id, arguments...);
+        }
+
+    private:
+        const char* _fileName;
+        const uint32_t _lineNumber;
+        const char* _className;
+        const char* _module;
+        const char* _category;
+        std::atomic<uint32_t> _id;
+    };
 }
 
 } // namespace Trace
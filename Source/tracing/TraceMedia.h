@@ -35,18 +35,18 @@ namespace Trace {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 // We used it all up..
                 // TODO: make thread safe.
 
-                uint16_t actualByteCount = _loaded > maxSendSize ? maxSendSize : _loaded;
+                uint32_t actualByteCount = _loaded > maxSendSize ? maxSendSize : _loaded;
                 memcpy(dataFrame, _traceBuffer, actualByteCount);
                 _loaded = 0;
 
                 return (actualByteCount);
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 _parent.HandleMessage(dataFrame, receivedSize);
 
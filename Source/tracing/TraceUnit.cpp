@@ -89,12 +89,265 @@ namespace Trace {
 
     /* static */ const TCHAR* CyclicBufferName = _T("tracebuffer");
 
+    namespace {
+
+        // The call sites of compact records are stored next to the rings: length(2 bytes) -
+        // identifier (4 bytes) - line number (4 bytes) - file/className/module/category/format
+        const TCHAR* MetadataExtension = _T(".metadata");
+
+        inline const char* Field(const uint8_t entry[], uint16_t& offset, const uint16_t length)
+        {
+            const char* result = reinterpret_cast<const char*>(&(entry[offset]));
+            const uint8_t* end = reinterpret_cast<const uint8_t*>(::memchr(result, '\0', length - offset));
+
+            offset = (end != nullptr ? static_cast<uint16_t>(end - entry + 1) : length);
+
+            return (end != nullptr ? result : "");
+        }
+
+        // Loads a value of the given size, as it was stored by the traced process.
+        inline bool Load(const uint8_t data[], const uint8_t size, uint64_t& value)
+        {
+            bool result = true;
+
+            switch (size) {
+            case 1: {
+                uint8_t loaded;
+                ::memcpy(&loaded, data, 1);
+                value = loaded;
+                break;
+            }
+            case 2: {
+                uint16_t loaded;
+                ::memcpy(&loaded, data, 2);
+                value = loaded;
+                break;
+            }
+            case 4: {
+                uint32_t loaded;
+                ::memcpy(&loaded, data, 4);
+                value = loaded;
+                break;
+            }
+            case 8: {
+                ::memcpy(&value, data, 8);
+                break;
+            }
+            default:
+                result = false;
+                break;
+            }
+
+            return (result);
+        }
+
+        // Narrows an integer to the given number of bytes, sign extending it for the signed conversions.
+        inline uint64_t Narrow(const uint64_t value, const uint8_t size, const bool sign)
+        {
+            uint64_t result = value;
+
+            if (size < sizeof(uint64_t)) {
+                const uint64_t mask = ((1ULL << (size * 8)) - 1);
+
+                result &= mask;
+
+                if ((sign == true) && ((result & (1ULL << ((size * 8) - 1))) != 0)) {
+                    result |= ~mask;
+                }
+            }
+
+            return (result);
+        }
+
+        // Expands the format of a compact record with its arguments, the way printf would have.
+        string Expand(const string& format, const uint8_t arguments[], const uint16_t length)
+        {
+            string result;
+            uint16_t offset = 0;
+            string::size_type index = 0;
+
+            // Takes the next argument, returns its type or 0 if there is none left.
+            auto next = [&](uint64_t& value, uint8_t& size, string& text) -> uint8_t {
+                uint8_t type = 0;
+
+                if (((offset + 2) <= length) && ((arguments[offset] == 'd') || (arguments[offset] == 'f')) && ((offset + 2 + arguments[offset + 1]) <= length)) {
+                    size = arguments[offset + 1];
+
+                    if (Load(&(arguments[offset + 2]), size, value) == true) {
+                        type = arguments[offset];
+                    }
+                    offset += (2 + size);
+                } else if ((offset < length) && (arguments[offset] == 's') && ((offset + 3) <= length)) {
+                    uint16_t textLength;
+                    ::memcpy(&textLength, &(arguments[offset + 1]), 2);
+                    textLength = std::min(textLength, static_cast<uint16_t>(length - offset - 3));
+                    type = 's';
+                    text.assign(reinterpret_cast<const char*>(&(arguments[offset + 3])), textLength);
+                    offset += (3 + textLength);
+                }
+
+                return (type);
+            };
+
+            while (index < format.length()) {
+                string::size_type marker = format.find('%', index);
+
+                result.append(format, index, (marker == string::npos ? string::npos : marker - index));
+
+                if (marker == string::npos) {
+                    break;
+                }
+
+                // Collect the flags, width and precision. The length modifiers are replaced by the
+                // size of the argument, only 'h' and 'hh' narrow it any further. Floating points are
+                // stored as double.
+                string spec(1, '%');
+                uint8_t narrow = sizeof(uint64_t);
+                index = marker + 1;
+
+                while ((index < format.length()) && (::strchr("-+ #0123456789.*", format[index]) != nullptr)) {
+                    if (format[index] == '*') {
+                        uint64_t value = 0;
+                        uint8_t size = sizeof(int32_t);
+                        string text;
+                        next(value, size, text);
+                        spec += Core::NumberType<int32_t>(static_cast<int32_t>(Narrow(value, size, true))).Text();
+                    } else {
+                        spec += format[index];
+                    }
+                    index++;
+                }
+                while ((index < format.length()) && (::strchr("hlLqjzt", format[index]) != nullptr)) {
+                    if (format[index] == 'h') {
+                        narrow = (narrow == sizeof(uint16_t) ? sizeof(uint8_t) : sizeof(uint16_t));
+                    }
+                    index++;
+                }
+
+                const TCHAR conversion = (index < format.length() ? format[index++] : '\0');
+                TCHAR buffer[256];
+                uint64_t value = 0;
+                uint8_t size = 0;
+                string text;
+
+                if (conversion == '%') {
+                    result += '%';
+                } else if (conversion == '\0') {
+                    break;
+                } else {
+                    const uint8_t type = next(value, size, text);
+
+                    buffer[0] = '\0';
+
+                    if (type == 0) {
+                        result += _T("<missing>");
+                    } else if (::strchr("diouxXc", conversion) != nullptr) {
+                        if (type == 'd') {
+                            const bool sign = ((conversion == 'd') || (conversion == 'i'));
+
+                            value = Narrow(value, std::min(size, narrow), sign);
+
+                            if (conversion == 'c') {
+                                ::snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), static_cast<int>(value));
+                            } else if (sign == true) {
+                                ::snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), static_cast<long long>(value));
+                            } else {
+                                ::snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(value));
+                            }
+                        } else {
+                            result += (type == 's' ? text : _T("<invalid>"));
+                        }
+                    } else if (::strchr("eEfFgGaA", conversion) != nullptr) {
+                        if (type == 'f') {
+                            double converted;
+                            ::memcpy(&converted, &value, sizeof(converted));
+                            ::snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), converted);
+                        } else {
+                            result += _T("<invalid>");
+                        }
+                    } else if (conversion == 's') {
+                        if (type == 's') {
+                            ::snprintf(buffer, sizeof(buffer), (spec + 's').c_str(), text.c_str());
+                            if (text.length() >= sizeof(buffer)) {
+                                // Do not truncate long texts, the spec can not add anything to those anyway.
+                                result += text;
+                                buffer[0] = '\0';
+                            }
+                        } else {
+                            result += _T("<invalid>");
+                        }
+                    } else if (conversion == 'p') {
+                        ::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+                    }
+
+                    result += buffer;
+                }
+            }
+
+            return (result);
+        }
+
+        static_assert(CyclicBufferRings <= 32, "The claimed rings are administered in a 32 bits mask");
+
+        std::atomic<uint32_t> _claimed(0);
+
+        // Every thread claims a ring on its first trace and hands it back when it exits. Threads
+        // that find all rings taken, write to the shared ring.
+        class RingClaim {
+        public:
+            RingClaim(const RingClaim&) = delete;
+            RingClaim& operator=(const RingClaim&) = delete;
+
+            RingClaim()
+                : _slot(CyclicBufferRings)
+            {
+                uint32_t claimed = _claimed.load();
+                uint8_t slot = 0;
+
+                while (slot < CyclicBufferRings) {
+                    if ((claimed & (1 << slot)) != 0) {
+                        slot++;
+                    } else if (_claimed.compare_exchange_weak(claimed, claimed | (1 << slot)) == true) {
+                        _slot = slot;
+                        break;
+                    }
+                }
+            }
+            ~RingClaim()
+            {
+                if (_slot < CyclicBufferRings) {
+                    _claimed.fetch_and(~(1 << _slot));
+                }
+            }
+
+        public:
+            inline uint8_t Slot() const
+            {
+                return (_slot);
+            }
+
+        private:
+            uint8_t _slot;
+        };
+
+        static thread_local RingClaim _ringClaim;
+    }
+
     TraceUnit::TraceUnit()
         : m_Categories()
         , m_Admin()
         , m_OutputChannel(nullptr)
+        , m_Writable(false)
+        , m_DoorBell()
+        , m_FileName()
+        , m_Sites()
+        , m_Metadata()
         , m_DirectOut(false)
     {
+        for (Ring& ring : m_Rings) {
+            ring.Buffer = nullptr;
+            ring.Busy = false;
+        }
     }
 
     TraceUnit::TraceBuffer::TraceBuffer(const string& doorBell, const string& name)
@@ -142,12 +395,12 @@ namespace Trace {
 
     TraceUnit::~TraceUnit()
     {
-        m_Admin.Lock();
-
         if (m_OutputChannel != nullptr) {
             Close();
         }
 
+        m_Admin.Lock();
+
         while (m_Categories.size() != 0) {
             m_Categories.front()->Destroy();
         }
@@ -191,23 +444,205 @@ namespace Trace {
         return (Open(doorBell, fileName));
     }
 
+    uint32_t TraceUnit::Open(const string& doorBell, const string& fileName)
+    {
+        ASSERT(m_OutputChannel == nullptr);
+
+        m_OutputChannel = new TraceBuffer(doorBell, fileName);
+
+        ASSERT(m_OutputChannel->IsValid() == true);
+
+        // Rings left behind by a previous run would be merged with ours by the reader.
+        for (uint8_t slot = 0; slot < CyclicBufferRings; slot++) {
+            Core::File(TraceReader::RingName(fileName, slot + 1)).Destroy();
+        }
+
+        m_Admin.Lock();
+
+        // Call sites might have registered before, write them out for the reader.
+        m_Metadata = fileName + MetadataExtension;
+
+        if (m_Metadata.Create(Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::OTHERS_READ) == true) {
+            for (const string& site : m_Sites) {
+                m_Metadata.Write(reinterpret_cast<const uint8_t*>(site.c_str()), static_cast<uint32_t>(site.length()));
+            }
+        }
+
+        m_DoorBell = doorBell;
+        m_FileName = fileName;
+        m_Writable = m_OutputChannel->IsValid();
+
+        m_Admin.Unlock();
+
+        return (m_OutputChannel->IsValid() ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+    }
+
     uint32_t TraceUnit::Close()
     {
+        // Stop the threads from writing to their rings and wait for the ones still busy. Do
+        // not hold the lock while waiting, a thread might need it to create its ring.
+        m_Writable = false;
+
+        for (Ring& ring : m_Rings) {
+            while (ring.Busy.load() == true) {
+                std::this_thread::yield();
+            }
+        }
+
         m_Admin.Lock();
 
         ASSERT(m_OutputChannel != nullptr);
 
+        for (Ring& ring : m_Rings) {
+            if (ring.Buffer != nullptr) {
+                delete ring.Buffer;
+                ring.Buffer = nullptr;
+            }
+        }
+
         if (m_OutputChannel != nullptr) {
             delete m_OutputChannel;
         }
 
         m_OutputChannel = nullptr;
+        m_Metadata.Close();
 
         m_Admin.Unlock();
 
         return (Core::ERROR_NONE);
     }
 
+    TraceUnit::TraceBuffer* TraceUnit::Create(const uint8_t slot)
+    {
+        m_Admin.Lock();
+
+        if (m_Rings[slot].Buffer == nullptr) {
+            TraceBuffer* ring = new TraceBuffer(m_DoorBell, TraceReader::RingName(m_FileName, slot + 1));
+
+            if (ring->IsValid() == true) {
+                m_Rings[slot].Buffer = ring;
+            } else {
+                delete ring;
+            }
+        }
+
+        m_Admin.Unlock();
+
+        return (m_Rings[slot].Buffer);
+    }
+
+    uint32_t TraceUnit::Register(const char file[], const uint32_t lineNumber, const char className[], const char module[], const char category[], const char format[])
+    {
+        const char* fileName(Core::FileNameOnly(file));
+        const char* fields[] = { fileName, className, module, category, format };
+        string site(2 + 4 + 4, '\0');
+
+        for (const char* field : fields) {
+            site.append(field, ::strlen(field) + 1);
+        }
+
+        m_Admin.Lock();
+
+        const uint32_t id = static_cast<uint32_t>(m_Sites.size() + 1);
+        const uint16_t length = static_cast<uint16_t>(site.length());
+
+        ASSERT(id < CompactRecord);
+
+        site.replace(0, 2, reinterpret_cast<const char*>(&length), 2);
+        site.replace(2, 4, reinterpret_cast<const char*>(&id), 4);
+        site.replace(6, 4, reinterpret_cast<const char*>(&lineNumber), 4);
+
+        m_Sites.push_back(site);
+
+        // The site is known by the reader before the first record referring to it is written.
+        if (m_Metadata.IsOpen() == true) {
+            m_Metadata.Write(reinterpret_cast<const uint8_t*>(site.c_str()), static_cast<uint32_t>(site.length()));
+        }
+
+        m_Admin.Unlock();
+
+        return (id);
+    }
+
+    // Compact records are expanded here, only when traces go to the console as well.
+    void TraceUnit::Print(const uint32_t site, const uint8_t arguments[], const uint16_t length)
+    {
+        string info;
+
+        m_Admin.Lock();
+
+        if ((site != 0) && (site <= m_Sites.size())) {
+            info = m_Sites[site - 1];
+        }
+
+        m_Admin.Unlock();
+
+        if (info.empty() == false) {
+            const uint8_t* fields = reinterpret_cast<const uint8_t*>(info.c_str());
+            const uint16_t fieldsLength = static_cast<uint16_t>(info.length());
+            uint16_t offset = 2 + 4 + 4;
+            uint32_t lineNumber;
+
+            ::memcpy(&lineNumber, &(fields[6]), 4);
+
+            const char* fileName = Field(fields, offset, fieldsLength);
+            const char* className = Field(fields, offset, fieldsLength);
+            Field(fields, offset, fieldsLength);
+            const char* category = Field(fields, offset, fieldsLength);
+            const char* format = Field(fields, offset, fieldsLength);
+
+            const string text(Expand(format, arguments, length));
+            string time(Core::Time::Now().ToRFC1123(true));
+            Core::TextFragment cleanClassName(Core::ClassNameOnly(className));
+
+            fprintf(stdout, "[%s]:[%s:%d]:[%s] %s: %s\n", time.c_str(), fileName, lineNumber, cleanClassName.Data(), category, text.c_str());
+            fflush(stdout);
+        }
+    }
+
+    void TraceUnit::Write(const Fragment fragments[], const uint8_t count, const uint16_t length)
+    {
+        const uint8_t slot = _ringClaim.Slot();
+        bool written = false;
+
+        if (slot < CyclicBufferRings) {
+            Ring& ring(m_Rings[slot]);
+
+            ring.Busy = true;
+
+            if (m_Writable.load() == true) {
+                TraceBuffer* buffer = (ring.Buffer != nullptr ? ring.Buffer : Create(slot));
+
+                if (buffer != nullptr) {
+                    Write(*buffer, fragments, count, length);
+                    written = true;
+                }
+            }
+
+            ring.Busy = false;
+        }
+
+        if (written == false) {
+            m_Admin.Lock();
+
+            if (m_OutputChannel != nullptr) {
+                Write(*m_OutputChannel, fragments, count, length);
+            }
+
+            m_Admin.Unlock();
+        }
+    }
+
+    /* static */ void TraceUnit::Write(TraceBuffer& buffer, const Fragment fragments[], const uint8_t count, const uint16_t length)
+    {
+        // The head only moves once all that was reserved is written, so a reader never sees part of a record.
+        if (buffer.Reserve(length) == length) {
+            for (uint8_t index = 0; index < count; index++) {
+                buffer.Write(static_cast<const uint8_t*>(fragments[index].Data), fragments[index].Length);
+            }
+        }
+    }
+
     void TraceUnit::Announce(ITraceControl& Category)
     {
         m_Admin.Lock();
@@ -361,9 +796,7 @@ namespace Trace {
     {
         const char* fileName(Core::FileNameOnly(file));
 
-        m_Admin.Lock();
-
-        if (m_OutputChannel != nullptr) {
+        if (m_Writable.load() == true) {
 
             const char* category(information->Category());
             const char* module(information->Module());
@@ -378,30 +811,22 @@ namespace Trace {
             // length(2 bytes) - clock ticks (8 bytes) - line number (4 bytes) - file/module/category/className
             const uint16_t headerLength = 2 + 8 + 4 + fileNameLength + moduleLength + categoryLength + classNameLength;
 
-            const uint32_t fullLength = informationLength + headerLength; // Actual data (no '\0' needed).
-
-            // Tell the buffer how much we are going to write.
-            const uint32_t actualLength = m_OutputChannel->Reserve(fullLength);
-
-            if (actualLength >= headerLength) {
-                const uint16_t convertedLength = static_cast<uint16_t>(actualLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&convertedLength), 2);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&current), 8);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&lineNumber), 4);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(fileName), fileNameLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(module), moduleLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(category), categoryLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(className), classNameLength);
-
-                if (actualLength >= fullLength) {
-                    // We can write the whole information.
-                    m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(information->Data()), informationLength);
-                } else {
-                    // Can only write information partially
-                    const uint16_t dropLength = actualLength - headerLength;
-
-                    m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(information->Data()), dropLength);
-                }
+            if (headerLength < CyclicBufferSize) {
+                // Whatever does not fit in the ring is dropped.
+                const uint16_t dataLength = static_cast<uint16_t>(std::min(static_cast<uint32_t>(informationLength), static_cast<uint32_t>(CyclicBufferSize - 1 - headerLength)));
+                const uint16_t entryLength = headerLength + dataLength;
+                const Fragment fragments[] = {
+                    { &entryLength, 2 },
+                    { &current, 8 },
+                    { &lineNumber, 4 },
+                    { fileName, fileNameLength },
+                    { module, moduleLength },
+                    { category, categoryLength },
+                    { className, classNameLength },
+                    { information->Data(), dataLength }
+                };
+
+                Write(fragments, static_cast<uint8_t>(sizeof(fragments) / sizeof(Fragment)), entryLength);
             }
         }
 
@@ -412,8 +837,204 @@ namespace Trace {
             fprintf(stdout, "[%s]:[%s:%d]:[%s] %s: %s\n", time.c_str(), fileName, lineNumber, cleanClassName.Data(), information->Category(), information->Data());
             fflush(stdout);
         }
+    }
 
-        m_Admin.Unlock();
+    TraceReader::Ring::Ring(const string& fileName)
+        : Core::CyclicBuffer(fileName, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE, 0, true)
+        , _length(0)
+    {
+    }
+
+    TraceReader::Ring::~Ring()
+    {
+    }
+
+    /* virtual */ uint32_t TraceReader::Ring::GetReadSize(Cursor& cursor)
+    {
+        // Entries are read one at a time, their length is in the first 2 bytes.
+        uint16_t entrySize = 0;
+        cursor.Peek(entrySize);
+        return (entrySize);
+    }
+
+    bool TraceReader::Ring::Stage()
+    {
+        if ((_length == 0) && (Used() > 0)) {
+            _length = static_cast<uint16_t>(Read(_record, sizeof(_record)));
+        }
+
+        return (_length != 0);
+    }
+
+    uint16_t TraceReader::Ring::Unstage(uint8_t buffer[], const uint16_t length)
+    {
+        const uint16_t result = std::min(_length, length);
+
+        ASSERT(length >= _length);
+
+        ::memcpy(buffer, _record, result);
+        _length = 0;
+
+        return (result);
+    }
+
+    TraceReader::TraceReader(const string& fileName)
+        : _fileName(fileName)
+        , _metadata(fileName + MetadataExtension)
+        , _loaded()
+        , _parsed(0)
+        , _sites()
+    {
+        for (Ring*& ring : _rings) {
+            ring = nullptr;
+        }
+
+        Scan();
+    }
+
+    /* static */ string TraceReader::RingName(const string& fileName, const uint8_t index)
+    {
+        return (index == 0 ? fileName : fileName + '_' + Core::NumberType<uint8_t>(index - 1).Text());
+    }
+
+    TraceReader::~TraceReader()
+    {
+        for (Ring*& ring : _rings) {
+            if (ring != nullptr) {
+                delete ring;
+            }
+        }
+    }
+
+    void TraceReader::Scan()
+    {
+        // Rings are created by the threads of the traced process on their first trace, pick up
+        // the ones that appeared since the last scan.
+        for (uint8_t index = 0; index <= CyclicBufferRings; index++) {
+            if (_rings[index] == nullptr) {
+                const string fileName(RingName(_fileName, index));
+
+                if (Core::File(fileName).Exists() == true) {
+                    Ring* ring = new Ring(fileName);
+
+                    if (ring->IsValid() == true) {
+                        _rings[index] = ring;
+                    } else {
+                        delete ring;
+                    }
+                }
+            }
+        }
+    }
+
+    uint16_t TraceReader::Read(uint8_t buffer[], const uint16_t length)
+    {
+        Ring* oldest = nullptr;
+
+        for (uint8_t round = 0; (round < 2) && (oldest == nullptr); round++) {
+            if (round == 1) {
+                Scan();
+            }
+
+            for (Ring* ring : _rings) {
+                if ((ring != nullptr) && (ring->Stage() == true) && ((oldest == nullptr) || (ring->Ticks() < oldest->Ticks()))) {
+                    oldest = ring;
+                }
+            }
+        }
+
+        return (oldest != nullptr ? oldest->Unstage(buffer, length) : 0);
+    }
+
+    void TraceReader::Load()
+    {
+        // The metadata file only grows, take in what was appended since the last load.
+        if ((_metadata.IsOpen() == true) || (_metadata.Open() == true)) {
+            uint8_t buffer[1024];
+            uint32_t loaded;
+
+            while ((loaded = _metadata.Read(buffer, sizeof(buffer))) != 0) {
+                _loaded.insert(_loaded.end(), buffer, buffer + loaded);
+            }
+        }
+
+        while ((_parsed + 2) <= _loaded.size()) {
+            uint16_t length;
+            ::memcpy(&length, &(_loaded[_parsed]), 2);
+
+            if ((length < 10) || ((_parsed + length) > _loaded.size())) {
+                break;
+            }
+
+            const uint8_t* site = &(_loaded[_parsed]);
+            uint32_t id;
+            uint16_t offset = 10;
+
+            ::memcpy(&id, &(site[2]), 4);
+
+            if (_sites.size() < id) {
+                _sites.resize(id);
+            }
+
+            Site& entry(_sites[id - 1]);
+            ::memcpy(&(entry.Line), &(site[6]), 4);
+            entry.File = Field(site, offset, length);
+            entry.ClassName = Field(site, offset, length);
+            entry.Module = Field(site, offset, length);
+            entry.Category = Field(site, offset, length);
+            entry.Format = Field(site, offset, length);
+
+            _parsed += length;
+        }
+    }
+
+    bool TraceReader::Read(Entry& entry)
+    {
+        uint8_t buffer[CyclicBufferSize];
+        const uint16_t length = Read(buffer, sizeof(buffer));
+
+        if (length >= 14) {
+            uint32_t marker;
+            uint16_t offset = 14;
+
+            ::memcpy(&(entry.Ticks), &(buffer[2]), 8);
+            ::memcpy(&marker, &(buffer[10]), 4);
+
+            if ((marker & CompactRecord) == 0) {
+                entry.Line = marker;
+                entry.File = Field(buffer, offset, length);
+                entry.Module = Field(buffer, offset, length);
+                entry.Category = Field(buffer, offset, length);
+                entry.ClassName = Field(buffer, offset, length);
+                entry.Text.assign(reinterpret_cast<const char*>(&(buffer[offset])), length - offset);
+            } else {
+                const uint32_t id = (marker & ~CompactRecord);
+
+                if ((id != 0) && ((id > _sites.size()) || (_sites[id - 1].Format.empty() == true))) {
+                    Load();
+                }
+
+                if ((id != 0) && (id <= _sites.size())) {
+                    const Site& site(_sites[id - 1]);
+
+                    entry.Line = site.Line;
+                    entry.File = site.File;
+                    entry.Module = site.Module;
+                    entry.Category = site.Category;
+                    entry.ClassName = site.ClassName;
+                    entry.Text = Expand(site.Format, &(buffer[offset]), length - offset);
+                } else {
+                    entry.Line = 0;
+                    entry.File.clear();
+                    entry.Module.clear();
+                    entry.Category.clear();
+                    entry.ClassName.clear();
+                    entry.Text = _T("<unknown call site>");
+                }
+            }
+        }
+
+        return (length >= 14);
     }
 }
 } // namespace WPEFramework::Trace
@@ -17,6 +17,10 @@ namespace Trace {
     struct ITrace;
 
     constexpr uint32_t CyclicBufferSize = ((8 * 1024) - (sizeof(struct Core::CyclicBuffer::control))); /* 8Kb */
+    // Number of single producer rings a process can hand out to its threads, next to the shared one.
+    constexpr uint8_t CyclicBufferRings = 16;
+    // The line number field of a compact record carries the identifier of its call site, marked by this bit.
+    constexpr uint32_t CompactRecord = 0x80000000;
     extern EXTERNAL const TCHAR* CyclicBufferName;
 
     // ---- Class Definition ----
@@ -167,6 +171,19 @@ namespace Trace {
             Core::DoorBell _doorBell;
         };
 
+        // A ring is owned by a single thread, so writing to it needs no lock. The Busy flag
+        // tells Close() it has to wait before the ring can be destroyed.
+        struct Ring {
+            TraceBuffer* Buffer;
+            std::atomic<bool> Busy;
+        };
+
+        // A record is written as a list of fragments, copied one by one straight into the ring.
+        struct Fragment {
+            const void* Data;
+            uint16_t Length;
+        };
+
     protected:
         TraceUnit();
 
@@ -193,6 +210,42 @@ namespace Trace {
 
         void Trace(const char fileName[], const uint32_t lineNumber, const char className[], const ITrace* const information);
 
+        // Compact records: a call site registers its static information, including the format,
+        // once and traces with the returned identifier and the raw arguments of the format. The
+        // text is formatted by the reader.
+        uint32_t Register(const char fileName[], const uint32_t lineNumber, const char className[], const char module[], const char category[], const char format[]);
+
+        template <typename... ARGUMENTS>
+        void Trace(const uint32_t site, const ARGUMENTS&... arguments)
+        {
+            const bool writable = m_Writable.load();
+
+            if ((writable == true) || (m_DirectOut == true)) {
+                const uint64_t current = Core::Time::Now().Ticks();
+                const uint32_t marker = (CompactRecord | site);
+                uint8_t entry[TRACINGBUFFERSIZE];
+                uint16_t length = 2 + 8 + 4;
+
+                Encode(entry, length, arguments...);
+
+                if (writable == true) {
+                    ::memcpy(&(entry[0]), &length, 2);
+                    ::memcpy(&(entry[2]), &current, 8);
+                    ::memcpy(&(entry[10]), &marker, 4);
+
+                    const Fragment record = { entry, length };
+
+                    Write(&record, 1, length);
+                }
+
+                if (m_DirectOut == true) {
+                    Print(site, &(entry[2 + 8 + 4]), length - (2 + 8 + 4));
+                }
+            }
+        }
+
+        // The shared ring only. Threads that claimed a ring of their own write to the rings next to
+        // it, use a TraceReader to get the records of all of them.
         inline Core::CyclicBuffer* CyclicBuffer()
         {
             return (m_OutputChannel);
@@ -223,24 +276,190 @@ namespace Trace {
 		}
 
     private:
-        inline uint32_t Open(const string& doorBell, const string& fileName) 
+        // Arguments of a compact record: a type, 'd' for integers and pointers, 'f' for floating
+        // points and 's' for strings. Values follow with their size in bytes, so the reader can
+        // narrow them the way printf would, strings with their length. Arguments that do not fit
+        // are dropped.
+        inline static void Encode(uint8_t[], uint16_t&)
         {
-            ASSERT(m_OutputChannel == nullptr);
-
-            m_OutputChannel = new TraceBuffer(doorBell, fileName);
-
-            ASSERT(m_OutputChannel->IsValid() == true);
-
-            return (m_OutputChannel->IsValid() ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
         }
+        template <typename FIRST, typename... REST>
+        inline static void Encode(uint8_t entry[], uint16_t& length, const FIRST& first, const REST&... rest)
+        {
+            Argument(entry, length, first);
+            Encode(entry, length, rest...);
+        }
+        template <typename TYPE>
+        inline static typename std::enable_if<(std::is_integral<TYPE>::value || std::is_enum<TYPE>::value), void>::type
+        Argument(uint8_t entry[], uint16_t& length, const TYPE value)
+        {
+            static_assert(sizeof(TYPE) <= sizeof(uint64_t), "Integers of more than 64 bits can not be traced");
+            Value(entry, length, 'd', &value, sizeof(TYPE));
+        }
+        template <typename TYPE>
+        inline static typename std::enable_if<std::is_floating_point<TYPE>::value, void>::type
+        Argument(uint8_t entry[], uint16_t& length, const TYPE value)
+        {
+            const double converted = static_cast<double>(value);
+            Value(entry, length, 'f', &converted, sizeof(converted));
+        }
+        template <typename TYPE>
+        inline static void Argument(uint8_t entry[], uint16_t& length, const TYPE* value)
+        {
+            const uintptr_t address = reinterpret_cast<uintptr_t>(value);
+            Value(entry, length, 'd', &address, sizeof(address));
+        }
+        inline static void Argument(uint8_t entry[], uint16_t& length, const char value[])
+        {
+            Text(entry, length, (value != nullptr ? value : "(null)"), (value != nullptr ? static_cast<uint16_t>(::strlen(value)) : 6));
+        }
+        inline static void Argument(uint8_t entry[], uint16_t& length, const std::string& value)
+        {
+            Text(entry, length, value.c_str(), static_cast<uint16_t>(value.length()));
+        }
+        inline static void Value(uint8_t entry[], uint16_t& length, const uint8_t type, const void* value, const uint8_t size)
+        {
+            if ((length + 2 + size) <= TRACINGBUFFERSIZE) {
+                entry[length] = type;
+                entry[length + 1] = size;
+                ::memcpy(&(entry[length + 2]), value, size);
+                length += (2 + size);
+            }
+        }
+        inline static void Text(uint8_t entry[], uint16_t& length, const char text[], const uint16_t textLength)
+        {
+            if ((length + 1 + 2) <= TRACINGBUFFERSIZE) {
+                const uint16_t copied = std::min(textLength, static_cast<uint16_t>(TRACINGBUFFERSIZE - length - 1 - 2));
+                entry[length] = 's';
+                ::memcpy(&(entry[length + 1]), &copied, 2);
+                ::memcpy(&(entry[length + 3]), text, copied);
+                length += (1 + 2 + copied);
+            }
+        }
+
+        uint32_t Open(const string& doorBell, const string& fileName);
         void UpdateEnabledCategories(const Core::JSON::ArrayType<Setting::JSON>& info);
+        TraceBuffer* Create(const uint8_t slot);
+        void Print(const uint32_t site, const uint8_t arguments[], const uint16_t length);
+        void Write(const Fragment fragments[], const uint8_t count, const uint16_t length);
+        static void Write(TraceBuffer& buffer, const Fragment fragments[], const uint8_t count, const uint16_t length);
 
         TraceControlList m_Categories;
         Core::CriticalSection m_Admin;
         TraceBuffer* m_OutputChannel;
+        Ring m_Rings[CyclicBufferRings];
+        std::atomic<bool> m_Writable;
+        string m_DoorBell;
+        string m_FileName;
+        std::vector<string> m_Sites;
+        Core::File m_Metadata;
         Settings m_EnabledCategories;
         bool m_DirectOut;
     };
+
+    // Reads the trace records of a process: the shared ring (fileName) and the rings of its
+    // threads (fileName_<n>). Records are handed out in the order they were traced.
+    class EXTERNAL TraceReader {
+    public:
+        struct Entry {
+            uint64_t Ticks;
+            uint32_t Line;
+            string File;
+            string ClassName;
+            string Module;
+            string Category;
+            string Text;
+        };
+
+    private:
+        TraceReader() = delete;
+        TraceReader(const TraceReader&) = delete;
+        TraceReader& operator=(const TraceReader&) = delete;
+
+        struct Site {
+            uint32_t Line;
+            string File;
+            string ClassName;
+            string Module;
+            string Category;
+            string Format;
+        };
+
+        class Ring : public Core::CyclicBuffer {
+        private:
+            Ring() = delete;
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+        public:
+            Ring(const string& fileName);
+            ~Ring();
+
+        public:
+            inline bool IsStaged() const
+            {
+                return (_length != 0);
+            }
+            inline uint64_t Ticks() const
+            {
+                uint64_t ticks;
+                ::memcpy(&ticks, &(_record[2]), sizeof(ticks));
+                return (ticks);
+            }
+            bool Stage();
+            uint16_t Unstage(uint8_t buffer[], const uint16_t length);
+
+        private:
+            virtual uint32_t GetReadSize(Cursor& cursor) override;
+
+        private:
+            uint8_t _record[CyclicBufferSize];
+            uint16_t _length;
+        };
+
+    public:
+        TraceReader(const string& fileName);
+        ~TraceReader();
+
+    public:
+        // The name of a ring of the process tracing to fileName: index 0 is the shared ring, the
+        // others are the rings handed out to its threads.
+        static string RingName(const string& fileName, const uint8_t index);
+
+        inline bool IsValid() const
+        {
+            return (_rings[0] != nullptr);
+        }
+        inline uint8_t Rings() const
+        {
+            return (CyclicBufferRings + 1);
+        }
+        // The ring at the given index, or nullptr if the process did not create it (yet).
+        inline const Core::CyclicBuffer* Buffer(const uint8_t index) const
+        {
+            ASSERT(index < Rings());
+            return (_rings[index]);
+        }
+
+        // Returns the length of the oldest record available, copied into buffer, or 0 if
+        // none of the rings hold a record.
+        uint16_t Read(uint8_t buffer[], const uint16_t length);
+
+        // Reads the oldest record available and decodes it, formatting the text of a compact record.
+        bool Read(Entry& entry);
+
+    private:
+        void Scan();
+        void Load();
+
+    private:
+        const string _fileName;
+        Ring* _rings[CyclicBufferRings + 1];
+        Core::File _metadata;
+        std::vector<uint8_t> _loaded;
+        uint32_t _parsed;
+        std::vector<Site> _sites;
+    };
 }
 } // namespace Trace
 
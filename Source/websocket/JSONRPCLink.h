@@ -54,6 +54,12 @@ namespace JSONRPC {
                     {
                         return (!operator==(rhs));
                     }
+                    uint32_t Hash() const
+                    {
+                        const uintptr_t address = reinterpret_cast<uintptr_t>(_client);
+
+                        return (static_cast<uint32_t>((address >> 4) ^ (static_cast<uint64_t>(address) >> 32)));
+                    }
     
                 public:
                     uint64_t Timed(const uint64_t scheduledTime) {
@@ -0,0 +1,307 @@
+#include "WebCache.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    static const TCHAR __BYTES[] = _T("bytes");
+
+    // What to do with the Range header of a request (RFC 7233).
+    enum rangeKind {
+        RANGE_IGNORE, // Not a single, well formed byte range, serve the whole file.
+        RANGE_SATISFIABLE,
+        RANGE_UNSATISFIABLE
+    };
+
+    // A number that does not fit 32 bits does not wrap, it sticks at the maximum. That is past the
+    // end of any file that can be cached, so a first byte that large can not be satisfied, and a
+    // last byte that large means the end of the file, as the RFC prescribes.
+    static const TCHAR* ParseNumber(const TCHAR* text, uint32_t& value)
+    {
+        value = 0;
+
+        while ((*text >= '0') && (*text <= '9')) {
+            const uint32_t digit = (*text - '0');
+
+            if (value > ((NUMBER_MAX_UNSIGNED(uint32_t) - digit) / 10)) {
+                value = NUMBER_MAX_UNSIGNED(uint32_t);
+            } else {
+                value = (value * 10) + digit;
+            }
+            text++;
+        }
+
+        return (text);
+    }
+
+    // Parses a single "bytes=<first>-<last>" range against a file of the given size. Multiple ranges,
+    // other units or anything else that is not well formed, are ignored and result in the full file.
+    static rangeKind ParseRange(const string& range, const uint32_t size, uint32_t& first, uint32_t& last)
+    {
+        rangeKind result = RANGE_IGNORE;
+        const uint32_t length = sizeof(__BYTES) / sizeof(TCHAR) - 1;
+
+        first = 0;
+        last = (size > 0 ? size - 1 : 0);
+
+        if ((range.length() > length) && (range.compare(0, length, __BYTES) == 0) && (range[length] == '=') && (range.find(',') == string::npos)) {
+            const TCHAR* text = &(range.c_str()[length + 1]);
+            const TCHAR* end;
+            uint32_t value;
+
+            if (*text == '-') {
+                // Suffix range, the last n bytes.
+                end = ParseNumber(&text[1], value);
+
+                if ((end != &text[1]) && (*end == '\0')) {
+                    if ((value == 0) || (size == 0)) {
+                        result = RANGE_UNSATISFIABLE;
+                    } else {
+                        if (value < size) {
+                            first = size - value;
+                        }
+                        result = RANGE_SATISFIABLE;
+                    }
+                }
+            } else {
+                end = ParseNumber(text, value);
+
+                if ((end != text) && (*end == '-')) {
+                    const uint32_t start = value;
+
+                    text = &end[1];
+                    end = ParseNumber(text, value);
+
+                    // A last byte before the first one makes the range invalid, not unsatisfiable.
+                    if ((*end == '\0') && ((end == text) || (value >= start))) {
+                        if (start >= size) {
+                            result = RANGE_UNSATISFIABLE;
+                        } else {
+                            first = start;
+                            if ((end != text) && (value < last)) {
+                                last = value;
+                            }
+                            result = RANGE_SATISFIABLE;
+                        }
+                    }
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    static string MakeTag(const std::string& data, const uint64_t modified)
+    {
+        // FNV-1a over the content, combined with the modification time, is plenty to tell versions apart.
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (const char c : data) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+        }
+
+        const uint64_t tag[2] = { hash, modified };
+        string result;
+
+        Core::ToHexString(reinterpret_cast<const uint8_t*>(tag), sizeof(tag), result);
+
+        return (_T('"') + result + _T('"'));
+    }
+
+    FileCache::Content::Content(const string& fileName)
+        : _size(0)
+        , _modified()
+        , _plain()
+        , _compressed()
+        , _tag()
+        , _compressedTag()
+    {
+        Core::File source(fileName);
+
+        _size = source.Size();
+        _modified = source.ModificationTime();
+
+        if (source.Open(true) == true) {
+            _plain.resize(static_cast<size_t>(_size));
+
+            if (source.Read(reinterpret_cast<uint8_t*>(&_plain[0]), static_cast<uint32_t>(_size)) != _size) {
+                _plain.clear();
+            } else {
+                _tag = MakeTag(_plain, _modified.Ticks());
+
+                Compress();
+            }
+
+            source.Close();
+        }
+    }
+
+    void FileCache::Content::Compress()
+    {
+        z_stream stream;
+
+        ::memset(&stream, 0, sizeof(stream));
+
+        // A window of 15 bits, offset by 16 to get a gzip header and trailer.
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+            _compressed.resize(deflateBound(&stream, static_cast<uLong>(_plain.length())));
+
+            stream.next_in = reinterpret_cast<Bytef*>(&_plain[0]);
+            stream.avail_in = static_cast<uInt>(_plain.length());
+            stream.next_out = reinterpret_cast<Bytef*>(&_compressed[0]);
+            stream.avail_out = static_cast<uInt>(_compressed.length());
+
+            // Only keep the compressed variant if it saves at least 10 percent.
+            if ((deflate(&stream, Z_FINISH) == Z_STREAM_END) && (stream.total_out < ((_plain.length() * 9) / 10))) {
+                _compressed.resize(stream.total_out);
+                _compressed.shrink_to_fit();
+                _compressedTag = _tag;
+                _compressedTag.insert(_compressedTag.length() - 1, _T("-gz"));
+            } else {
+                _compressed.clear();
+                _compressed.shrink_to_fit();
+            }
+
+            deflateEnd(&stream);
+        }
+    }
+
+    bool FileCache::Serve(const string& fileName, const Request& request, Response& response)
+    {
+        Core::ProxyType<Content> content(Find(fileName));
+
+        if (content.IsValid() == true) {
+            const uint32_t size = static_cast<uint32_t>(content->Data(false).length());
+            uint32_t first = 0, last = 0;
+            const rangeKind range = (request.Range.IsSet() == true ? ParseRange(request.Range.Value(), size, first, last) : RANGE_IGNORE);
+            const bool ranged = (range != RANGE_IGNORE);
+            const bool compressed = ((ranged == false) && (content->HasCompressed() == true) && (request.AcceptEncoding.IsSet() == true) && (request.AcceptEncoding.Value() == ENCODING_GZIP));
+            const string& tag(content->Tag(compressed));
+
+            response.ETag = tag;
+            response.Modified = content->Modified();
+            response.AcceptRange = __BYTES;
+
+            if (content->HasCompressed() == true) {
+                // Caches in between must not hand out one variant to a client that asked for the other.
+                response.Vary = _T("Accept-Encoding");
+            }
+
+            if ((request.IfNoneMatch.IsSet() == true) && ((request.IfNoneMatch.Value() == _T("*")) || (request.IfNoneMatch.Value().find(tag) != string::npos))) {
+                response.ErrorCode = STATUS_NOT_MODIFIED;
+                response.Message = _T("Not Modified");
+            } else if (ranged == true) {
+                if (range == RANGE_UNSATISFIABLE) {
+                    response.ErrorCode = STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                    response.Message = _T("Requested Range Not Satisfiable");
+                    response.ContentRange = string(__BYTES) + _T(" */") + Core::NumberType<uint32_t>(size).Text();
+                } else {
+                    response.ErrorCode = STATUS_PARTIAL_CONTENT;
+                    response.Message = _T("Partial Content");
+                    response.ContentRange = string(__BYTES) + ' ' + Core::NumberType<uint32_t>(first).Text() + '-' + Core::NumberType<uint32_t>(last).Text() + '/' + Core::NumberType<uint32_t>(size).Text();
+                    response.Body<Body>(Core::ProxyType<Body>::Create(content, false, first, (last - first) + 1));
+                }
+            } else {
+                if (compressed == true) {
+                    response.ContentEncoding = ENCODING_GZIP;
+                }
+                response.Body<Body>(Core::ProxyType<Body>::Create(content, compressed, 0, static_cast<uint32_t>(content->Data(compressed).length())));
+            }
+        }
+
+        return (content.IsValid());
+    }
+
+    void FileCache::Clear()
+    {
+        _adminLock.Lock();
+
+        _index.clear();
+        _entries.clear();
+        _size = 0;
+
+        _adminLock.Unlock();
+    }
+
+    Core::ProxyType<FileCache::Content> FileCache::Find(const string& fileName)
+    {
+        Core::ProxyType<Content> result;
+        Core::ProxyType<Content> cached;
+        const uint64_t now = Core::Time::Now().Ticks();
+
+        _adminLock.Lock();
+
+        EntryMap::iterator index(_index.find(fileName));
+
+        if (index != _index.end()) {
+            if ((now - index->second->Checked) < (ValidationPeriod * Core::Time::TicksPerMillisecond)) {
+                // Recently validated, serve it straight from memory.
+                _entries.splice(_entries.begin(), _entries, index->second);
+                result = index->second->Data;
+            } else {
+                cached = index->second->Data;
+            }
+        }
+
+        _adminLock.Unlock();
+
+        if (result.IsValid() == false) {
+            // Reading and compressing a file takes time, do not keep other requests waiting for it.
+            Core::File file(fileName);
+
+            if ((file.Exists() == true) && (file.IsDirectory() == false) && (file.Size() <= MaxFileSize)) {
+                if ((cached.IsValid() == true) && (cached->IsSame(file) == true)) {
+                    result = cached;
+                } else {
+                    result = Core::ProxyType<Content>::Create(fileName);
+
+                    if (result->IsValid() == false) {
+                        result.Release();
+                    }
+                }
+            }
+
+            _adminLock.Lock();
+
+            // Look it up again, the entry might have changed while the lock was released.
+            index = _index.find(fileName);
+
+            if ((index != _index.end()) && (result != index->second->Data)) {
+                // The file changed, is gone, or is no longer cacheable.
+                _size -= index->second->Data->Size();
+                _entries.erase(index->second);
+                _index.erase(index);
+                index = _index.end();
+            }
+
+            if (result.IsValid() == true) {
+                if (index == _index.end()) {
+                    _entries.push_front({ fileName, result, now });
+                    _index.emplace(fileName, _entries.begin());
+                    _size += result->Size();
+
+                    Evict();
+                } else {
+                    _entries.splice(_entries.begin(), _entries, index->second);
+                    index->second->Checked = now;
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+
+        return (result);
+    }
+
+    void FileCache::Evict()
+    {
+        // Drop the least recently used files until the cache fits, but always keep the latest one.
+        while ((_size > _capacity) && (_entries.size() > 1)) {
+            Entry& entry(_entries.back());
+
+            _size -= entry.Data->Size();
+            _index.erase(entry.Name);
+            _entries.pop_back();
+        }
+    }
+}
+}
@@ -0,0 +1,195 @@
+#ifndef __WEBCACHE_H
+#define __WEBCACHE_H
+
+#include "Module.h"
+#include "WebRequest.h"
+#include "WebResponse.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    // Keeps the content of small, frequently requested static files in memory, together with their
+    // entity tag and, if it pays off, a gzip compressed variant. Plain, conditional (If-None-Match)
+    // and partial (Range) requests for a cached file are answered without touching the disk. Files
+    // that do not fit the cache are left to the caller, who can stream them with a FileBody.
+    class EXTERNAL FileCache {
+    public:
+        static constexpr uint32_t MaxFileSize = 256 * 1024;
+        static constexpr uint32_t DefaultCapacity = 8 * 1024 * 1024;
+
+        // Within this period a cached file is trusted without checking its modification time.
+        static constexpr uint32_t ValidationPeriod = 1000; // ms
+
+    private:
+        class Content {
+        private:
+            Content() = delete;
+            Content(const Content&) = delete;
+            Content& operator=(const Content&) = delete;
+
+        public:
+            Content(const string& fileName);
+            ~Content()
+            {
+            }
+
+        public:
+            inline bool IsValid() const
+            {
+                return ((_tag.empty() == false) && (_plain.length() == _size));
+            }
+            inline bool IsSame(const Core::File& file) const
+            {
+                return ((file.Size() == _size) && (file.ModificationTime() == _modified));
+            }
+            inline uint32_t Size() const
+            {
+                return (static_cast<uint32_t>(_plain.length() + _compressed.length()));
+            }
+            inline const Core::Time& Modified() const
+            {
+                return (_modified);
+            }
+            inline const string& Tag(const bool compressed) const
+            {
+                return (compressed == true ? _compressedTag : _tag);
+            }
+            inline const std::string& Data(const bool compressed) const
+            {
+                return (compressed == true ? _compressed : _plain);
+            }
+            inline bool HasCompressed() const
+            {
+                return (_compressed.empty() == false);
+            }
+
+        private:
+            void Compress();
+
+        private:
+            uint64_t _size;
+            Core::Time _modified;
+            std::string _plain;
+            std::string _compressed;
+            string _tag;
+            string _compressedTag;
+        };
+
+        struct Entry {
+            string Name;
+            Core::ProxyType<Content> Data;
+            uint64_t Checked;
+        };
+
+        typedef std::list<Entry> EntryList;
+        typedef std::unordered_map<string, EntryList::iterator> EntryMap;
+
+    public:
+        // Serializes a (part of a) cached file. The content is shared with the cache, so a body stays
+        // valid even if the file is evicted or reloaded while the response is being sent.
+        class EXTERNAL Body : public IBody {
+        private:
+            Body() = delete;
+            Body(const Body&) = delete;
+            Body& operator=(const Body&) = delete;
+
+        public:
+            Body(const Core::ProxyType<Content>& content, const bool compressed, const uint32_t offset, const uint32_t length)
+                : _content(content)
+                , _data(reinterpret_cast<const uint8_t*>(content->Data(compressed).data()) + offset)
+                , _length(length)
+                , _position(0)
+            {
+                ASSERT((offset + length) <= content->Data(compressed).length());
+            }
+            ~Body() override
+            {
+            }
+
+        protected:
+            uint32_t Serialize() const override
+            {
+                _position = 0;
+                return (_length);
+            }
+            uint32_t Deserialize() override
+            {
+                // Cached content is read-only.
+                return (0);
+            }
+            void Serialize(uint8_t stream[], const uint16_t maxLength) const override
+            {
+                uint32_t size = std::min(static_cast<uint32_t>(maxLength), _length - _position);
+
+                ::memcpy(stream, &(_data[_position]), size);
+                _position += size;
+            }
+            void Deserialize(const uint8_t[], const uint16_t) override
+            {
+                ASSERT(false);
+            }
+            void End() const override
+            {
+                _position = 0;
+            }
+
+        private:
+            Core::ProxyType<Content> _content;
+            const uint8_t* _data;
+            const uint32_t _length;
+            mutable uint32_t _position;
+        };
+
+    public:
+        FileCache(const FileCache&) = delete;
+        FileCache& operator=(const FileCache&) = delete;
+
+        FileCache()
+            : FileCache(DefaultCapacity)
+        {
+        }
+        FileCache(const uint32_t capacity)
+            : _adminLock()
+            , _capacity(capacity)
+            , _size(0)
+            , _entries()
+            , _index()
+        {
+        }
+        ~FileCache()
+        {
+            Clear();
+        }
+
+    public:
+        inline uint32_t Size() const
+        {
+            return (_size);
+        }
+        inline uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(_entries.size()));
+        }
+
+        // Fills in the response for the given file, honouring the If-None-Match, Range and
+        // Accept-Encoding headers of the request. Returns false if the file can not be served from
+        // the cache, in which case the response is left untouched.
+        bool Serve(const string& fileName, const Request& request, Response& response);
+
+        void Clear();
+
+    private:
+        Core::ProxyType<Content> Find(const string& fileName);
+        void Evict();
+
+    private:
+        Core::CriticalSection _adminLock;
+        const uint32_t _capacity;
+        uint32_t _size;
+        EntryList _entries;
+        EntryMap _index;
+    };
+}
+} // namespace Web
+
+#endif // __WEBCACHE_H
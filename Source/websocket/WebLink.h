@@ -204,16 +204,20 @@ namespace Web {
                 return (*this);
             }
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 _activity = true;
-                return (_parent.SendData(_parent, dataFrame, maxSendSize));
+                return (Core::Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                    return (_parent.SendData(_parent, &(dataFrame[offset]), size));
+                }));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 _activity = true;
-                return (_parent.ReceiveData(_parent, dataFrame, receivedSize));
+                return (Core::Chunked(receivedSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                    return (_parent.ReceiveData(_parent, &(dataFrame[offset]), size));
+                }));
             }
 
             // Signal a state change, Opened, Closed or Accepted
@@ -227,7 +227,9 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            IF_NONE_MATCH,
+            RANGE
         };
 
         enum type {
@@ -573,6 +575,8 @@ namespace Web {
             MX.Clear();
             ST.Clear();
             WebToken.Clear();
+            IfNoneMatch.Clear();
+            Range.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -610,6 +614,8 @@ namespace Web {
         Core::OptionalType<string> ST;
         Core::OptionalType<uint32_t> MX;
         Core::OptionalType<Authorization> WebToken;
+        Core::OptionalType<string> IfNoneMatch;
+        Core::OptionalType<string> Range;
 
         inline bool HasBody() const
         {
@@ -81,7 +81,10 @@ namespace Web {
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            CONTENT_RANGE,
+            WEBSOCKET_EXTENSIONS,
+            VARY
         };
 
         enum upgrade {
@@ -399,6 +402,9 @@ namespace Web {
             WakeUp.Clear();
             CacheControl.Clear();
             ApplicationURL.Clear();
+            ContentRange.Clear();
+            WebSocketExtensions.Clear();
+            Vary.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -435,6 +441,9 @@ namespace Web {
         Core::OptionalType<string> WebSocketProtocol;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
+        Core::OptionalType<string> ContentRange;
+        Core::OptionalType<string> WebSocketExtensions;
+        Core::OptionalType<string> Vary;
 
         inline bool HasBody() const
         {
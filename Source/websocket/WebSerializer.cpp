@@ -17,56 +17,60 @@ namespace Web {
 }
 }
 
-static const TCHAR __UNKNOWN[] = _T("UNKNOWN");
-static const TCHAR __WEBSOCKET[] = _T("WEBSOCKET");
-static const TCHAR __CONNECTION_UPGRADE[] = _T("UPGRADE");
-static const TCHAR __CONNECTION_CLOSE[] = _T("CLOSE");
-static const TCHAR __CONNECTION_KEEPALIVE[] = _T("KEEP-ALIVE");
-static const TCHAR __ENCODING_GZIP[] = _T("GZIP");
-
-static const TCHAR __HOST[] = _T("HOST:");
-static const TCHAR __UPGRADE[] = _T("UPGRADE:");
-static const TCHAR __ORIGIN[] = _T("ORIGIN:");
-static const TCHAR __CONNECTION[] = _T("CONNECTION:");
-static const TCHAR __ACCEPT[] = _T("ACCEPT:");
-static const TCHAR __ACCEPT_ENCODING[] = _T("ACCEPT-ENCODING:");
-static const TCHAR __USERAGENT[] = _T("USER-AGENT:");
-static const TCHAR __CONTENT_TYPE[] = _T("CONTENT-TYPE:");
-static const TCHAR __CONTENT_LENGTH[] = _T("CONTENT-LENGTH:");
-static const TCHAR __CONTENT_SIGNATURE[] = _T("CONTENT-HMAC:");
-static const TCHAR __CONTENT_ENCODING[] = _T("CONTENT-ENCODING:");
-static const TCHAR __ENCODING[] = _T("ACCEPT-ENCODING:");
-static const TCHAR __LANGUAGE[] = _T("ACCEPT-LANGUAGE:");
-static const TCHAR __ACCESS_CONTROL_REQUEST_METHOD[] = _T("ACCESS-CONTROL-REQUEST-METHOD:");
-static const TCHAR __ACCESS_CONTROL_REQUEST_HEADERS[] = _T("ACCESS-CONTROL-REQUEST-HEADERS:");
-static const TCHAR __TRANSFER_ENCODING[] = _T("TRANSFER-ENCODING:");
-static const TCHAR __ST[] = _T("ST:");
-static const TCHAR __MAN[] = _T("MAN:");
-static const TCHAR __MX[] = _T("MX:");
-static const TCHAR __AUTHORIZATION[] = _T("AUTHORIZATION:");
-
-static const TCHAR __DATE[] = _T("DATE:");
-static const TCHAR __SERVER[] = _T("SERVER:");
-static const TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
-static const TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
-static const TCHAR __ETAG[] = _T("ETAG:");
-static const TCHAR __ALLOW[] = _T("ALLOW:");
-static const TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
-static const TCHAR __WEBSOCKET_PROTOCOL[] = _T("SEC-WEBSOCKET-PROTOCOL:");
-static const TCHAR __WEBSOCKET_VERSION[] = _T("SEC-WEBSOCKET-VERSION:");
-static const TCHAR __WEBSOCKET_ACCEPT[] = _T("SEC-WEBSOCKET-ACCEPT:");
-static const TCHAR __WEBSOCKET_EXTENSIONS[] = _T("SEC-WEBSOCKET-EXTENSIONS:");
-static const TCHAR __ACCESS_CONTROL_ALLOW_METHODS[] = _T("ACCESS-CONTROL-ALLOW-METHODS:");
-static const TCHAR __ACCESS_CONTROL_ALLOW_ORIGIN[] = _T("ACCESS-CONTROL-ALLOW-ORIGIN:");
-static const TCHAR __ACCESS_CONTROL_ALLOW_HEADERS[] = _T("ACCESS-CONTROL-ALLOW-HEADERS:");
-static const TCHAR __ACCESS_CONTROL_MAX_AGE[] = _T("ACCESS-CONTROL-MAX-AGE:");
-static const TCHAR __USN[] = _T("USN:");
-static const TCHAR __LOCATION[] = _T("LOCATION:");
-static const TCHAR __WAKEUP[] = _T("WAKEUP:");
-static const TCHAR __CACHE_CONTROL[] = _T("CACHE-CONTROL:");
-static const TCHAR __APPLICATION_URL[] = _T("APPLICATION-URL:");
-
-static const TCHAR __CHARACTER_SET[] = _T("CHARSET=");
+static constexpr TCHAR __UNKNOWN[] = _T("UNKNOWN");
+static constexpr TCHAR __WEBSOCKET[] = _T("WEBSOCKET");
+static constexpr TCHAR __CONNECTION_UPGRADE[] = _T("UPGRADE");
+static constexpr TCHAR __CONNECTION_CLOSE[] = _T("CLOSE");
+static constexpr TCHAR __CONNECTION_KEEPALIVE[] = _T("KEEP-ALIVE");
+static constexpr TCHAR __ENCODING_GZIP[] = _T("GZIP");
+
+static constexpr TCHAR __HOST[] = _T("HOST:");
+static constexpr TCHAR __UPGRADE[] = _T("UPGRADE:");
+static constexpr TCHAR __ORIGIN[] = _T("ORIGIN:");
+static constexpr TCHAR __CONNECTION[] = _T("CONNECTION:");
+static constexpr TCHAR __ACCEPT[] = _T("ACCEPT:");
+static constexpr TCHAR __ACCEPT_ENCODING[] = _T("ACCEPT-ENCODING:");
+static constexpr TCHAR __USERAGENT[] = _T("USER-AGENT:");
+static constexpr TCHAR __CONTENT_TYPE[] = _T("CONTENT-TYPE:");
+static constexpr TCHAR __CONTENT_LENGTH[] = _T("CONTENT-LENGTH:");
+static constexpr TCHAR __CONTENT_SIGNATURE[] = _T("CONTENT-HMAC:");
+static constexpr TCHAR __CONTENT_ENCODING[] = _T("CONTENT-ENCODING:");
+static constexpr TCHAR __ENCODING[] = _T("ACCEPT-ENCODING:");
+static constexpr TCHAR __LANGUAGE[] = _T("ACCEPT-LANGUAGE:");
+static constexpr TCHAR __ACCESS_CONTROL_REQUEST_METHOD[] = _T("ACCESS-CONTROL-REQUEST-METHOD:");
+static constexpr TCHAR __ACCESS_CONTROL_REQUEST_HEADERS[] = _T("ACCESS-CONTROL-REQUEST-HEADERS:");
+static constexpr TCHAR __TRANSFER_ENCODING[] = _T("TRANSFER-ENCODING:");
+static constexpr TCHAR __ST[] = _T("ST:");
+static constexpr TCHAR __MAN[] = _T("MAN:");
+static constexpr TCHAR __MX[] = _T("MX:");
+static constexpr TCHAR __AUTHORIZATION[] = _T("AUTHORIZATION:");
+static constexpr TCHAR __IF_NONE_MATCH[] = _T("IF-NONE-MATCH:");
+static constexpr TCHAR __RANGE[] = _T("RANGE:");
+
+static constexpr TCHAR __DATE[] = _T("DATE:");
+static constexpr TCHAR __SERVER[] = _T("SERVER:");
+static constexpr TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
+static constexpr TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
+static constexpr TCHAR __ETAG[] = _T("ETAG:");
+static constexpr TCHAR __ALLOW[] = _T("ALLOW:");
+static constexpr TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
+static constexpr TCHAR __WEBSOCKET_PROTOCOL[] = _T("SEC-WEBSOCKET-PROTOCOL:");
+static constexpr TCHAR __WEBSOCKET_VERSION[] = _T("SEC-WEBSOCKET-VERSION:");
+static constexpr TCHAR __WEBSOCKET_ACCEPT[] = _T("SEC-WEBSOCKET-ACCEPT:");
+static constexpr TCHAR __WEBSOCKET_EXTENSIONS[] = _T("SEC-WEBSOCKET-EXTENSIONS:");
+static constexpr TCHAR __ACCESS_CONTROL_ALLOW_METHODS[] = _T("ACCESS-CONTROL-ALLOW-METHODS:");
+static constexpr TCHAR __ACCESS_CONTROL_ALLOW_ORIGIN[] = _T("ACCESS-CONTROL-ALLOW-ORIGIN:");
+static constexpr TCHAR __ACCESS_CONTROL_ALLOW_HEADERS[] = _T("ACCESS-CONTROL-ALLOW-HEADERS:");
+static constexpr TCHAR __ACCESS_CONTROL_MAX_AGE[] = _T("ACCESS-CONTROL-MAX-AGE:");
+static constexpr TCHAR __USN[] = _T("USN:");
+static constexpr TCHAR __LOCATION[] = _T("LOCATION:");
+static constexpr TCHAR __WAKEUP[] = _T("WAKEUP:");
+static constexpr TCHAR __CACHE_CONTROL[] = _T("CACHE-CONTROL:");
+static constexpr TCHAR __APPLICATION_URL[] = _T("APPLICATION-URL:");
+static constexpr TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
+static constexpr TCHAR __VARY[] = _T("VARY:");
+
+static constexpr TCHAR __CHARACTER_SET[] = _T("CHARSET=");
 
 #define __TXT(KeyWord) KeyWord, (sizeof(KeyWord) / sizeof(TCHAR)) - 1
 
@@ -208,10 +212,13 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::IF_NONE_MATCH, __TXT(__IF_NONE_MATCH) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -258,6 +265,9 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
+    { Web::Response::VARY, __TXT(__VARY) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -451,6 +461,74 @@ namespace Web
         authorization = string(enumValue.Data()) + ' ' + input.Token();
     }
 
+    // Responses sent within the same second carry the same Date, so every thread only formats it
+    // once per second.
+    static const string& DateText(const Core::Time& time)
+    {
+        static thread_local uint64_t second = ~0;
+        static thread_local string text;
+
+        const uint64_t current = time.Ticks() / (Core::Time::TicksPerMillisecond * 1000);
+
+        if (current != second) {
+            text = time.ToRFC1123(false);
+            second = current;
+        }
+
+        return (text);
+    }
+
+    // Header names are case insensitive. The characters allowed in a name only differ from their
+    // lower case variant in bit 5, so setting it folds the case without a conversion table.
+    static constexpr uint32_t HeaderHash(const TCHAR name[], const uint32_t hash = 2166136261u)
+    {
+        return (*name == '\0' ? hash : HeaderHash(&name[1], (hash ^ (static_cast<uint8_t>(*name) | 0x20)) * 16777619u));
+    }
+
+    // Resolves a request header name, including its ':', as it is found in the receive buffer. The
+    // hash selects the only candidate, which is than verified, no (upper case) copy is required.
+    static bool ToKeyword(const string& name, Request::keywords& keyword)
+    {
+        const TCHAR* text = nullptr;
+        uint32_t hash = 2166136261u;
+
+        for (const TCHAR character : name) {
+            hash = (hash ^ (static_cast<uint8_t>(character) | 0x20)) * 16777619u;
+        }
+
+        // ENCODING shares its name with ACCEPT_ENCODING, only the latter one is ever matched.
+        switch (hash) {
+        case HeaderHash(__HOST): keyword = Request::HOST; text = __HOST; break;
+        case HeaderHash(__UPGRADE): keyword = Request::UPGRADE; text = __UPGRADE; break;
+        case HeaderHash(__ORIGIN): keyword = Request::ORIGIN; text = __ORIGIN; break;
+        case HeaderHash(__CONNECTION): keyword = Request::CONNECTION; text = __CONNECTION; break;
+        case HeaderHash(__ACCEPT): keyword = Request::ACCEPT; text = __ACCEPT; break;
+        case HeaderHash(__ACCEPT_ENCODING): keyword = Request::ACCEPT_ENCODING; text = __ACCEPT_ENCODING; break;
+        case HeaderHash(__USERAGENT): keyword = Request::USERAGENT; text = __USERAGENT; break;
+        case HeaderHash(__CONTENT_TYPE): keyword = Request::CONTENT_TYPE; text = __CONTENT_TYPE; break;
+        case HeaderHash(__CONTENT_ENCODING): keyword = Request::CONTENT_ENCODING; text = __CONTENT_ENCODING; break;
+        case HeaderHash(__CONTENT_LENGTH): keyword = Request::CONTENT_LENGTH; text = __CONTENT_LENGTH; break;
+        case HeaderHash(__CONTENT_SIGNATURE): keyword = Request::CONTENT_SIGNATURE; text = __CONTENT_SIGNATURE; break;
+        case HeaderHash(__TRANSFER_ENCODING): keyword = Request::TRANSFER_ENCODING; text = __TRANSFER_ENCODING; break;
+        case HeaderHash(__LANGUAGE): keyword = Request::LANGUAGE; text = __LANGUAGE; break;
+        case HeaderHash(__ACCESS_CONTROL_REQUEST_METHOD): keyword = Request::ACCESS_CONTROL_REQUEST_METHOD; text = __ACCESS_CONTROL_REQUEST_METHOD; break;
+        case HeaderHash(__ACCESS_CONTROL_REQUEST_HEADERS): keyword = Request::ACCESS_CONTROL_REQUEST_HEADERS; text = __ACCESS_CONTROL_REQUEST_HEADERS; break;
+        case HeaderHash(__WEBSOCKET_KEY): keyword = Request::WEBSOCKET_KEY; text = __WEBSOCKET_KEY; break;
+        case HeaderHash(__WEBSOCKET_PROTOCOL): keyword = Request::WEBSOCKET_PROTOCOL; text = __WEBSOCKET_PROTOCOL; break;
+        case HeaderHash(__WEBSOCKET_VERSION): keyword = Request::WEBSOCKET_VERSION; text = __WEBSOCKET_VERSION; break;
+        case HeaderHash(__WEBSOCKET_EXTENSIONS): keyword = Request::WEBSOCKET_EXTENSIONS; text = __WEBSOCKET_EXTENSIONS; break;
+        case HeaderHash(__MAN): keyword = Request::MAN; text = __MAN; break;
+        case HeaderHash(__MX): keyword = Request::M_X; text = __MX; break;
+        case HeaderHash(__ST): keyword = Request::S_T; text = __ST; break;
+        case HeaderHash(__AUTHORIZATION): keyword = Request::AUTHORIZATION; text = __AUTHORIZATION; break;
+        case HeaderHash(__IF_NONE_MATCH): keyword = Request::IF_NONE_MATCH; text = __IF_NONE_MATCH; break;
+        case HeaderHash(__RANGE): keyword = Request::RANGE; text = __RANGE; break;
+        default: break;
+        }
+
+        return ((text != nullptr) && (_tcslen(text) == name.length()) && (_tcsnicmp(text, name.c_str(), name.length()) == 0));
+    }
+
 
     static void ParseContentType(const string& text, Core::OptionalType<MIMETypes>& mime, Core::OptionalType<CharacterTypes>& charType)
     {
@@ -789,15 +867,25 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __AUTHORIZATION : _T("Authorization:"));
                             FromAuthorization(_current->WebToken.Value(), _value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 22) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 23 : 24);
+                        } else if ((_keyIndex <= 22) && (_current->IfNoneMatch.IsSet() == true)) {
+                            _keyIndex = 23;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __IF_NONE_MATCH : _T("If-None-Match:"));
+                            _value = _current->IfNoneMatch.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 23) && (_current->Range.IsSet() == true)) {
+                            _keyIndex = 24;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __RANGE : _T("Range:"));
+                            _value = _current->Range.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 24) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 25 : 26);
 
                             Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
                             number.Serialize(_value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (_current->ContentSignature.IsSet() == true)) {
-                            _keyIndex = 24;
+                        } else if ((_keyIndex <= 25) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 26;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -1015,7 +1103,7 @@ namespace Web
                         } else if ((_keyIndex <= 1) && (_current->Date.IsSet() == true)) {
                             _keyIndex = 2;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __DATE : _T("Date:"));
-                            _value = _current->Date.Value().ToRFC1123(false);
+                            _value = DateText(_current->Date.Value());
                             _offset = 0;
                         } else if ((_keyIndex <= 2) && (_current->Modified.IsSet() == true)) {
                             _keyIndex = 3;
@@ -1168,15 +1256,30 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __APPLICATION_URL : _T("Application-URL:"));
                             _value = _current->ApplicationURL.Value().Text().Text();
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 24 : 25);
+                        } else if ((_keyIndex <= 23) && (_current->ContentRange.IsSet() == true)) {
+                            _keyIndex = 24;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 24) && (_current->WebSocketExtensions.IsSet() == true)) {
+                            _keyIndex = 25;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 25) && (_current->Vary.IsSet() == true)) {
+                            _keyIndex = 26;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __VARY : _T("Vary:"));
+                            _value = _current->Vary.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 27 : 28);
 
                             Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
                             number.Serialize(_value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 24) && (_current->ContentSignature.IsSet() == true)) {
-                            _keyIndex = 25;
+                        } else if ((_keyIndex <= 27) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 28;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -1296,8 +1399,7 @@ namespace Web
 
     void Request::Deserializer::Parse(const string& buffer)
     {
-
-        _lock.Lock();
+        // Only called by the parser, from Deserialize, so the lock is already taken.
 
         // Word complete check and set......
         switch (_state) {
@@ -1403,13 +1505,11 @@ namespace Web
                 }
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Request::keywords> keyWord(buffer.c_str(), true);
-                if (keyWord.IsSet() == false) {
+                if (ToKeyword(buffer, _keyWord) == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
                 } else {
                     // Seems like we have a hit. Collect a new entry and start setting it.
-                    _keyWord = keyWord.Value();
                     _parser.CollectLine();
                     _state = PAIR_VALUE;
                 }
@@ -1460,6 +1560,12 @@ namespace Web
             case Request::AUTHORIZATION:
                 _current->WebToken = ToAuthorization(buffer);
                 break;
+            case Request::IF_NONE_MATCH:
+                _current->IfNoneMatch = buffer;
+                break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1566,8 +1672,6 @@ namespace Web
         case BODY_END:
             break;
         }
-
-        _lock.Unlock();
     }
 
     void Request::Deserializer::EndOfPassThrough()
@@ -1611,7 +1715,7 @@ namespace Web
             _state = PAIR_KEY;
         }
         case PAIR_KEY: {
-            _parser.CollectWord(':', Parser::UPPERCASE);
+            _parser.CollectWord(':');
             break;
         }
         case CHUNK_END: {
@@ -1819,6 +1923,15 @@ namespace Web
             case Response::CACHE_CONTROL:
                 _current->CacheControl = buffer;
                 break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
+            case Response::VARY:
+                _current->Vary = buffer;
+                break;
             case Response::CONTENT_TYPE:
                 ParseContentType(buffer, _current->ContentType, _current->ContentCharacterSet);
                 break;
@@ -1,5 +1,23 @@
 #include "WebSocketLink.h"
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#include <immintrin.h>
+// Each x86 kernel is compiled for its own instruction set and only selected if the CPU has it.
+#define MASK_SSE2 __attribute__((target("sse2")))
+#define MASK_AVX2 __attribute__((target("avx2")))
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MASK_SSE2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#if defined(__LINUX__) && defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
@@ -18,11 +36,449 @@ namespace Web {
 
         static const uint8_t CONTINUATION_FRAME = 0x00;
         static const uint8_t FINISHING_FRAME = 0x80;
+        static const uint8_t COMPRESSED_FRAME = 0x40;
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
         static const uint8_t HandShakeKey[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
+        static const TCHAR PerMessageDeflate[] = _T("permessage-deflate");
+        static const TCHAR ServerNoContextTakeover[] = _T("server_no_context_takeover");
+        static const TCHAR ClientNoContextTakeover[] = _T("client_no_context_takeover");
+        static const TCHAR ServerMaxWindowBits[] = _T("server_max_window_bits");
+        static const TCHAR ClientMaxWindowBits[] = _T("client_max_window_bits");
+
+        // The tail every flushed deflate block ends with, it is not send over the wire (RFC 7692, 7.2.1).
+        static const uint8_t DeflateTail[] = { 0x00, 0x00, 0xFF, 0xFF };
+
+        class Protocol::Deflate {
+        private:
+            Deflate() = delete;
+            Deflate(const Deflate&) = delete;
+            Deflate& operator=(const Deflate&) = delete;
+
+            static constexpr uint16_t InflateSize = 1024;
+
+        public:
+            Deflate(const uint8_t windowBits, const bool sendReset, const bool receiveReset)
+                : _sendReset(sendReset)
+                , _receiveReset(receiveReset)
+                , _active(false)
+                , _last(false)
+                , _inflating(false)
+                , _valid(false)
+                , _pending(false)
+                , _held(0)
+                , _tail(0)
+                , _input()
+            {
+                ::memset(&_deflate, 0, sizeof(_deflate));
+                ::memset(&_inflate, 0, sizeof(_inflate));
+
+                // Negative window bits select a raw deflate stream, no zlib or gzip wrapper.
+                _valid = ((deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK) && (inflateInit2(&_inflate, -MAX_WBITS) == Z_OK));
+            }
+            ~Deflate()
+            {
+                deflateEnd(&_deflate);
+                inflateEnd(&_inflate);
+            }
+
+        public:
+            inline bool IsValid() const
+            {
+                return (_valid);
+            }
+            inline bool IsActive() const
+            {
+                return (_active);
+            }
+            inline bool IsHungry() const
+            {
+                return ((_active == true) && (_last == false) && (_deflate.avail_in == 0));
+            }
+            inline bool IsInflating() const
+            {
+                return (_inflating);
+            }
+            inline void Inflating(const bool inflating)
+            {
+                _inflating = inflating;
+            }
+            inline uint8_t* Buffer(const uint32_t size)
+            {
+                if (_input.size() < size) {
+                    _input.resize(size);
+                }
+                return (_input.data());
+            }
+            inline uint8_t* Inflated()
+            {
+                return (_output);
+            }
+            void Input(const uint8_t data[], const uint32_t length, const bool last)
+            {
+                uint8_t* buffer = Buffer(length);
+
+                if (data != buffer) {
+                    ::memcpy(buffer, data, length);
+                }
+
+                _active = true;
+                _last = last;
+                _deflate.next_in = buffer;
+                _deflate.avail_in = length;
+            }
+            uint32_t Output(uint8_t* payload, const uint32_t maxLength, bool& final)
+            {
+                ASSERT(maxLength >= _held);
+
+                // Whatever we held back last time, might turn out not to be the tail after all.
+                ::memcpy(payload, _heldBytes, _held);
+
+                _deflate.next_out = &(payload[_held]);
+                _deflate.avail_out = maxLength - _held;
+
+                deflate(&_deflate, (_last == true ? Z_SYNC_FLUSH : Z_NO_FLUSH));
+
+                uint32_t length = static_cast<uint32_t>(maxLength - _deflate.avail_out);
+
+                // The flush is complete if the output did not fill up all space.
+                final = ((_last == true) && (_deflate.avail_in == 0) && (_deflate.avail_out != 0));
+
+                if (final == true) {
+                    ASSERT((length >= sizeof(DeflateTail)) && (::memcmp(&(payload[length - sizeof(DeflateTail)]), DeflateTail, sizeof(DeflateTail)) == 0));
+
+                    length -= sizeof(DeflateTail);
+                    _held = 0;
+                    _active = false;
+
+                    if (_sendReset == true) {
+                        deflateReset(&_deflate);
+                    }
+                } else {
+                    // The last bytes might be the tail, keep them until we know..
+                    _held = static_cast<uint8_t>(std::min(length, static_cast<uint32_t>(sizeof(_heldBytes))));
+                    length -= _held;
+                    ::memcpy(_heldBytes, &(payload[length]), _held);
+                }
+
+                return (length);
+            }
+            uint16_t Inflate(const uint8_t payload[], const uint32_t length, uint32_t& offset, const bool final)
+            {
+                uint16_t result = 0;
+
+                while ((result == 0) && ((offset < length) || (_pending == true) || ((final == true) && (_tail < sizeof(DeflateTail))))) {
+                    // Once the payload is consumed, the tail we left out is added to complete the message.
+                    const bool tail = ((offset >= length) && (final == true) && (_tail < sizeof(DeflateTail)));
+                    uint32_t size = (tail == true ? static_cast<uint32_t>(sizeof(DeflateTail) - _tail) : (length - offset));
+
+                    _inflate.next_in = const_cast<uint8_t*>(tail == true ? &(DeflateTail[_tail]) : &(payload[offset]));
+                    _inflate.avail_in = size;
+                    _inflate.next_out = _output;
+                    _inflate.avail_out = sizeof(_output);
+
+                    int status = inflate(&_inflate, Z_SYNC_FLUSH);
+
+                    if ((status != Z_OK) && (status != Z_BUF_ERROR) && (status != Z_STREAM_END)) {
+                        TRACE_L1("Could not inflate a compressed message (%d), dropping it.", status);
+                        inflateReset(&_inflate);
+                        offset = length;
+                        _tail = sizeof(DeflateTail);
+                        _pending = false;
+                    } else {
+                        size -= static_cast<uint32_t>(_inflate.avail_in);
+
+                        if (tail == true) {
+                            _tail += static_cast<uint8_t>(size);
+                        } else {
+                            offset += size;
+                        }
+                        result = static_cast<uint16_t>(sizeof(_output) - _inflate.avail_out);
+
+                        // A full output buffer means the inflater might have more for us.
+                        _pending = (_inflate.avail_out == 0);
+
+                        if ((result == 0) && (size == 0)) {
+                            // No progress at all, nothing more to get out of this.
+                            break;
+                        }
+                    }
+                }
+
+                if ((result == 0) && (final == true)) {
+                    // The message is complete, get ready for the next one.
+                    _tail = 0;
+                    _inflating = false;
+
+                    if (_receiveReset == true) {
+                        inflateReset(&_inflate);
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            const bool _sendReset;
+            const bool _receiveReset;
+            bool _active;
+            bool _last;
+            bool _inflating;
+            bool _valid;
+            bool _pending;
+            uint8_t _held;
+            uint8_t _tail;
+            uint8_t _heldBytes[sizeof(DeflateTail)];
+            std::vector<uint8_t> _input;
+            uint8_t _output[InflateSize];
+            z_stream _deflate;
+            z_stream _inflate;
+        };
+
+        // Parses a Sec-WebSocket-Extensions value into a list of offers, each offer being a list of
+        // name/value pairs, the first one holding the extension name.
+        typedef std::list<std::pair<string, string>> ExtensionParameters;
+
+        static string Trim(const string& text)
+        {
+            string::size_type start = text.find_first_not_of(_T(" \t"));
+            string::size_type end = text.find_last_not_of(_T(" \t"));
+
+            return (start == string::npos ? string() : text.substr(start, end - start + 1));
+        }
+
+        static void ParseExtensions(const string& text, std::list<ExtensionParameters>& extensions)
+        {
+            ExtensionParameters current;
+            string::size_type start = 0;
+
+            while (start <= text.length()) {
+                string::size_type end = text.find_first_of(_T(",;"), start);
+                string::size_type stop = (end == string::npos ? text.length() : end);
+                string token(Trim(text.substr(start, stop - start)));
+                string::size_type equal = token.find('=');
+
+                if (equal == string::npos) {
+                    current.emplace_back(token, string());
+                } else {
+                    string value(Trim(token.substr(equal + 1)));
+
+                    if ((value.length() >= 2) && (value[0] == '\"') && (value[value.length() - 1] == '\"')) {
+                        value = value.substr(1, value.length() - 2);
+                    }
+                    current.emplace_back(Trim(token.substr(0, equal)), value);
+                }
+
+                if ((end == string::npos) || (text[end] == ',')) {
+                    if (current.front().first.empty() == false) {
+                        extensions.push_back(current);
+                    }
+                    current.clear();
+                }
+
+                start = (end == string::npos ? text.length() + 1 : end + 1);
+            }
+        }
+
+        static bool WindowBits(const string& value, uint8_t& bits)
+        {
+            uint32_t number = (value.empty() == true ? MAX_WBITS : Core::NumberType<uint32_t>(value.c_str(), static_cast<uint32_t>(value.length())).Value());
+
+            // zlib can not produce a raw deflate stream with a window of 8 bits.
+            bits = static_cast<uint8_t>(number);
+
+            return ((number >= 9) && (number <= MAX_WBITS));
+        }
+
+        Protocol::~Protocol()
+        {
+            Reset();
+        }
+
+        string Protocol::Offer() const
+        {
+            string result;
+
+            if (_compression == true) {
+                result = string(PerMessageDeflate) + _T("; ") + ClientMaxWindowBits;
+
+                if (_contextTakeover == false) {
+                    result += string(_T("; ")) + ClientNoContextTakeover + _T("; ") + ServerNoContextTakeover;
+                }
+            }
+
+            return (result);
+        }
+
+        bool Protocol::Accept(const string& offers, string& response)
+        {
+            std::list<ExtensionParameters> extensions;
+
+            Reset();
+
+            if (_compression == true) {
+                ParseExtensions(offers, extensions);
+            }
+
+            // Pick the first offer we can live with.
+            while ((_deflate == nullptr) && (extensions.size() > 0)) {
+                ExtensionParameters& offer(extensions.front());
+
+                if (offer.front().first == PerMessageDeflate) {
+                    bool valid = true;
+                    bool sendReset = (_contextTakeover == false);
+                    bool receiveReset = (_contextTakeover == false);
+                    uint8_t windowBits = MAX_WBITS;
+
+                    response = PerMessageDeflate;
+
+                    ExtensionParameters::const_iterator index(++offer.begin());
+
+                    while ((valid == true) && (index != offer.end())) {
+                        if (index->first == ServerNoContextTakeover) {
+                            sendReset = true;
+                        } else if (index->first == ClientNoContextTakeover) {
+                            receiveReset = true;
+                        } else if (index->first == ServerMaxWindowBits) {
+                            valid = (index->second.empty() == false) && (WindowBits(index->second, windowBits) == true);
+                            response += string(_T("; ")) + ServerMaxWindowBits + '=' + index->second;
+                        } else if (index->first != ClientMaxWindowBits) {
+                            // We do not limit the window of the client, anything else we do not know.
+                            valid = false;
+                        }
+                        index++;
+                    }
+
+                    if (sendReset == true) {
+                        response += string(_T("; ")) + ServerNoContextTakeover;
+                    }
+                    if (receiveReset == true) {
+                        response += string(_T("; ")) + ClientNoContextTakeover;
+                    }
+
+                    if (valid == true) {
+                        _deflate = new Deflate(windowBits, sendReset, receiveReset);
+
+                        if (_deflate->IsValid() == false) {
+                            Reset();
+                        }
+                    }
+                }
+
+                extensions.pop_front();
+            }
+
+            if (_deflate == nullptr) {
+                response.clear();
+            }
+
+            return (_deflate != nullptr);
+        }
+
+        bool Protocol::Confirm(const string& response)
+        {
+            std::list<ExtensionParameters> extensions;
+
+            Reset();
+
+            if (_compression == true) {
+                ParseExtensions(response, extensions);
+            }
+
+            if ((extensions.size() == 1) && (extensions.front().front().first == PerMessageDeflate)) {
+                bool valid = true;
+                bool sendReset = (_contextTakeover == false);
+                bool receiveReset = (_contextTakeover == false);
+                uint8_t windowBits = MAX_WBITS;
+                ExtensionParameters::const_iterator index(++extensions.front().begin());
+
+                while ((valid == true) && (index != extensions.front().end())) {
+                    if (index->first == ClientNoContextTakeover) {
+                        sendReset = true;
+                    } else if (index->first == ServerNoContextTakeover) {
+                        receiveReset = true;
+                    } else if (index->first == ClientMaxWindowBits) {
+                        valid = WindowBits(index->second, windowBits);
+                    } else if (index->first == ServerMaxWindowBits) {
+                        // Our inflater handles any window the server might use.
+                    } else {
+                        valid = false;
+                    }
+                    index++;
+                }
+
+                if (valid == true) {
+                    _deflate = new Deflate(windowBits, sendReset, receiveReset);
+
+                    if (_deflate->IsValid() == false) {
+                        Reset();
+                    }
+                }
+            }
+
+            return (_deflate != nullptr);
+        }
+
+        void Protocol::Reset()
+        {
+            if (_deflate != nullptr) {
+                delete _deflate;
+                _deflate = nullptr;
+            }
+        }
+
+        bool Protocol::IsDeflating() const
+        {
+            return ((_deflate != nullptr) && (_deflate->IsActive() == true));
+        }
+
+        bool Protocol::IsHungry() const
+        {
+            return ((_deflate != nullptr) && (_deflate->IsHungry() == true));
+        }
+
+        bool Protocol::IsInflating() const
+        {
+            return ((_deflate != nullptr) && (_deflate->IsInflating() == true));
+        }
+
+        uint8_t* Protocol::DeflateBuffer(const uint32_t size)
+        {
+            ASSERT(_deflate != nullptr);
+
+            return (_deflate->Buffer(size));
+        }
+
+        void Protocol::DeflateInput(const uint8_t data[], const uint32_t length, const bool last)
+        {
+            ASSERT(_deflate != nullptr);
+
+            _deflate->Input(data, length, last);
+        }
+
+        uint32_t Protocol::DeflateOutput(uint8_t* payload, const uint32_t maxLength, bool& final)
+        {
+            ASSERT(_deflate != nullptr);
+
+            return (_deflate->Output(payload, maxLength, final));
+        }
+
+        uint16_t Protocol::InflateOutput(const uint8_t payload[], const uint32_t length, uint32_t& offset, const bool final)
+        {
+            ASSERT(_deflate != nullptr);
+
+            return (_deflate->Inflate(payload, length, offset, final));
+        }
+
+        uint8_t* Protocol::Inflated()
+        {
+            ASSERT(_deflate != nullptr);
+
+            return (_deflate->Inflated());
+        }
+
         std::string Protocol::RequestKey() const
         {
             string baseEncodedKey;
@@ -49,6 +505,124 @@ namespace Web {
             return (baseEncodedKey);
         }
 
+        // A masking kernel handles as many bytes as it can in chunks of its own size, using a 16 byte
+        // pattern that is the key repeated from the right offset, and returns how many it did. As the
+        // chunks are a multiple of 4 bytes, the key stays aligned for whatever is left.
+        typedef uint32_t (*MaskKernel)(uint8_t data[], const uint32_t length, const uint8_t pattern[16]);
+
+        static uint32_t MaskWords(uint8_t data[], const uint32_t length, const uint8_t pattern[16])
+        {
+            uint32_t index = 0;
+            uint64_t mask;
+
+            ::memcpy(&mask, pattern, sizeof(mask));
+
+            // The memcpy's compile to plain (unaligned) loads and stores.
+            for (; (index + sizeof(uint64_t)) <= length; index += sizeof(uint64_t)) {
+                uint64_t word;
+
+                ::memcpy(&word, &(data[index]), sizeof(word));
+                word ^= mask;
+                ::memcpy(&(data[index]), &word, sizeof(word));
+            }
+
+            return (index);
+        }
+
+#if defined(MASK_SSE2)
+        MASK_SSE2 static uint32_t MaskSSE2(uint8_t data[], const uint32_t length, const uint8_t pattern[16])
+        {
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+            uint32_t index = 0;
+
+            for (; (index + 16) <= length; index += 16) {
+                __m128i* location = reinterpret_cast<__m128i*>(&(data[index]));
+
+                _mm_storeu_si128(location, _mm_xor_si128(_mm_loadu_si128(location), mask));
+            }
+
+            return (index + MaskWords(&(data[index]), length - index, pattern));
+        }
+#endif
+
+#if defined(MASK_AVX2)
+        MASK_AVX2 static uint32_t MaskAVX2(uint8_t data[], const uint32_t length, const uint8_t pattern[16])
+        {
+            const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern)));
+            uint32_t index = 0;
+
+            for (; (index + 32) <= length; index += 32) {
+                __m256i* location = reinterpret_cast<__m256i*>(&(data[index]));
+
+                _mm256_storeu_si256(location, _mm256_xor_si256(_mm256_loadu_si256(location), mask));
+            }
+
+            return (index + MaskWords(&(data[index]), length - index, pattern));
+        }
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        static uint32_t MaskNEON(uint8_t data[], const uint32_t length, const uint8_t pattern[16])
+        {
+            const uint8x16_t mask = vld1q_u8(pattern);
+            uint32_t index = 0;
+
+            for (; (index + 16) <= length; index += 16) {
+                vst1q_u8(&(data[index]), veorq_u8(vld1q_u8(&(data[index])), mask));
+            }
+
+            return (index + MaskWords(&(data[index]), length - index, pattern));
+        }
+#endif
+
+        static MaskKernel SelectMaskKernel()
+        {
+            MaskKernel result = MaskWords;
+
+#if defined(MASK_AVX2)
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2")) {
+                result = MaskAVX2;
+            } else if (__builtin_cpu_supports("sse2")) {
+                result = MaskSSE2;
+            }
+#elif defined(MASK_SSE2)
+            result = MaskSSE2;
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#if defined(__LINUX__) && defined(__arm__)
+            // On 32 bits ARM, NEON is optional. Only use it if the kernel reports it.
+            if ((::getauxval(AT_HWCAP) & HWCAP_NEON) != 0) {
+                result = MaskNEON;
+            }
+#else
+            result = MaskNEON;
+#endif
+#endif
+
+            return (result);
+        }
+
+        /* static */ void Protocol::Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+        {
+            static const MaskKernel kernel = SelectMaskKernel();
+
+            uint8_t pattern[16];
+
+            for (uint8_t index = 0; index < sizeof(pattern); index++) {
+                pattern[index] = key[(offset + index) & 0x3];
+            }
+
+            uint32_t index = kernel(data, length, pattern);
+
+            // The scalar tail, at most 15 bytes.
+            for (; index < length; index++) {
+                data[index] ^= pattern[index & 0x3];
+            }
+        }
+
         /*  %x0 denotes a continuation frame
  *  %x1 denotes a text frame
  *  %x2 denotes a binary frame
@@ -58,18 +632,46 @@ namespace Web {
  *  %xA denotes a pong
  *  %xB-F are reserved for further control frames
  */
-        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+        uint8_t Protocol::HeaderSize(const uint32_t frameSize) const
+        {
+            const uint8_t mask = ((_setFlags & MASKING_FRAME) != 0 ? 4 : 0);
+
+            // Room for the header of a payload that fills up the frame, a payload of 64KB or more needs
+            // the 64 bits length.
+            return (frameSize <= (static_cast<uint32_t>(4 + mask) + 0xFFFF) ? (4 + mask) : (10 + mask));
+        }
+
+        uint32_t Protocol::Frame(uint8_t* dataFrame, const uint32_t maxSendSize, const uint8_t reserved, const uint32_t usedSize, const bool final, const bool compressed)
         {
             uint32_t result = 0;
 
             if ((usedSize != 0) || (SendInProgress() == true)) {
-                result = (usedSize <= 125 ? 2 : 4);
+                uint8_t header = 2;
+
+                if (usedSize <= 125) {
+                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | usedSize);
+                } else if (usedSize <= 0xFFFF) {
+                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | 126);
+                    dataFrame[2] = (usedSize >> 8) & 0xFF;
+                    dataFrame[3] = (usedSize & 0xFF);
+                    header += 2;
+                } else {
+                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | 127);
+                    dataFrame[2] = 0;
+                    dataFrame[3] = 0;
+                    dataFrame[4] = 0;
+                    dataFrame[5] = 0;
+                    dataFrame[6] = (usedSize >> 24) & 0xFF;
+                    dataFrame[7] = (usedSize >> 16) & 0xFF;
+                    dataFrame[8] = (usedSize >> 8) & 0xFF;
+                    dataFrame[9] = (usedSize & 0xFF);
+                    header += 8;
+                }
 
                 if ((_setFlags & MASKING_FRAME) == 0) {
-                    // Only if this is a smallFrame, we need to "flush" 2 bytes..
-                    if ((result == 2) && (usedSize != 0)) {
-                        // No masking, so just move and insert the header up front..
-                        ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
+                    // No masking, so just move the payload up front, if the header turned out smaller.
+                    if (header != reserved) {
+                        ::memmove(&dataFrame[header], &(dataFrame[reserved]), usedSize);
                     }
                 } else {
                     uint32_t value;
@@ -81,42 +683,30 @@ namespace Web {
                     maskKey[2] = (value >> 16) & 0xFF;
                     maskKey[3] = (value >> 24) & 0xFF;
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
+                    // The key completes the header, the payload is masked on its final spot.
+                    ::memcpy(&dataFrame[header], &maskKey, 4);
+                    header += 4;
 
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
+                    if (header != reserved) {
+                        ::memmove(&dataFrame[header], &(dataFrame[reserved]), usedSize);
                     }
-
-                    // Now there is space again, write down the encryption key.
-                    ::memcpy(&dataFrame[result], &maskKey, 4);
-                    result += 4;
+                    Mask(&dataFrame[header], usedSize, maskKey, 0);
                 }
 
-                if (usedSize <= 125) {
-                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | usedSize);
-                } else {
-                    // We only allows uin1t 16 so no need to go beyond two bytes..
-                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | 126);
-                    dataFrame[2] = (usedSize >> 8);
-                    dataFrame[3] = (usedSize & 0xFF);
-                }
+                ASSERT(header <= reserved);
+
+                // Only the first frame of a message carries the compression flag.
+                dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : (TYPE_FRAME & _setFlags) | (compressed == true ? COMPRESSED_FRAME : 0));
 
-                if (usedSize < maxSendSize) {
-                    // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                if (final == true) {
+                    dataFrame[0] |= FINISHING_FRAME;
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
                     _progressInfo |= (0x40);
                 }
 
-                result += usedSize;
+                result = header + usedSize;
             }
 
             if (((_controlStatus & (REQUEST_CLOSE | REQUEST_PING | REQUEST_PONG)) != 0) && ((result + 1) < maxSendSize)) {
@@ -140,7 +730,7 @@ namespace Web {
             return (result);
         }
 
-        uint16_t Protocol::Decoder(uint8_t* dataFrame, uint16_t& receivedSize)
+        uint16_t Protocol::Decoder(uint8_t* dataFrame, uint32_t& receivedSize)
         {
             uint16_t actualHeader = 0;
 
@@ -148,37 +738,26 @@ namespace Web {
 
             if (_pendingReceiveBytes > 0) {
                 // Just unscramble, what is left...
-                if ((_progressInfo & 0x20) == 0x20) {
-                    // looks like we need to unscramble..
-                    uint8_t* source = dataFrame;
-
-                    if (_pendingReceiveBytes < receivedSize) {
-                        receivedSize = _pendingReceiveBytes;
-                    }
+                if (_pendingReceiveBytes < receivedSize) {
+                    receivedSize = static_cast<uint32_t>(_pendingReceiveBytes);
+                }
 
-                    while (_pendingReceiveBytes != 0) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
-                } else {
-                    if (_pendingReceiveBytes > receivedSize) {
-                        _pendingReceiveBytes -= receivedSize;
-                    } else {
-                        receivedSize = _pendingReceiveBytes;
-                        _pendingReceiveBytes = 0;
-                    }
+                if ((_progressInfo & 0x20) == 0x20) {
+                    // looks like we need to unscramble, continue with the key where the previous part stopped.
+                    Mask(dataFrame, receivedSize, _scrambleKey, (_progressInfo & 0x03));
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
                 }
+
+                _pendingReceiveBytes -= receivedSize;
             } else if (receivedSize < 2) {
                 // This is a way too small frame..
                 receivedSize = 0;
             } else {
                 // This seems to be a new frame, check it out !!!
-                uint32_t bytesToMove = (dataFrame[1] & 0x7F);
+                uint64_t payloadSize = (dataFrame[1] & 0x7F);
 
                 // check if the full header is present..
-                actualHeader = 2 + (bytesToMove == 127 ? 4 : (bytesToMove == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
+                actualHeader = 2 + (payloadSize == 127 ? 8 : (payloadSize == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
 
                 if (actualHeader > receivedSize) {
                     // Frame too small to identify the content yet !!
@@ -187,6 +766,17 @@ namespace Web {
                 } else {
                     _frameType = static_cast<frameType>(dataFrame[0] & TYPE_FRAME);
 
+                    if ((dataFrame[0] & COMPRESSED_FRAME) != 0) {
+                        // Only the first frame of a data message can be marked, and only if we agreed on it.
+                        if ((_deflate == nullptr) || (_frameType == 0) || ((_frameType & CONTROL_FRAME) != 0)) {
+                            _frameType = VIOLATION;
+                        } else {
+                            _deflate->Inflating(true);
+                        }
+                    } else if ((_deflate != nullptr) && (_frameType != 0) && ((_frameType & CONTROL_FRAME) == 0)) {
+                        _deflate->Inflating(false);
+                    }
+
                     // Continuation frame is only allowed if a receive is in progress...
                     if (ReceiveInProgress() == true) {
                         if (_frameType == 0) {
@@ -212,19 +802,32 @@ namespace Web {
                         _frameType = INCONSISTENT;
                     }
 
+                    if (payloadSize == 126) {
+                        payloadSize = ((dataFrame[2] << 8) + dataFrame[3]);
+                    } else if (payloadSize == 127) {
+                        payloadSize = 0;
+
+                        for (uint8_t index = 2; index < 10; index++) {
+                            payloadSize = (payloadSize << 8) | dataFrame[index];
+                        }
+
+                        // The most significant bit must be 0.
+                        if ((payloadSize >> 63) != 0) {
+                            _frameType = TOO_BIG;
+                        }
+                    }
+
                     // If the frame is not an error, unpack/move what is required..
                     if ((_frameType & 0xF8) == 0) {
-                        if (bytesToMove == 126) {
-                            bytesToMove = ((dataFrame[2] << 8) + dataFrame[3]);
-                        } else if (bytesToMove == 127) {
-                            bytesToMove = ((dataFrame[2] << 24) + (dataFrame[3] << 16) + (dataFrame[4] << 8) + dataFrame[5]);
-                        }
+                        uint32_t bytesToMove;
 
-                        // We might not have the full body yet...
-                        if ((actualHeader + bytesToMove) > receivedSize) {
-                            _pendingReceiveBytes = (actualHeader + bytesToMove - receivedSize);
+                        // We might not have the full body yet, the rest is delivered as it comes in.
+                        if ((actualHeader + payloadSize) > receivedSize) {
+                            _pendingReceiveBytes = (actualHeader + payloadSize - receivedSize);
                             bytesToMove = receivedSize - actualHeader;
                             _progressInfo &= (~0x20);
+                        } else {
+                            bytesToMove = static_cast<uint32_t>(payloadSize);
                         }
 
                         receivedSize = bytesToMove;
@@ -238,17 +841,9 @@ namespace Web {
 
                             // The last two bits in the progressInfo are used to select the proper scrambling key.
                             // We need to clear them if we start., the 0x20 indicates scrambling required
-                            _progressInfo |= 0x20;
-                            _progressInfo &= (~0x03);
-
-                            uint8_t* source = &dataFrame[actualHeader];
+                            Mask(&dataFrame[actualHeader], bytesToMove, _scrambleKey, 0);
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
-                            }
+                            _progressInfo = ((_progressInfo | 0x20) & 0xFC) | (bytesToMove & 0x03);
                         }
                     }
                 }
@@ -18,7 +18,7 @@ namespace Web {
                 PING = 0x09,
                 PONG = 0x0A,
                 VIOLATION = 0x10, // e.g. a control package without a FIN flag
-                TOO_BIG = 0x20, // Protocol max support for 2^16 message per chunk
+                TOO_BIG = 0x20, // A payload length beyond 2^63, not allowed by the protocol
                 INCONSISTENT = 0x30 // e.g. Protocol defined as Text, but received a binary.
             };
 
@@ -30,27 +30,64 @@ namespace Web {
                 CLOSE_INPROGRESS = 0x08
             };
 
+            // State of the negotiated permessage-deflate extension, lives in the implementation file.
+            class Deflate;
+
             Protocol() = delete;
             Protocol(const Protocol&) = delete;
             Protocol& operator=(const Protocol&) = delete;
 
         public:
+            // Messages smaller than this are not worth the CPU cycles to compress them.
+            static constexpr uint16_t DefaultThreshold = 256;
+
+            // The largest frame header, 2 bytes, a 64 bits payload length and the masking key.
+            static constexpr uint8_t MaxHeaderSize = 14;
+
             Protocol(const bool binary, const bool masking)
                 : _setFlags((masking ? 0x80 : 0x00) | (binary ? 0x02 : 0x01))
                 , _progressInfo(0)
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _compression(false)
+                , _contextTakeover(true)
+                , _threshold(DefaultThreshold)
+                , _deflate(nullptr)
             {
             }
-            ~Protocol()
-            {
-            }
+            ~Protocol();
 
         public:
             std::string RequestKey() const;
             std::string ResponseKey(const std::string& requestKey) const;
 
+            // Support for the permessage-deflate extension (RFC 7692). If enabled, a client offers it
+            // in its upgrade request and a server accepts such an offer. Without context takeover the
+            // compression starts from scratch for every message, which costs ratio but saves memory on
+            // both ends.
+            inline void Compression(const bool enabled, const bool contextTakeover, const uint16_t threshold)
+            {
+                _compression = enabled;
+                _contextTakeover = contextTakeover;
+                _threshold = threshold;
+            }
+            inline bool Compression() const
+            {
+                return (_compression);
+            }
+            inline bool IsCompressed() const
+            {
+                return (_deflate != nullptr);
+            }
+
+            // Negotiation of the extension during the upgrade, the client makes an offer, the server
+            // accepts it, and the client confirms the answer of the server.
+            string Offer() const;
+            bool Accept(const string& offers, string& response);
+            bool Confirm(const string& response);
+            void Reset();
+
             inline void Ping()
             {
                 _controlStatus |= REQUEST_PING;
@@ -100,16 +137,108 @@ namespace Web {
                 return ((_setFlags & 0x80) != 0);
             }
 
-            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
-            uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
+            // Checks the frame header at the start of the data, returns its size and leaves the size of
+            // the (unmasked) payload that follows it in receivedSize. A frame larger than the data is
+            // delivered in parts, the next parts have no header.
+            uint16_t Decoder(uint8_t* dataFrame, uint32_t& receivedSize);
+
+            // (Un)masks the data in place, starting with the key byte at the given offset. Works a
+            // vector or word at a time, using the widest kernel the CPU supports.
+            static void Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset);
+
+            // Fills the buffer of the given size with a frame holding the data pulled from the source
+            // (through its SendData), compressing it if the extension is active and the message is large
+            // enough. The payload is pulled in right behind the room for its header, so a large frame is
+            // not moved around. The source marks the end of a message by not filling all space offered.
+            template <typename SOURCE>
+            uint32_t Encoder(uint8_t* dataFrame, const uint32_t maxSendSize, SOURCE& source)
+            {
+                const uint8_t header = HeaderSize(maxSendSize);
+                uint32_t result = 0;
+
+                if (maxSendSize > header) {
+                    const uint32_t room = maxSendSize - header;
+
+                    if ((_deflate == nullptr) || ((SendInProgress() == false) && (IsDeflating() == false))) {
+                        result = source.SendData(&(dataFrame[header]), room);
+
+                        if ((_deflate != nullptr) && (result != 0) && ((result == room) || (result >= _threshold))) {
+                            // Worth the effort, this message goes out compressed.
+                            DeflateInput(&(dataFrame[header]), result, (result < room));
+                        } else {
+                            result = Frame(dataFrame, maxSendSize, header, result, (result < room), false);
+                        }
+                    }
+
+                    if (IsDeflating() == true) {
+                        uint32_t length = 0;
+                        bool final = false;
+
+                        while (final == false) {
+                            if (IsHungry() == true) {
+                                uint8_t* buffer = DeflateBuffer(room);
+                                uint32_t size = source.SendData(buffer, room);
+
+                                DeflateInput(buffer, size, (size < room));
+                            }
+
+                            length += DeflateOutput(&(dataFrame[header + length]), (room - length), final);
+
+                            if ((final == false) && (IsHungry() == false)) {
+                                // The frame is full, the rest goes into the next one.
+                                break;
+                            }
+                        }
+
+                        result = Frame(dataFrame, maxSendSize, header, length, final, true);
+                    }
+                }
+
+                return (result);
+            }
+
+            // Delivers the payload of a data frame to the sink (through its ReceiveData), decompressing
+            // it if it is part of a compressed message.
+            template <typename SINK>
+            void Decoder(uint8_t* payload, const uint32_t length, SINK& sink)
+            {
+                if (IsInflating() == false) {
+                    sink.ReceiveData(payload, length);
+                } else {
+                    const bool final = ((ReceiveInProgress() == false) && (IsCompleteMessage() == true));
+                    uint32_t offset = 0;
+                    uint16_t size;
+
+                    while ((size = InflateOutput(payload, length, offset, final)) > 0) {
+                        sink.ReceiveData(Inflated(), size);
+                    }
+                }
+            }
+
+        private:
+            uint8_t HeaderSize(const uint32_t frameSize) const;
+            uint32_t Frame(uint8_t* dataFrame, const uint32_t maxSendSize, const uint8_t reserved, const uint32_t usedSize, const bool final, const bool compressed);
+
+            bool IsDeflating() const;
+            bool IsHungry() const;
+            bool IsInflating() const;
+            uint8_t* DeflateBuffer(const uint32_t size);
+            void DeflateInput(const uint8_t data[], const uint32_t length, const bool last);
+            uint32_t DeflateOutput(uint8_t* payload, const uint32_t maxLength, bool& final);
+            uint16_t InflateOutput(const uint8_t payload[], const uint32_t length, uint32_t& offset, const bool final);
+            uint8_t* Inflated();
 
         private:
             uint8_t _setFlags;
             uint8_t _progressInfo;
-            uint32_t _pendingReceiveBytes;
+            uint64_t _pendingReceiveBytes;
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            bool _compression;
+            bool _contextTakeover;
+            uint16_t _threshold;
+            Deflate* _deflate;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -653,7 +782,7 @@ namespace Web {
             }
             inline void Ping()
             {
-                _pingFireTime = Core::Time::Now().Ticks();
+                _pingFireTime = Core::Time::Monotonic();
 
                 _adminLock.Lock();
 
@@ -667,6 +796,14 @@ namespace Web {
             {
                 return (_handler.Masking());
             }
+            inline void Compression(const bool enabled, const bool contextTakeover, const uint16_t threshold)
+            {
+                _handler.Compression(enabled, contextTakeover, threshold);
+            }
+            inline bool IsCompressed() const
+            {
+                return (_handler.IsCompressed());
+            }
             inline bool Upgrade(const string& protocol, const string& path)
             {
                 string empty;
@@ -722,22 +859,20 @@ namespace Web {
             }
 
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 _adminLock.Lock();
 
                 _state = static_cast<EnumlinkState>(_state | ACTIVITY);
 
                 if ((_state & WEBSOCKET) != 0) {
-                    if (maxSendSize > 4) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 4));
-
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 4), result);
-                    }
+                    result = _handler.Encoder(dataFrame, maxSendSize, _parent);
                 } else {
-                    result = _serializerImpl.Serialize(dataFrame, maxSendSize);
+                    result = Core::Chunked(maxSendSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                        return (_serializerImpl.Serialize(&(dataFrame[offset]), size));
+                    });
                 }
 
                 _adminLock.Unlock();
@@ -748,9 +883,9 @@ namespace Web {
 
                 return (result);
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 _adminLock.Lock();
 
@@ -761,7 +896,7 @@ namespace Web {
 
                     // check for multiple messages if available...
                     while ((result < receivedSize) && (tooSmall == false)) {
-                        uint16_t actualDataSize = receivedSize - result;
+                        uint32_t actualDataSize = receivedSize - result;
                         uint16_t headerSize = _handler.Decoder(const_cast<uint8_t*>(&dataFrame[result]), actualDataSize);
 
                         tooSmall = ((headerSize == 0) && (actualDataSize == 0));
@@ -793,7 +928,7 @@ namespace Web {
                                         ACTUALLINK::Trigger();
                                     } else if (_handler.FrameType() == WebSocket::Protocol::PONG) {
                                         if (_pingFireTime != 0) {
-                                            TRACE_L1("Ping acknowledged by a pong in %d (uS)", static_cast<uint32_t>(static_cast<uint64_t>(Core::Time::Now().Ticks() - _pingFireTime)));
+                                            TRACE_L1("Ping acknowledged by a pong in %d (uS)", static_cast<uint32_t>(static_cast<uint64_t>(Core::Time::Monotonic() - _pingFireTime)));
                                             _pingFireTime = 0;
                                         } else {
                                             TRACE_L1("Pong received but nu ping requested ??? [%d] ", __LINE__);
@@ -808,14 +943,16 @@ namespace Web {
 
                                 result += headerSize; // actualDataSize
                             } else {
-                                _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
+                                _handler.Decoder(&(dataFrame[result + headerSize]), actualDataSize, _parent);
 
                                 result += (headerSize + actualDataSize);
                             }
                         }
                     }
                 } else {
-                    result = _deserialiserImpl.Deserialize(dataFrame, receivedSize);
+                    result = Core::Chunked(receivedSize, [&](const uint32_t offset, const uint16_t size) -> uint16_t {
+                        return (_deserialiserImpl.Deserialize(&(dataFrame[offset]), size));
+                    });
                 }
 
                 _adminLock.Unlock();
@@ -946,6 +1083,14 @@ namespace Web {
                             if (_protocol.empty() == false) {
                                 _webSocketMessage->WebSocketProtocol = _protocol;
                             }
+
+                            string extensions;
+
+                            if (_handler.Accept((element->WebSocketExtensions.IsSet() == true ? element->WebSocketExtensions.Value() : string()), extensions) == true) {
+                                _webSocketMessage->WebSocketExtensions = extensions;
+                            } else {
+                                _webSocketMessage->WebSocketExtensions.Clear();
+                            }
                         }
                     }
 
@@ -1008,6 +1153,12 @@ namespace Web {
                         _webSocketMessage->WebSocketProtocol = protocol;
                     }
 
+                    string offer(_handler.Offer());
+
+                    if (offer.empty() == false) {
+                        _webSocketMessage->WebSocketExtensions = offer;
+                    }
+
                     _query = query;
                     _path = path;
                     _protocol = protocol;
@@ -1035,6 +1186,8 @@ namespace Web {
                     // Seems like we succeeded, turn on the link..
                     _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSOCKET);
 
+                    _handler.Confirm(element->WebSocketExtensions.IsSet() == true ? element->WebSocketExtensions.Value() : string());
+
                     _parent.StateChange();
 
                     _adminLock.Unlock();
@@ -1203,6 +1356,14 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const bool enabled, const bool contextTakeover = true, const uint16_t threshold = WebSocket::Protocol::DefaultThreshold)
+        {
+            _channel.Compression(enabled, contextTakeover, threshold);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline void ResetActivity()
         {
             return (_channel.ResetActivity());
@@ -1259,8 +1420,8 @@ namespace Web {
         virtual void LinkBody(Core::ProxyType<INBOUND>& element) = 0;
         virtual void Received(Core::ProxyType<INBOUND>& element) = 0;
         virtual void Send(const Core::ProxyType<OUTBOUND>& element) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
         virtual void StateChange() = 0;
         virtual bool IsIdle() const = 0;
 
@@ -1367,11 +1528,11 @@ namespace Web {
             }
 
         public:
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -1522,6 +1683,14 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const bool enabled, const bool contextTakeover = true, const uint16_t threshold = WebSocket::Protocol::DefaultThreshold)
+        {
+            _channel.Compression(enabled, contextTakeover, threshold);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1545,8 +1714,8 @@ namespace Web {
 
         virtual bool IsIdle() const = 0;
         virtual void StateChange() = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
     private:
         Handler<LINK> _channel;
@@ -1619,11 +1788,11 @@ namespace Web {
             }
 
         public:
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -1760,6 +1929,14 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const bool enabled, const bool contextTakeover = true, const uint16_t threshold = WebSocket::Protocol::DefaultThreshold)
+        {
+            _channel.Compression(enabled, contextTakeover, threshold);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1783,8 +1960,8 @@ namespace Web {
 
         virtual bool IsIdle() const = 0;
         virtual void StateChange() = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
     private:
         Handler<LINK> _channel;
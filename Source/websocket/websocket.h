@@ -6,6 +6,7 @@
 #include "URL.h"
 #include "JSONWebToken.h"
 #include "JSONRPCLink.h"
+#include "WebCache.h"
 #include "WebLink.h"
 #include "WebRequest.h"
 #include "WebResponse.h"
@@ -0,0 +1,567 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/Channel.h>
+#include <plugins/Service.h>
+
+#include <atomic>
+#include <sys/socket.h>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // A channel on one end of a socket pair. It never upgrades the link to a WebSocket, so the link
+    // leaves the outbound queue alone, the test decides when it is drained and in what sizes.
+    class TestChannel : public PluginHost::Channel {
+    public:
+        TestChannel() = delete;
+        TestChannel(const TestChannel&) = delete;
+        TestChannel& operator=(const TestChannel&) = delete;
+
+        TestChannel(const SOCKET& connector)
+            : PluginHost::Channel(connector, Core::NodeId(_T("127.0.0.1")))
+        {
+            PluginHost::Channel::State(PluginHost::Channel::JSONRPC, false);
+        }
+        ~TestChannel() override
+        {
+        }
+
+    public:
+        void Outbound(const uint32_t highWatermark, const uint32_t lowWatermark, const EventPolicy policy)
+        {
+            PluginHost::Channel::Outbound(highWatermark, lowWatermark, policy);
+        }
+        // Send out at most one message, in pieces of the given size.
+        string Drain(const uint16_t pieceSize)
+        {
+            string result;
+            uint8_t buffer[1024];
+
+            ASSERT(pieceSize <= sizeof(buffer));
+
+            uint32_t depth = QueueDepth();
+
+            while ((depth != 0) && (QueueDepth() == depth)) {
+                uint16_t size = PluginHost::Channel::Serialize(buffer, pieceSize);
+
+                if (size == 0) {
+                    break;
+                }
+                result.append(reinterpret_cast<const char*>(buffer), size);
+            }
+
+            return (result);
+        }
+        uint16_t Piece(uint8_t buffer[], const uint16_t pieceSize)
+        {
+            return (PluginHost::Channel::Serialize(buffer, pieceSize));
+        }
+        using PluginHost::Channel::Pipeline;
+        using PluginHost::Channel::Respond;
+
+    private:
+        void LinkBody(Core::ProxyType<PluginHost::Request>&) override
+        {
+        }
+        void Received(Core::ProxyType<PluginHost::Request>&) override
+        {
+        }
+        void Send(const Core::ProxyType<Web::Response>& response) override
+        {
+            PluginHost::Channel::Responded(response);
+        }
+        void Send(const Core::ProxyType<Core::JSON::IElement>&) override
+        {
+        }
+        Core::ProxyType<Core::JSON::IElement> Element(const string&) override
+        {
+            return (Core::ProxyType<Core::JSON::IElement>());
+        }
+        void Received(Core::ProxyType<Core::JSON::IElement>&) override
+        {
+        }
+        uint32_t SendData(uint8_t*, const uint32_t) override
+        {
+            return (0);
+        }
+        uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void Received(const string&) override
+        {
+        }
+        void StateChange() override
+        {
+        }
+    };
+
+    class ChannelPair {
+    public:
+        ChannelPair(const ChannelPair&) = delete;
+        ChannelPair& operator=(const ChannelPair&) = delete;
+
+        ChannelPair()
+            : _peer(INVALID_SOCKET)
+            , _channel()
+        {
+            int sockets[2];
+
+            EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+            _peer = sockets[1];
+            _channel.reset(new TestChannel(sockets[0]));
+            _channel->Open(0);
+        }
+        ~ChannelPair()
+        {
+            _channel->Close(Core::infinite);
+            _channel.reset();
+            ::close(_peer);
+        }
+
+    public:
+        TestChannel* operator->()
+        {
+            return (_channel.get());
+        }
+        // Whatever the channel wrote to the socket, until it has stayed quiet for a while.
+        string Received()
+        {
+            string result;
+            uint8_t quiet = 0;
+
+            while (quiet < 20) {
+                char buffer[1024];
+                ssize_t size = ::recv(_peer, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+                if (size > 0) {
+                    result.append(buffer, size);
+                    quiet = 0;
+                } else {
+                    SleepMs(10);
+                    quiet++;
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        SOCKET _peer;
+        std::unique_ptr<TestChannel> _channel;
+    };
+
+    static string Notification(const string& designator, const string& parameters)
+    {
+        Core::JSONRPC::Message message;
+        string text;
+
+        message.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message.Designator = designator;
+        message.Parameters = parameters;
+        message.ToString(text);
+
+        return (text);
+    }
+
+    TEST(Plugins_Channel, SharedNotification)
+    {
+        {
+            const uint16_t pieceSizes[] = { 7, 64, 1000 };
+            ChannelPair channels[3];
+            string sent[3];
+            bool done[3] = { false, false, false };
+
+            string payload;
+            for (uint32_t index = 0; index < 64; index++) {
+                payload += _T("shared notification payload ");
+            }
+            const string text(Notification(_T("client.events.statechange"), _T("{\"text\":\"") + payload + _T("\"}")));
+
+            Core::ProxyType<Core::JSON::IElement> frame(Core::ProxyType<PluginHost::Channel::Notification>::Create(_T("client.events.statechange"), text));
+
+            for (ChannelPair& channel : channels) {
+                channel->Submit(frame);
+                EXPECT_EQ(channel->QueueDepth(), 1u);
+            }
+
+            // All channels send from the same instance, interleaved, each in its own piece size.
+            while ((done[0] == false) || (done[1] == false) || (done[2] == false)) {
+                for (uint8_t index = 0; index < 3; index++) {
+                    if (done[index] == false) {
+                        uint8_t buffer[1024];
+                        uint16_t size = channels[index]->Piece(buffer, pieceSizes[index]);
+
+                        sent[index].append(reinterpret_cast<const char*>(buffer), size);
+                        done[index] = (channels[index]->QueueDepth() == 0);
+                    }
+                }
+            }
+
+            for (uint8_t index = 0; index < 3; index++) {
+                EXPECT_EQ(sent[index], text);
+            }
+            EXPECT_EQ(sent[0], sent[1]);
+            EXPECT_EQ(sent[1], sent[2]);
+
+            // The instance did not change by being sent, a next channel gets the same bytes.
+            ChannelPair late;
+            late->Submit(frame);
+            EXPECT_EQ(late->Drain(1000), text);
+
+            // And those are the bytes a channel sends for a message of its own.
+            Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            message->Designator = _T("client.events.statechange");
+            message->Parameters = _T("{\"text\":\"") + payload + _T("\"}");
+
+            ChannelPair single;
+            single->Submit(Core::ProxyType<Core::JSON::IElement>(message));
+            EXPECT_EQ(single->Drain(64), text);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    static Core::ProxyType<Core::JSON::IElement> Event(const string& designator, const uint32_t value)
+    {
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+
+        message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message->Designator = designator;
+        message->Parameters = _T("{\"value\":") + Core::NumberType<uint32_t>(value).Text() + _T("}");
+
+        return (Core::ProxyType<Core::JSON::IElement>(message));
+    }
+
+    TEST(Plugins_Channel, AnswersBeforeEvents)
+    {
+        {
+            ChannelPair channel;
+
+            channel->Submit(Event(_T("first.event"), 1));
+            channel->Submit(Event(_T("second.event"), 2));
+            channel->Submit(_T("answer"));
+            EXPECT_EQ(channel->QueueDepth(), 3u);
+
+            EXPECT_EQ(channel->Drain(1000), _T("answer"));
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("first.event"), _T("{\"value\":1}")));
+
+            // Once an event is on its way, an answer has to wait for it to complete.
+            uint8_t buffer[8];
+            EXPECT_EQ(channel->Piece(buffer, sizeof(buffer)), sizeof(buffer));
+            channel->Submit(_T("later"));
+            channel->Submit(Event(_T("third.event"), 3));
+
+            const string second(Notification(_T("second.event"), _T("{\"value\":2}")));
+            EXPECT_EQ(string(reinterpret_cast<const char*>(buffer), sizeof(buffer)) + channel->Drain(1000), second);
+            EXPECT_EQ(channel->Drain(1000), _T("later"));
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("third.event"), _T("{\"value\":3}")));
+            EXPECT_EQ(channel->QueueDepth(), 0u);
+            EXPECT_EQ(channel->Dropped(), 0u);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Plugins_Channel, DropAboveHighWatermark)
+    {
+        {
+            ChannelPair channel;
+            const uint32_t size = static_cast<uint32_t>(Notification(_T("client.event"), _T("{\"value\":1}")).length());
+
+            channel->Outbound(3 * size, size, PluginHost::Channel::DROP);
+
+            channel->Submit(Event(_T("client.event"), 1));
+            channel->Submit(Event(_T("client.event"), 2));
+            channel->Submit(Event(_T("client.event"), 3));
+            EXPECT_EQ(channel->QueueDepth(), 3u);
+
+            // Past the high watermark, events are dropped, answers are still queued.
+            channel->Submit(Event(_T("client.event"), 4));
+            channel->Submit(_T("answer"));
+            EXPECT_EQ(channel->QueueDepth(), 4u);
+            EXPECT_EQ(channel->Dropped(), 1u);
+            EXPECT_EQ(channel->Coalesced(), 0u);
+
+            EXPECT_EQ(channel->Drain(1000), _T("answer"));
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.event"), _T("{\"value\":1}")));
+
+            // Still above the low watermark.
+            channel->Submit(Event(_T("client.event"), 5));
+            EXPECT_EQ(channel->QueueDepth(), 2u);
+            EXPECT_EQ(channel->Dropped(), 2u);
+
+            // Drained to the low watermark, events are queued again.
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.event"), _T("{\"value\":2}")));
+            channel->Submit(Event(_T("client.event"), 6));
+            EXPECT_EQ(channel->QueueDepth(), 2u);
+            EXPECT_EQ(channel->Dropped(), 2u);
+
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.event"), _T("{\"value\":3}")));
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.event"), _T("{\"value\":6}")));
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Plugins_Channel, CoalesceAboveHighWatermark)
+    {
+        {
+            ChannelPair channel;
+            const uint32_t size = static_cast<uint32_t>(Notification(_T("client.one"), _T("{\"value\":1}")).length());
+
+            channel->Outbound(2 * size, size, PluginHost::Channel::COALESCE);
+
+            channel->Submit(Event(_T("client.one"), 1));
+            channel->Submit(Event(_T("client.two"), 2));
+            EXPECT_EQ(channel->QueueDepth(), 2u);
+
+            // The latest event replaces the one waiting for the same designator, others are dropped.
+            channel->Submit(Event(_T("client.two"), 3));
+            channel->Submit(Event(_T("client.six"), 4));
+            EXPECT_EQ(channel->QueueDepth(), 2u);
+            EXPECT_EQ(channel->Coalesced(), 1u);
+            EXPECT_EQ(channel->Dropped(), 1u);
+
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.one"), _T("{\"value\":1}")));
+
+            // Below the low watermark, events are queued again.
+            channel->Submit(Event(_T("client.six"), 5));
+            EXPECT_EQ(channel->QueueDepth(), 2u);
+
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.two"), _T("{\"value\":3}")));
+            EXPECT_EQ(channel->Drain(1000), Notification(_T("client.six"), _T("{\"value\":5}")));
+            EXPECT_EQ(channel->Coalesced(), 1u);
+            EXPECT_EQ(channel->Dropped(), 1u);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Plugins_Channel, PipelinedResponsesInOrder)
+    {
+        {
+            const uint8_t calls = 4;
+            ChannelPair channel;
+            Core::ProxyType<Web::Request> requests[calls];
+            Core::ProxyType<Web::Response> responses[calls];
+            std::vector<std::thread> workers;
+
+            for (uint8_t index = 0; index < calls; index++) {
+                requests[index] = Core::ProxyType<Web::Request>::Create();
+                responses[index] = Core::ProxyType<Web::Response>::Create();
+                responses[index]->ErrorCode = Web::STATUS_OK;
+                responses[index]->ETag = _T("pipelined-") + Core::NumberType<uint8_t>(index).Text();
+
+                channel->Pipeline(requests[index]);
+            }
+
+            // The requests complete in reverse order, each on a thread of its own.
+            for (uint8_t index = 0; index < calls; index++) {
+                workers.emplace_back([&channel, &requests, &responses, index]() {
+                    SleepMs((calls - index) * 20);
+                    channel->Respond(requests[index], responses[index]);
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+
+            const string wire(channel.Received());
+            size_t position = 0;
+
+            for (uint8_t index = 0; index < calls; index++) {
+                size_t found = wire.find(_T("pipelined-") + Core::NumberType<uint8_t>(index).Text());
+
+                ASSERT_NE(found, string::npos);
+                EXPECT_GT(found, position);
+                position = found;
+            }
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    // Answers every call, with its parameters as result, on a thread of its own, and sends the answer
+    // to the batch out over the channel, as the server does.
+    class EchoBatch : public PluginHost::Channel::Batch {
+    public:
+        EchoBatch() = delete;
+        EchoBatch(const EchoBatch&) = delete;
+        EchoBatch& operator=(const EchoBatch&) = delete;
+
+        EchoBatch(TestChannel& channel)
+            : PluginHost::Channel::Batch()
+            , _channel(channel)
+            , _workers()
+            , _replies(0)
+        {
+        }
+        ~EchoBatch() override
+        {
+            Wait();
+        }
+
+    public:
+        uint32_t Calls() const
+        {
+            return (static_cast<uint32_t>(_workers.size()));
+        }
+        uint32_t Replies() const
+        {
+            return (_replies);
+        }
+        void Wait()
+        {
+            for (std::thread& worker : _workers) {
+                worker.join();
+            }
+            _workers.clear();
+        }
+
+    protected:
+        void Call(const uint32_t index, const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& call) override
+        {
+            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>> message(call);
+
+            // The calls complete in reverse order.
+            _workers.emplace_back([this, index, message]() {
+                SleepMs((8 - index) * 10);
+
+                Core::ProxyType<Core::JSONRPC::Message> response;
+
+                if (message->Id.IsSet() == true) {
+                    response = Core::ProxyType<Core::JSONRPC::Message>::Create();
+                    response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                    response->Id = message->Id.Value();
+                    response->Result = message->Parameters.Value();
+                }
+
+                Completed(index, response);
+            });
+        }
+        void Reply(const Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Batch>>& body) override
+        {
+            _replies++;
+
+            if (body->IsSet() == true) {
+                _channel.Submit(Core::ProxyType<Core::JSON::IElement>(body));
+            }
+        }
+
+    private:
+        TestChannel& _channel;
+        std::vector<std::thread> _workers;
+        std::atomic<uint32_t> _replies;
+    };
+
+    static std::vector<string> Responses(const string& text)
+    {
+        std::vector<string> result;
+        Core::JSONRPC::Batch answer;
+
+        EXPECT_TRUE(answer.FromString(text));
+        EXPECT_TRUE(answer.IsBatch());
+
+        Core::JSON::ArrayType<Core::JSON::String>::Iterator index(answer.Calls.Elements());
+
+        while (index.Next() == true) {
+            result.push_back(index.Current().Value());
+        }
+
+        return (result);
+    }
+
+    TEST(Plugins_Channel, BatchAnsweredInOrder)
+    {
+        {
+            ChannelPair channel;
+            EchoBatch collector(*(channel.operator->()));
+            Core::JSONRPC::Batch batch;
+
+            EXPECT_TRUE(batch.FromString(_T("[")
+                _T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"test.1.echo\",\"params\":\"one\"},")
+                _T("{\"jsonrpc\":\"2.0\",\"method\":\"test.1.note\",\"params\":\"two\"},")
+                _T("{\"nomethod\":3},")
+                _T("{\"jsonrpc\":\"2.0\",\"id\":4,\"method\":\"test.1.echo\",\"params\":\"four\"}")
+                _T("]")));
+            ASSERT_TRUE(batch.IsBatch());
+
+            collector.Execute(batch);
+            EXPECT_EQ(collector.Calls(), 3u);
+            collector.Wait();
+            EXPECT_EQ(collector.Replies(), 1u);
+
+            // The notification is not answered, the invalid call is answered without being executed.
+            std::vector<string> responses(Responses(channel->Drain(1000)));
+            ASSERT_EQ(responses.size(), 3u);
+
+            Core::JSONRPC::Message first, second, third;
+            EXPECT_TRUE(first.FromString(responses[0]));
+            EXPECT_TRUE(second.FromString(responses[1]));
+            EXPECT_TRUE(third.FromString(responses[2]));
+
+            EXPECT_EQ(first.Id.Value(), 1u);
+            EXPECT_EQ(first.Result.Value(), _T("\"one\""));
+            EXPECT_FALSE(second.Id.IsSet());
+            EXPECT_EQ(second.Error.Code.Value(), -32600);
+            EXPECT_EQ(third.Id.Value(), 4u);
+            EXPECT_EQ(third.Result.Value(), _T("\"four\""));
+            EXPECT_EQ(channel->QueueDepth(), 0u);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Plugins_Channel, BatchTooLarge)
+    {
+        {
+            // One call too many, and so many that the length of the array wraps to 0 in 16 bits.
+            const uint32_t sizes[] = { PluginHost::Channel::Batch::MaxCalls + 1, 0x10000 };
+            const string call(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"test.1.echo\"}"));
+
+            for (const uint32_t size : sizes) {
+                ChannelPair channel;
+                EchoBatch collector(*(channel.operator->()));
+                Core::JSONRPC::Batch batch;
+
+                for (uint32_t index = 0; index < size; index++) {
+                    batch.Calls.Add(Core::JSON::String(false)) = call;
+                }
+
+                collector.Execute(batch);
+                EXPECT_EQ(collector.Calls(), 0u);
+                EXPECT_EQ(collector.Replies(), 1u);
+
+                // Refused as a whole, with a single message.
+                Core::JSONRPC::Batch answer;
+                EXPECT_TRUE(answer.FromString(channel->Drain(1000)));
+                EXPECT_FALSE(answer.IsBatch());
+                EXPECT_FALSE(answer.Id.IsSet());
+                EXPECT_EQ(answer.Error.Code.Value(), static_cast<int32_t>(Core::ERROR_INVALID_INPUT_LENGTH));
+            }
+
+            // Nothing to execute is refused as well.
+            ChannelPair channel;
+            EchoBatch collector(*(channel.operator->()));
+            Core::JSONRPC::Batch batch;
+
+            EXPECT_TRUE(batch.FromString(_T("[]")));
+            collector.Execute(batch);
+            EXPECT_EQ(collector.Calls(), 0u);
+            EXPECT_EQ(collector.Replies(), 1u);
+
+            Core::JSONRPC::Batch answer;
+            EXPECT_TRUE(answer.FromString(channel->Drain(1000)));
+            EXPECT_FALSE(answer.IsBatch());
+            EXPECT_EQ(answer.Error.Code.Value(), -32600);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
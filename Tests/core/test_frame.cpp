@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+TEST(Core_Frame, SizeClasses)
+{
+   EXPECT_EQ(Core::FrameBuffer::Capacity(1, 512), 512u);
+   EXPECT_EQ(Core::FrameBuffer::Capacity(513, 512), 4096u);
+   EXPECT_EQ(Core::FrameBuffer::Capacity(4097, 512), 65536u);
+   EXPECT_EQ(Core::FrameBuffer::Capacity(65537, 512), 66048u);
+   EXPECT_EQ(Core::FrameBuffer::Capacity(65537, 0), 66048u);
+}
+
+TEST(Core_Frame, Growth)
+{
+   const string text(3000, 'x');
+   Core::FrameBuffer::Statistics before;
+   Core::FrameBuffer::Statistics after;
+
+   {
+      // Warm up the free list of this thread.
+      Core::FrameType<512> frame;
+      Core::FrameType<512>::Writer writer(frame, 0);
+      writer.Text(text);
+   }
+
+   Core::FrameBuffer::Snapshot(before);
+
+   {
+      Core::FrameType<512> frame;
+      Core::FrameType<512>::Writer writer(frame, 0);
+
+      writer.Text(text);
+      writer.Text(text);
+      EXPECT_EQ(frame.Size(), 2 * (text.length() + sizeof(uint16_t)));
+
+      Core::FrameType<512>::Reader reader(frame, 0);
+      EXPECT_EQ(reader.Text(), text);
+      EXPECT_EQ(reader.Text(), text);
+   }
+
+   Core::FrameBuffer::Snapshot(after);
+
+   // One block to start with, one step to 4KB, one step to 64KB, the first two from the free list.
+   EXPECT_EQ(after.Allocated[0] - before.Allocated[0], 1u);
+   EXPECT_EQ(after.Allocated[1] - before.Allocated[1], 1u);
+   EXPECT_EQ(after.Allocated[2] - before.Allocated[2], 1u);
+   EXPECT_EQ(after.Recycled[0] - before.Recycled[0], 1u);
+   EXPECT_EQ(after.Recycled[1] - before.Recycled[1], 1u);
+
+   Core::FrameBuffer::Snapshot(before);
+
+   {
+      Core::FrameType<512> frame;
+      Core::FrameType<512>::Writer writer(frame, 0);
+
+      // Knowing up front what is coming, takes one step to the right class.
+      writer.Reserve(2 * (text.length() + sizeof(uint16_t)));
+      writer.Text(text);
+      writer.Text(text);
+   }
+
+   Core::FrameBuffer::Snapshot(after);
+
+   EXPECT_EQ(after.Allocated[1] - before.Allocated[1], 0u);
+   EXPECT_EQ(after.Allocated[2] - before.Allocated[2], 1u);
+   EXPECT_EQ(after.Recycled[2] - before.Recycled[2], 1u);
+}
+
+} // Tests
+} // WPEFramework
@@ -3,10 +3,90 @@
 #include <gtest/gtest.h>
 #include <core/core.h>
 
+#include <thread>
+#include <vector>
+
 namespace WPEFramework {
 namespace Tests {
 
     string g_connector = _T("/tmp/testserver");
+    string g_pipelineConnector = _T("/tmp/testpipeline");
+
+    const uint8_t g_pipelineCalls = 4;
+
+    typedef Core::IPCMessageType<1, Core::IPC::ScalarType<uint32_t>, Core::IPC::ScalarType<uint32_t>> PipelineMessage;
+
+    // Holds on to all incoming calls, and answers them, in reverse order, once all have arrived.
+    class ReverseHandler : public Core::IIPCServer {
+    public:
+        ReverseHandler(const ReverseHandler&) = delete;
+        ReverseHandler& operator=(const ReverseHandler&) = delete;
+
+        ReverseHandler()
+            : _lock()
+            , _pending()
+            , _responder()
+        {
+        }
+        virtual ~ReverseHandler()
+        {
+            if (_responder.joinable() == true) {
+                _responder.join();
+            }
+        }
+
+    public:
+        virtual void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& message) override
+        {
+            _lock.Lock();
+
+            _pending.push_back(message);
+
+            if (_pending.size() == g_pipelineCalls) {
+                Core::IPCChannel* channel = &source;
+
+                _responder = std::thread([this, channel]() {
+                    std::vector<Core::ProxyType<Core::IIPC>> calls;
+
+                    _lock.Lock();
+                    calls.swap(_pending);
+                    _lock.Unlock();
+
+                    while (calls.empty() == false) {
+                        Core::ProxyType<PipelineMessage> call(Core::proxy_cast<PipelineMessage>(calls.back()));
+                        call->Response() = call->Parameters().Value() * 2;
+                        channel->ReportResponse(calls.back());
+                        calls.pop_back();
+                    }
+                });
+            }
+
+            _lock.Unlock();
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        std::vector<Core::ProxyType<Core::IIPC>> _pending;
+        std::thread _responder;
+    };
+
+    // The pipelining client closes its end before it syncs "done testing". The server waits till it
+    // has seen that close and let go of the link, before it shuts down.
+    template <typename SERVER>
+    void WaitForClientClose(SERVER& server)
+    {
+        Core::ProxyType<typename SERVER::Client> client(server[0]);
+        uint32_t waited = 0;
+
+        while ((client.IsValid() == true) && (client->Source().IsClosed() == false) && (waited < 100)) {
+            SleepMs(10);
+            waited++;
+        }
+
+        EXPECT_EQ((client.IsValid() == false) || (client->Source().IsClosed() == true), true);
+
+        server.Cleanup();
+    }
 
     TEST(Core_IPC, IPCClientConnection)
     {
@@ -48,5 +128,66 @@ namespace Tests {
         }
         testAdmin.Sync("done testing");
     }
+
+    TEST(Core_IPC, IPCClientPipelining)
+    {
+        IPTestAdministrator::OtherSideMain otherSide = [](IPTestAdministrator & testAdmin) {
+            Core::NodeId serverNode(g_pipelineConnector.c_str());
+            uint32_t error;
+
+            Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+            factory->CreateFactory<PipelineMessage>(g_pipelineCalls);
+
+            Core::ProxyType<ReverseHandler> handler(Core::ProxyType<ReverseHandler>::Create());
+            Core::IPCChannelServerType<Core::Void, false> serverChannel(serverNode, 512, factory);
+            serverChannel.Register(PipelineMessage::Id(), Core::proxy_cast<Core::IIPCServer>(handler));
+            error = serverChannel.Open(1000); // Wait for 1 Second.
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            testAdmin.Sync("setup server");
+            testAdmin.Sync("done testing");
+
+            WaitForClientClose(serverChannel);
+
+            error = serverChannel.Close(1000); // Wait for 1 Second.
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            serverChannel.Unregister(PipelineMessage::Id());
+            factory->DestroyFactories();
+        };
+        IPTestAdministrator testAdmin(otherSide);
+        {
+            Core::NodeId clientNode(g_pipelineConnector.c_str());
+            uint32_t error;
+
+            testAdmin.Sync("setup server");
+
+            Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+            Core::IPCChannelClientType<Core::Void, false, false> clientChannel(clientNode, 512, factory);
+            error = clientChannel.Source().Open(1000); // Wait for 1 Second.
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            // All calls must be outstanding at the same time, the server only answers once all have arrived.
+            std::vector<std::thread> callers;
+            for (uint8_t index = 1; index <= g_pipelineCalls; index++) {
+                callers.emplace_back([&clientChannel, index]() {
+                    Core::ProxyType<PipelineMessage> message(Core::ProxyType<PipelineMessage>::Create());
+                    message->Parameters() = index;
+
+                    EXPECT_EQ(clientChannel.Invoke(message, 2000), Core::ERROR_NONE);
+                    EXPECT_EQ(message->Response().Value(), static_cast<uint32_t>(index * 2));
+                });
+            }
+            for (std::thread& caller : callers) {
+                caller.join();
+            }
+
+            error = clientChannel.Close(1000);
+            EXPECT_EQ(error, Core::ERROR_NONE);
+            factory->DestroyFactories();
+            Core::Singleton::Dispose();
+        }
+        testAdmin.Sync("done testing");
+    }
 } // Tests
 } // WPEFramework
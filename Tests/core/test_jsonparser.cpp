@@ -1,3 +1,4 @@
+#include <chrono>
 #include <functional>
 #include <sstream>
 
@@ -749,6 +750,168 @@ namespace Tests {
         ExecutePrimitiveJsonTest<Core::JSON::EnumType<JSONTestEnum>>(data, false, nullptr);
     }
 
+    class Record : public Core::JSON::Container {
+    public:
+        Record()
+            : Core::JSON::Container()
+        {
+            Init();
+        }
+        Record(const Record& copy)
+            : Core::JSON::Container()
+            , Alpha(copy.Alpha)
+            , Bravo(copy.Bravo)
+            , Charlie(copy.Charlie)
+            , Delta(copy.Delta)
+            , Echo(copy.Echo)
+            , Foxtrot(copy.Foxtrot)
+            , Golf(copy.Golf)
+            , Hotel(copy.Hotel)
+            , India(copy.India)
+            , Juliett(copy.Juliett)
+        {
+            Init();
+        }
+        ~Record() override = default;
+
+        Record& operator=(const Record&) = delete;
+
+    private:
+        void Init()
+        {
+            Add(_T("alpha"), &Alpha);
+            Add(_T("bravo"), &Bravo);
+            Add(_T("charlie"), &Charlie);
+            Add(_T("delta"), &Delta);
+            Add(_T("echo"), &Echo);
+            Add(_T("foxtrot"), &Foxtrot);
+            Add(_T("golf"), &Golf);
+            Add(_T("hotel"), &Hotel);
+            Add(_T("india"), &India);
+            Add(_T("juliett"), &Juliett);
+        }
+
+    public:
+        Core::JSON::DecUInt32 Alpha;
+        Core::JSON::String Bravo;
+        Core::JSON::String Charlie;
+        Core::JSON::DecSInt32 Delta;
+        Core::JSON::Boolean Echo;
+        Core::JSON::String Foxtrot;
+        Core::JSON::DecUInt32 Golf;
+        Core::JSON::String Hotel;
+        Core::JSON::String India;
+        Core::JSON::DecUInt32 Juliett;
+    };
+
+    class Document : public Core::JSON::Container {
+    public:
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        Document()
+            : Core::JSON::Container()
+        {
+            Add(_T("name"), &Name);
+            Add(_T("records"), &Records);
+        }
+        ~Document() override = default;
+
+    public:
+        Core::JSON::String Name;
+        Core::JSON::ArrayType<Record> Records;
+    };
+
+    std::string LargeDocument(const uint32_t records)
+    {
+        std::stringstream text;
+
+        text << "{\"name\":\"large \\\"quoted\\\" document\",\"records\":[";
+        for (uint32_t index = 0; index < records; index++) {
+            text << (index == 0 ? "{" : ",{");
+            // Fields deliberately not in the order they were added, the last ones first.
+            text << "\"juliett\":" << index << ",\"india\":\"i" << index << "\",\"hotel\":\"h\\tab\\/" << index << "\",";
+            text << "\"alpha\":" << index << ",\"bravo\":\"line\\nbreak\",\"charlie\":\"plain text without escapes\",";
+            text << "\"delta\":-" << index << ",\"echo\":true,\"foxtrot\":\"\\u0041\",\"golf\":" << (index * 2);
+            text << "}";
+        }
+        text << "]}";
+
+        return (text.str());
+    }
+
+    TEST(JSONParser, LargeNestedDocument)
+    {
+        const uint32_t records = 2000;
+        const std::string text = LargeDocument(records);
+        Core::OptionalType<Core::JSON::Error> error;
+        Document document;
+
+        // Larger than a single chunk the parser takes at once.
+        EXPECT_GT(text.length(), 0x10000u);
+        EXPECT_TRUE(document.FromString(text, error));
+        EXPECT_FALSE(error.IsSet());
+
+        EXPECT_EQ(document.Name.Value(), _T("large \"quoted\" document"));
+        ASSERT_EQ(document.Records.Length(), records);
+
+        Core::JSON::ArrayType<Record>::Iterator index(document.Records.Elements());
+        uint32_t count = 0;
+
+        while (index.Next() == true) {
+            const Record& record(index.Current());
+
+            EXPECT_EQ(record.Alpha.Value(), count);
+            EXPECT_EQ(record.Bravo.Value(), _T("line\nbreak"));
+            EXPECT_EQ(record.Charlie.Value(), _T("plain text without escapes"));
+            EXPECT_EQ(record.Delta.Value(), -static_cast<int32_t>(count));
+            EXPECT_TRUE(record.Echo.Value());
+            EXPECT_EQ(record.Foxtrot.Value(), _T("\\u0041"));
+            EXPECT_EQ(record.Golf.Value(), count * 2);
+            EXPECT_EQ(record.Hotel.Value(), _T("h\tab/") + std::to_string(count));
+            EXPECT_EQ(record.India.Value(), _T("i") + std::to_string(count));
+            EXPECT_EQ(record.Juliett.Value(), count);
+            count++;
+        }
+
+        // What goes out, must come back in the same.
+        string output;
+        Document copy;
+
+        document.ToString(output);
+        EXPECT_TRUE(copy.FromString(output, error));
+        EXPECT_FALSE(error.IsSet());
+        EXPECT_EQ(copy.Name.Value(), document.Name.Value());
+        EXPECT_EQ(copy.Records.Length(), records);
+        EXPECT_EQ(copy.Records[records - 1].Hotel.Value(), document.Records[records - 1].Hotel.Value());
+    }
+
+    TEST(JSONParser, Benchmark)
+    {
+        const uint32_t iterations = 20;
+        const std::string text = LargeDocument(1000);
+        Core::OptionalType<Core::JSON::Error> error;
+        string output;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (uint32_t index = 0; index < iterations; index++) {
+            Document document;
+            EXPECT_TRUE(document.FromString(text, error));
+        }
+        auto parsed = std::chrono::steady_clock::now();
+        for (uint32_t index = 0; index < iterations; index++) {
+            Document document;
+            document.FromString(text, error);
+            output.clear();
+            document.ToString(output);
+        }
+        auto roundtrip = std::chrono::steady_clock::now();
+
+        printf("JSON: %u x %u bytes, parse %8lld us, parse + serialize %8lld us\n", iterations, static_cast<uint32_t>(text.length()),
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(parsed - begin).count()),
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(roundtrip - parsed).count()));
+    }
+
 } // Tests
 
 ENUM_CONVERSION_BEGIN(Tests::JSONTestEnum){ WPEFramework::Tests::JSONTestEnum::ONE, _TXT("one") },
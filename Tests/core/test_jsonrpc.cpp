@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+TEST(Core_JSONRPC, MethodId)
+{
+   Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+   string response;
+   uint32_t invoked = 0;
+
+   handler.Register(_T("ping"), Core::JSONRPC::InvokeFunction([&invoked](const string& method, const string&, string& result) -> uint32_t {
+      invoked++;
+      result = method;
+      return (Core::ERROR_NONE);
+   }));
+
+   const uint32_t generation = handler.Generation();
+   Core::JSONRPC::Handler::MethodId id = handler.Resolve(_T("ping"));
+
+   ASSERT_NE(id, nullptr);
+   EXPECT_EQ(handler.Resolve(_T("pong")), nullptr);
+
+   EXPECT_EQ(handler.Invoke(id, Core::JSONRPC::Connection(1, 1), _T("ping@7"), _T(""), response), Core::ERROR_NONE);
+   EXPECT_EQ(response, _T("ping@7"));
+   EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 2), _T("ping"), _T(""), response), Core::ERROR_NONE);
+   EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 3), _T("ping@7"), _T(""), response), Core::ERROR_NONE);
+   EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 4), _T("pong"), _T(""), response), Core::ERROR_UNKNOWN_KEY);
+   EXPECT_EQ(invoked, 3u);
+
+   // Any change in the registered methods invalidates resolved ids.
+   handler.Register(_T("pong"), Core::JSONRPC::InvokeFunction([](const string&, const string&, string&) -> uint32_t {
+      return (Core::ERROR_NONE);
+   }));
+   EXPECT_NE(handler.Generation(), generation);
+   EXPECT_NE(handler.Resolve(_T("pong")), nullptr);
+}
+
+TEST(Core_JSONRPC, Broadcast)
+{
+   std::map<string, std::vector<uint32_t>> broadcasts;
+   uint32_t single = 0;
+
+   Core::JSONRPC::Handler handler(
+      [&single](const uint32_t, const string&, const string&) { single++; },
+      [&broadcasts](const std::vector<uint32_t>& ids, const string& designator, const string& data) {
+         EXPECT_EQ(data, _T("{\"state\":1}"));
+         broadcasts[designator] = ids;
+      },
+      { 1 });
+   Core::JSONRPC::Message response;
+
+   handler.Subscribe(1, _T("statechange"), _T("client.events"), response);
+   handler.Subscribe(2, _T("statechange"), _T("client.events"), response);
+   handler.Subscribe(3, _T("statechange"), _T("other"), response);
+   handler.Subscribe(4, _T("statechange"), _T("client.events"), response);
+
+   Core::JSON::Container parameters;
+   Core::JSON::DecUInt32 state;
+   parameters.Add(_T("state"), &state);
+   state = 1;
+
+   EXPECT_EQ(handler.Notify(_T("statechange"), parameters), Core::ERROR_NONE);
+   EXPECT_EQ(single, 0u);
+   ASSERT_EQ(broadcasts.size(), 2u);
+   EXPECT_EQ(broadcasts[_T("client.events.statechange")], std::vector<uint32_t>({ 1, 2, 4 }));
+   EXPECT_EQ(broadcasts[_T("other.statechange")], std::vector<uint32_t>({ 3 }));
+}
+
+TEST(Core_JSONRPC, Batch)
+{
+   Core::JSONRPC::Batch batch;
+
+   EXPECT_TRUE(batch.FromString(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"}")));
+   EXPECT_FALSE(batch.IsBatch());
+   EXPECT_EQ(batch.Designator.Value(), _T("Controller.1.status"));
+
+   batch.Clear();
+   EXPECT_TRUE(batch.FromString(_T(" [{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"a.1.b\",\"params\":[1,2]}, {\"jsonrpc\":\"2.0\",\"method\":\"c.1.d\"}, 3]")));
+   EXPECT_TRUE(batch.IsBatch());
+   ASSERT_EQ(batch.Calls.Length(), 3u);
+
+   Core::JSONRPC::Message call;
+   EXPECT_TRUE(call.FromString(batch.Calls[0].Value()));
+   EXPECT_EQ(call.Id.Value(), 1u);
+   EXPECT_EQ(call.Designator.Value(), _T("a.1.b"));
+   EXPECT_EQ(call.Parameters.Value(), _T("[1,2]"));
+
+   // Responses are collected in the order they are added.
+   Core::JSONRPC::Batch responses;
+   Core::JSONRPC::Message response;
+   string text;
+
+   response.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+   response.Id = 2;
+   response.Result = _T("true");
+   responses.Add(response);
+   response.Clear();
+   response.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+   response.Id = 1;
+   response.Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
+   responses.Add(response);
+
+   responses.ToString(text);
+   EXPECT_EQ(text, _T("[{\"jsonrpc\":\"2.0\",\"id\":2,\"result\":true},{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":{\"code\":-32600}}]"));
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class PooledElement {
+    public:
+        PooledElement(const PooledElement&) = delete;
+        PooledElement& operator=(const PooledElement&) = delete;
+
+        PooledElement()
+            : _value(0)
+        {
+        }
+        ~PooledElement()
+        {
+        }
+
+    public:
+        void Clear()
+        {
+            _value = 0;
+        }
+        uint32_t Value() const
+        {
+            return (_value);
+        }
+        void Value(const uint32_t value)
+        {
+            _value = value;
+        }
+
+    private:
+        uint32_t _value;
+    };
+
+    TEST(Core_ProxyPool, Reuse)
+    {
+        Core::ProxyPoolType<PooledElement> pool(2);
+        const PooledElement* first;
+
+        {
+            Core::ProxyType<PooledElement> element(pool.Element());
+            element->Value(42);
+            first = &(*element);
+            EXPECT_EQ(pool.OutstandingElements(), 1u);
+        }
+
+        // The element went to the cache of this thread, it is handed out again, cleared.
+        Core::ProxyType<PooledElement> element(pool.Element());
+        EXPECT_EQ(&(*element), first);
+        EXPECT_EQ(element->Value(), 0u);
+        EXPECT_EQ(pool.CreatedElements(), 1u);
+
+        // The counters of this thread are accounted for, while it is still using the pool.
+        EXPECT_EQ(pool.ReusedElements(), 1u);
+        EXPECT_EQ(pool.OutstandingElements(), 1u);
+        EXPECT_EQ(pool.QueuedElements(), 0u);
+
+        element.Release();
+
+        EXPECT_EQ(pool.OutstandingElements(), 0u);
+        EXPECT_EQ(pool.QueuedElements(), 1u);
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_ProxyPool, CrossThread)
+    {
+        Core::ProxyPoolType<PooledElement> pool(2);
+        const uint8_t threads = 4;
+        const uint32_t rounds = 20000;
+        std::thread workers[threads];
+
+        // Every thread holds on to a different number of elements, so full and empty magazines travel through the depot.
+        for (uint8_t index = 0; index < threads; index++) {
+            workers[index] = std::thread([&pool, index]() {
+                std::list<Core::ProxyType<PooledElement>> held;
+
+                for (uint32_t round = 0; round < rounds; round++) {
+                    Core::ProxyType<PooledElement> element(pool.Element());
+                    EXPECT_EQ(element->Value(), 0u);
+                    element->Value(round + 1);
+                    held.push_back(element);
+
+                    if (held.size() > (index * 20u)) {
+                        held.pop_front();
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        // All threads are gone, so all counters are accounted for.
+        EXPECT_EQ(pool.OutstandingElements(), 0u);
+        EXPECT_EQ(pool.CreatedElements() + pool.ReusedElements(), threads * rounds);
+        EXPECT_LT(pool.CreatedElements(), 400u);
+        EXPECT_EQ(pool.QueuedElements(), pool.CreatedElements());
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Tests {
+
+const uint32_t g_queueSize = 16;
+const uint8_t g_producers = 4;
+const uint8_t g_consumers = 4;
+const uint32_t g_entries = 200000;
+
+template <typename QUEUE>
+uint64_t Exchange(QUEUE& queue, uint64_t& total)
+{
+   std::atomic<uint64_t> sum(0);
+   std::vector<std::thread> producers;
+   std::vector<std::thread> consumers;
+
+   auto start = std::chrono::steady_clock::now();
+
+   for (uint8_t index = 0; index < g_consumers; index++) {
+       consumers.emplace_back([&queue, &sum]() {
+           uint32_t entry;
+           while (queue.Extract(entry, Core::infinite) == true) {
+               sum += entry;
+           }
+       });
+   }
+   for (uint8_t index = 0; index < g_producers; index++) {
+       producers.emplace_back([&queue]() {
+           for (uint32_t entry = 1; entry <= g_entries; entry++) {
+               queue.Insert(entry, Core::infinite);
+           }
+       });
+   }
+   for (std::thread& producer : producers) {
+       producer.join();
+   }
+   while (queue.IsEmpty() == false) {
+       std::this_thread::yield();
+   }
+   queue.Disable();
+   for (std::thread& consumer : consumers) {
+       consumer.join();
+   }
+
+   total = sum;
+
+   return (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+TEST(Core_LockFreeQueue, PostExtract)
+{
+   Core::LockFreeQueueType<uint32_t> queue(g_queueSize);
+   uint32_t entry = 0;
+
+   EXPECT_TRUE(queue.IsEmpty());
+   EXPECT_FALSE(queue.Extract(entry, 0));
+
+   for (uint32_t index = 1; index <= g_queueSize; index++) {
+       EXPECT_TRUE(queue.Post(index));
+   }
+   EXPECT_TRUE(queue.IsFull());
+   EXPECT_FALSE(queue.Insert(g_queueSize + 1, 10));
+   EXPECT_EQ(queue.Length(), g_queueSize);
+
+   // Like the QueueType, posting does not stop at the high water mark.
+   for (uint32_t index = g_queueSize + 1; index <= (4 * g_queueSize); index++) {
+       EXPECT_TRUE(queue.Post(index));
+   }
+   EXPECT_EQ(queue.Length(), 4 * g_queueSize);
+
+   for (uint32_t index = 1; index <= (2 * g_queueSize); index++) {
+       EXPECT_TRUE(queue.Extract(entry, 0));
+       EXPECT_EQ(entry, index);
+   }
+   EXPECT_TRUE(queue.Remove(3 * g_queueSize));
+   EXPECT_TRUE(queue.Post(4 * g_queueSize + 1));
+
+   for (uint32_t index = (2 * g_queueSize) + 1; index <= (4 * g_queueSize) + 1; index++) {
+       if (index != (3 * g_queueSize)) {
+           EXPECT_TRUE(queue.Extract(entry, 0));
+           EXPECT_EQ(entry, index);
+       }
+   }
+   EXPECT_TRUE(queue.IsEmpty());
+   EXPECT_FALSE(queue.Extract(entry, 0));
+}
+
+TEST(Core_LockFreeQueue, Remove)
+{
+   Core::LockFreeQueueType<uint32_t> queue(g_queueSize);
+   uint32_t entry = 0;
+
+   queue.Post(1);
+   queue.Post(2);
+   queue.Post(3);
+
+   EXPECT_TRUE(queue.Remove(2));
+   EXPECT_FALSE(queue.Remove(2));
+   EXPECT_FALSE(queue.Remove(4));
+
+   EXPECT_TRUE(queue.Extract(entry, 0));
+   EXPECT_EQ(entry, 1u);
+   EXPECT_TRUE(queue.Extract(entry, 0));
+   EXPECT_EQ(entry, 3u);
+   EXPECT_FALSE(queue.Extract(entry, 0));
+   EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(Core_LockFreeQueue, Disable)
+{
+   Core::LockFreeQueueType<uint32_t> queue(g_queueSize);
+   uint32_t entry = 0;
+
+   std::thread consumer([&queue, &entry]() {
+       EXPECT_FALSE(queue.Extract(entry, Core::infinite));
+   });
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   queue.Disable();
+   consumer.join();
+
+   EXPECT_FALSE(queue.Post(1));
+   queue.Enable();
+   EXPECT_TRUE(queue.Post(1));
+   EXPECT_TRUE(queue.Extract(entry, Core::infinite));
+   EXPECT_EQ(entry, 1u);
+}
+
+TEST(Core_LockFreeQueue, Throughput)
+{
+   const uint64_t expected = static_cast<uint64_t>(g_producers) * g_entries * (g_entries + 1) / 2;
+   uint64_t total = 0;
+
+   Core::QueueType<uint32_t> locked(g_queueSize);
+   uint64_t lockedTime = Exchange(locked, total);
+   EXPECT_EQ(total, expected);
+
+   Core::LockFreeQueueType<uint32_t> lockFree(g_queueSize);
+   uint64_t lockFreeTime = Exchange(lockFree, total);
+   EXPECT_EQ(total, expected);
+
+   printf("QueueType:         %8llu us for %u entries\n", static_cast<unsigned long long>(lockedTime), g_producers * g_entries);
+   printf("LockFreeQueueType: %8llu us for %u entries\n", static_cast<unsigned long long>(lockFreeTime), g_producers * g_entries);
+}
+
+} // Tests
+} // WPEFramework
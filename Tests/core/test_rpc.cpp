@@ -286,3 +286,64 @@ TEST(Core_RPC, adder)
    testAdmin.Sync("done testing");
    Core::Singleton::Dispose();
 }
+
+TEST(Core_RPC, sharedRing)
+{
+   const string ringName(g_connectorName + _T(".ring.test"));
+   uint8_t block[RPC::SharedRing::SlotSize];
+   uint32_t length = 0;
+
+   for (uint32_t index = 0; index < sizeof(block); index++) {
+      block[index] = static_cast<uint8_t>(index);
+   }
+
+   {
+      RPC::SharedRing host(ringName, 2);
+      ASSERT_TRUE(host.IsValid());
+      EXPECT_FALSE(host.IsAttached());
+
+      // Nobody attached yet, everything goes inline.
+      EXPECT_EQ(host.Write(block, 1024), RPC::SharedRing::NoSlot);
+
+      RPC::SharedRing client(ringName);
+      ASSERT_TRUE(client.IsValid());
+      client.Attach();
+      EXPECT_TRUE(host.IsAttached());
+
+      uint16_t first = host.Write(block, 1024);
+      uint16_t second = host.Write(block, sizeof(block));
+      ASSERT_NE(first, RPC::SharedRing::NoSlot);
+      ASSERT_NE(second, RPC::SharedRing::NoSlot);
+      EXPECT_EQ(host.Write(block, 1024), RPC::SharedRing::NoSlot);
+      EXPECT_EQ(host.Write(block, sizeof(block) + 1), RPC::SharedRing::NoSlot);
+
+      // Our own slots can not be read, those of the other side can, in any order.
+      EXPECT_EQ(host.Data(first, length), nullptr);
+
+      const uint8_t* data = client.Data(second, length);
+      ASSERT_NE(data, nullptr);
+      EXPECT_EQ(length, sizeof(block));
+      EXPECT_EQ(::memcmp(data, block, sizeof(block)), 0);
+      client.Release(second);
+
+      // The length sits right in front of the data, a length that does not fit the slot is refused.
+      data = client.Data(first, length);
+      ASSERT_NE(data, nullptr);
+      EXPECT_EQ(length, 1024u);
+      *(reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(data)) - 1) = RPC::SharedRing::SlotSize + 1;
+      EXPECT_EQ(client.Data(first, length), nullptr);
+      EXPECT_EQ(length, 0u);
+
+      EXPECT_EQ(host.Write(block, 512), second);
+
+      uint16_t back = client.Write(&(block[7]), 100);
+      ASSERT_NE(back, RPC::SharedRing::NoSlot);
+      data = host.Data(back, length);
+      ASSERT_NE(data, nullptr);
+      EXPECT_EQ(length, 100u);
+      EXPECT_EQ(::memcmp(data, &(block[7]), 100), 0);
+      host.Release(back);
+   }
+
+   EXPECT_FALSE(Core::File(ringName).Exists());
+}
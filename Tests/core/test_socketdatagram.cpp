@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    const uint16_t g_datagramPort = 12741;
+    const uint8_t g_datagramBurst = 32;
+
+    class DatagramSink : public Core::SocketDatagram {
+    public:
+        DatagramSink(const DatagramSink&) = delete;
+        DatagramSink& operator=(const DatagramSink&) = delete;
+
+        DatagramSink(const Core::NodeId& localNode)
+            : Core::SocketDatagram(false, localNode, Core::NodeId(), 1024, 32768)
+            , _received(0)
+            , _batches(0)
+            , _errors(0)
+        {
+        }
+        ~DatagramSink() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint32_t Received() const
+        {
+            return (_received.load());
+        }
+        uint32_t Batches() const
+        {
+            return (_batches.load());
+        }
+        uint32_t Errors() const
+        {
+            return (_errors.load());
+        }
+
+        uint32_t SendData(uint8_t*, const uint32_t) override
+        {
+            return (0);
+        }
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
+        {
+            uint32_t sequence;
+
+            if ((receivedSize != sizeof(sequence)) || (ReceivedNode().IsValid() == false)) {
+                _errors++;
+            } else {
+                ::memcpy(&sequence, dataFrame, sizeof(sequence));
+
+                if (sequence != _received.load()) {
+                    _errors++;
+                }
+            }
+
+            _received++;
+
+            return (receivedSize);
+        }
+        void ReceiveBatch(const Datagram batch[], const uint8_t count) override
+        {
+            _batches++;
+
+            Core::SocketDatagram::ReceiveBatch(batch, count);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        std::atomic<uint32_t> _received;
+        std::atomic<uint32_t> _batches;
+        std::atomic<uint32_t> _errors;
+    };
+
+    // Sends bursts of datagrams over the loopback and waits for each burst to arrive, returns the
+    // number of datagrams handled per second.
+    uint32_t DatagramThroughput(const uint8_t batch, const uint32_t bursts, uint32_t& batches)
+    {
+        DatagramSink sink(Core::NodeId(_T("127.0.0.1"), g_datagramPort));
+        struct sockaddr_in destination;
+
+        ::memset(&destination, 0, sizeof(destination));
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(g_datagramPort);
+        destination.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        sink.Batch(batch);
+        EXPECT_EQ(sink.Open(1000), Core::ERROR_NONE);
+
+        int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+        EXPECT_GE(sender, 0);
+
+        auto begin = std::chrono::steady_clock::now();
+        uint32_t sequence = 0;
+
+        for (uint32_t burst = 0; burst < bursts; burst++) {
+            for (uint8_t index = 0; index < g_datagramBurst; index++, sequence++) {
+                ::sendto(sender, &sequence, sizeof(sequence), 0, reinterpret_cast<struct sockaddr*>(&destination), sizeof(destination));
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while ((sink.Received() < sequence) && (std::chrono::steady_clock::now() < deadline)) {
+                std::this_thread::yield();
+            }
+            if (sink.Received() < sequence) {
+                break;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        const long long duration = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+        ::close(sender);
+
+        EXPECT_EQ(sink.Received(), sequence);
+        EXPECT_EQ(sink.Errors(), 0u);
+
+        batches = sink.Batches();
+
+        return (duration > 0 ? static_cast<uint32_t>((static_cast<uint64_t>(sink.Received()) * 1000000) / duration) : 0);
+    }
+
+    TEST(Core_SocketDatagram, Batch)
+    {
+        const uint32_t bursts = 500;
+        uint32_t batches = 0;
+
+        const uint32_t single = DatagramThroughput(0, bursts, batches);
+        EXPECT_EQ(batches, 0u);
+
+        const uint32_t batched = DatagramThroughput(g_datagramBurst, bursts, batches);
+        EXPECT_GT(batches, 0u);
+        EXPECT_LE(batches, bursts * g_datagramBurst);
+
+        printf("Datagrams: %u x %u, one by one %8u/s, batched %8u/s, %.1f per batch\n", bursts, g_datagramBurst, single, batched,
+            (batches > 0 ? static_cast<double>(bursts * g_datagramBurst) / batches : 0.0));
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Hands out the queued messages one by one, in pieces if they do not fit, the way a link
+    // serializes its queue. The socket gathers as many of them as fit into a single send.
+    class StreamSender : public Core::SocketStream {
+    public:
+        StreamSender(const StreamSender&) = delete;
+        StreamSender& operator=(const StreamSender&) = delete;
+
+        StreamSender(const SOCKET& connector, const std::vector<string>& messages)
+            : Core::SocketStream(false, connector, Core::NodeId(), 1024, 1024)
+            , _adminLock()
+            , _messages(messages)
+            , _index(0)
+            , _offset(0)
+        {
+        }
+        ~StreamSender() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+        {
+            uint32_t result = 0;
+
+            _adminLock.Lock();
+
+            if (_index < _messages.size()) {
+                const string& message(_messages[_index]);
+
+                result = std::min(static_cast<uint32_t>(message.length() - _offset), maxSendSize);
+                ::memcpy(dataFrame, &(message[_offset]), result);
+                _offset += result;
+
+                if (_offset == message.length()) {
+                    _index++;
+                    _offset = 0;
+                }
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        const std::vector<string>& _messages;
+        uint32_t _index;
+        uint32_t _offset;
+    };
+
+    // Sends 2000 messages over a TCP connection on the loopback and checks they arrive intact and
+    // in order. A segment size other than 0 is advertised by the receiving end. The sending end
+    // gets TCP_NODELAY if asked for, it should still have it after all is sent.
+    static void GatheredSends(const int segmentSize, const int noDelay = 0)
+    {
+        {
+            struct sockaddr_in address;
+            socklen_t size = sizeof(address);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_GE(listener, 0);
+            ASSERT_EQ(::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            ASSERT_EQ(::listen(listener, 1), 0);
+            ASSERT_EQ(::getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &size), 0);
+
+            int receiver = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_GE(receiver, 0);
+            if (segmentSize != 0) {
+                ASSERT_EQ(::setsockopt(receiver, IPPROTO_TCP, TCP_MAXSEG, &segmentSize, sizeof(segmentSize)), 0);
+            }
+            ASSERT_EQ(::connect(receiver, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+
+            int connector = ::accept(listener, nullptr, nullptr);
+            ASSERT_GE(connector, 0);
+            ::close(listener);
+            ASSERT_EQ(::setsockopt(connector, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)), 0);
+
+            // Messages from a single byte up to more than the send buffer, far more than the
+            // kernel takes in at once.
+            std::vector<string> messages;
+            string expected;
+
+            for (uint32_t index = 0; index < 2000; index++) {
+                string message(1 + ((index * 37) % 1500), static_cast<char>('a' + (index % 26)));
+                message[0] = static_cast<char>(index & 0xFF);
+                expected += message;
+                messages.push_back(message);
+            }
+
+            StreamSender sender(connector, messages);
+            ASSERT_EQ(sender.Open(0), Core::ERROR_NONE);
+            sender.Trigger();
+
+            struct timeval timeout = { 5, 0 };
+            ::setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            string received;
+            char buffer[4096];
+            ssize_t length;
+
+            while ((received.length() < expected.length()) && ((length = ::recv(receiver, buffer, sizeof(buffer), 0)) > 0)) {
+                received.append(buffer, length);
+            }
+
+            EXPECT_EQ(received.length(), expected.length());
+            EXPECT_TRUE(received == expected);
+
+            int flag = -1;
+            socklen_t flagSize = sizeof(flag);
+            EXPECT_EQ(::getsockopt(connector, IPPROTO_TCP, TCP_NODELAY, &flag, &flagSize), 0);
+            EXPECT_EQ((flag != 0), (noDelay != 0));
+
+            ::close(receiver);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketStream, GatheredSendsInOrder)
+    {
+        // The loopback segments are larger than the kernel send buffer of the link, it does not cork.
+        GatheredSends(0);
+    }
+
+    TEST(Core_SocketStream, CorkedSendsInOrder)
+    {
+        // With small segments, full buffers go out with MSG_MORE.
+        GatheredSends(1000);
+    }
+
+    TEST(Core_SocketStream, CorkedSendsKeepNoDelay)
+    {
+        GatheredSends(1000, 1);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Core_Time, CalendarFields)
+    {
+        // 2019-12-31 23:59:58.250 GMT, given as ticks, so the fields are filled in on access.
+        const Core::Time time(Core::Time(2019, 12, 31, 23, 59, 58, 250, false).Ticks(), false);
+        const Core::Time copy(time);
+
+        EXPECT_EQ(time.Year(), 2019u);
+        EXPECT_EQ(time.Month(), 12);
+        EXPECT_EQ(time.Day(), 31);
+        EXPECT_EQ(time.Hours(), 23);
+        EXPECT_EQ(time.Minutes(), 59);
+        EXPECT_EQ(time.Seconds(), 58);
+        EXPECT_EQ(time.MilliSeconds(), 250u);
+        EXPECT_EQ(time.DayOfWeek(), 2);
+        EXPECT_FALSE(time.IsLocalTime());
+
+        EXPECT_EQ(copy.ToRFC1123(false), _T("Tue, 31 Dec 2019 23:59:58 GMT"));
+        EXPECT_EQ(Core::Time(copy).Add(2000).ToISO8601(false), _T("2020-01-01T00:00:00Z"));
+    }
+
+    TEST(Core_Time, SharedBetweenThreads)
+    {
+        // The first access from any of the threads fills in the fields, all of them see the same.
+        const Core::Time time(Core::Time(2019, 12, 31, 23, 59, 58, 250, false).Ticks(), false);
+        std::thread readers[4];
+        std::atomic<uint8_t> correct(0);
+
+        for (std::thread& reader : readers) {
+            reader = std::thread([&time, &correct]() {
+                if ((time.Year() == 2019u) && (time.Day() == 31) && (time.Seconds() == 58) && (time.ToRFC1123(false) == _T("Tue, 31 Dec 2019 23:59:58 GMT"))) {
+                    correct++;
+                }
+            });
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(correct.load(), sizeof(readers) / sizeof(std::thread));
+    }
+
+    TEST(Core_Time, Monotonic)
+    {
+        const uint64_t start = Core::Time::Monotonic();
+
+        SleepMs(10);
+
+        const uint64_t elapsed = Core::Time::Monotonic() - start;
+
+        EXPECT_GE(elapsed, 10000u);
+        EXPECT_LT(elapsed, 1000000u);
+        EXPECT_TRUE(Core::Time::Now().IsValid());
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Tests {
+
+const uint32_t g_revokeCount = 1000;
+
+class TimedEntry {
+public:
+   TimedEntry() = delete;
+   TimedEntry& operator=(const TimedEntry&) = delete;
+
+   TimedEntry(std::vector<uint32_t>* fired, std::mutex* lock, const uint32_t id, const uint8_t repeat = 0)
+       : _fired(fired)
+       , _lock(lock)
+       , _id(id)
+       , _repeat(repeat)
+   {
+   }
+   TimedEntry(const TimedEntry& copy)
+       : _fired(copy._fired)
+       , _lock(copy._lock)
+       , _id(copy._id)
+       , _repeat(copy._repeat)
+   {
+   }
+   ~TimedEntry()
+   {
+   }
+
+   bool operator==(const TimedEntry& RHS) const
+   {
+       return (_id == RHS._id);
+   }
+   bool operator!=(const TimedEntry& RHS) const
+   {
+       return (!operator==(RHS));
+   }
+   uint32_t Hash() const
+   {
+       return (_id);
+   }
+
+public:
+   uint64_t Timed(const uint64_t scheduledTime)
+   {
+       uint64_t result = 0;
+
+       // Never handled before its time.
+       EXPECT_GE(Core::Time::Now().Ticks(), scheduledTime);
+
+       if (_fired != nullptr) {
+           std::lock_guard<std::mutex> guard(*_lock);
+           _fired->push_back(_id);
+       }
+       if (_repeat > 0) {
+           _repeat--;
+           result = Core::Time::Now().Add(5).Ticks();
+       }
+       return (result);
+   }
+
+private:
+   std::vector<uint32_t>* _fired;
+   std::mutex* _lock;
+   const uint32_t _id;
+   uint8_t _repeat;
+};
+
+// The sorted list, TimerType used before the timing wheel, as a reference.
+class SortedList {
+public:
+   void Schedule(const uint64_t time, const uint32_t id)
+   {
+       std::list<std::pair<uint64_t, uint32_t>>::iterator index(_entries.begin());
+
+       while ((index != _entries.end()) && (time >= index->first)) {
+           ++index;
+       }
+       _entries.insert(index, std::pair<uint64_t, uint32_t>(time, id));
+   }
+   bool Revoke(const uint32_t id)
+   {
+       bool found = false;
+       std::list<std::pair<uint64_t, uint32_t>>::iterator index(_entries.begin());
+
+       while (index != _entries.end()) {
+           if (index->second == id) {
+               index = _entries.erase(index);
+               found = true;
+           } else {
+               ++index;
+           }
+       }
+       return (found);
+   }
+
+private:
+   std::list<std::pair<uint64_t, uint32_t>> _entries;
+};
+
+bool WaitFor(std::vector<uint32_t>& fired, std::mutex& lock, const uint32_t count)
+{
+   uint32_t waited = 0;
+   bool result = false;
+
+   while ((result == false) && (waited < 2000)) {
+       {
+           std::lock_guard<std::mutex> guard(lock);
+           result = (fired.size() >= count);
+       }
+       if (result == false) {
+           std::this_thread::sleep_for(std::chrono::milliseconds(1));
+           waited++;
+       }
+   }
+   return (result);
+}
+
+void Benchmark(const uint32_t timers)
+{
+   const uint64_t start = Core::Time::Now().Add(60 * 60 * 1000).Ticks();
+   const uint32_t stride = (timers / g_revokeCount);
+
+   SortedList list;
+   auto begin = std::chrono::steady_clock::now();
+   for (uint32_t index = 0; index < timers; index++) {
+       list.Schedule(start + ((index * 7919) % timers) * Core::Time::TicksPerMillisecond, index);
+   }
+   auto scheduled = std::chrono::steady_clock::now();
+   for (uint32_t index = 0; index < g_revokeCount; index++) {
+       EXPECT_TRUE(list.Revoke(index * stride));
+   }
+   auto revoked = std::chrono::steady_clock::now();
+
+   printf("SortedList: %u timers, schedule %8lld us, revoke %u %8lld us\n", timers,
+       static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(scheduled - begin).count()), g_revokeCount,
+       static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(revoked - scheduled).count()));
+
+   Core::TimerType<TimedEntry> timer(Core::Thread::DefaultStackSize(), _T("BenchmarkTimer"));
+   std::vector<Core::TimerType<TimedEntry>::Handle> handles;
+   handles.reserve(timers);
+
+   begin = std::chrono::steady_clock::now();
+   for (uint32_t index = 0; index < timers; index++) {
+       handles.push_back(timer.Schedule(start + ((index * 7919) % timers) * Core::Time::TicksPerMillisecond, TimedEntry(nullptr, nullptr, index)));
+   }
+   scheduled = std::chrono::steady_clock::now();
+   for (uint32_t index = 0; index < g_revokeCount; index++) {
+       EXPECT_TRUE(timer.Revoke(handles[index * stride]));
+   }
+   revoked = std::chrono::steady_clock::now();
+   for (uint32_t index = 0; index < g_revokeCount; index++) {
+       EXPECT_TRUE(timer.Revoke(TimedEntry(nullptr, nullptr, (index * stride) + 1)));
+   }
+   auto compared = std::chrono::steady_clock::now();
+
+   EXPECT_EQ(timer.Pending(), timers - (2 * g_revokeCount));
+
+   printf("TimerType:  %u timers, schedule %8lld us, revoke %u %8lld us, by content %8lld us\n", timers,
+       static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(scheduled - begin).count()), g_revokeCount,
+       static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(revoked - scheduled).count()),
+       static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(compared - revoked).count()));
+}
+
+TEST(Core_Timer, Order)
+{
+   std::vector<uint32_t> fired;
+   std::mutex lock;
+   Core::TimerType<TimedEntry> timer(Core::Thread::DefaultStackSize(), _T("TestTimer"));
+
+   timer.Schedule(Core::Time::Now().Add(30), TimedEntry(&fired, &lock, 3));
+   timer.Schedule(Core::Time::Now().Add(10), TimedEntry(&fired, &lock, 1));
+   timer.Schedule(Core::Time::Now().Add(20), TimedEntry(&fired, &lock, 2));
+   timer.Schedule(Core::Time::Now().Add(300), TimedEntry(&fired, &lock, 4));
+   EXPECT_EQ(timer.Pending(), 4u);
+
+   EXPECT_TRUE(WaitFor(fired, lock, 4));
+
+   std::lock_guard<std::mutex> guard(lock);
+   ASSERT_EQ(fired.size(), 4u);
+   for (uint32_t index = 0; index < fired.size(); index++) {
+       EXPECT_EQ(fired[index], index + 1);
+   }
+   EXPECT_EQ(timer.Pending(), 0u);
+}
+
+TEST(Core_Timer, Revoke)
+{
+   std::vector<uint32_t> fired;
+   std::mutex lock;
+   Core::TimerType<TimedEntry> timer(Core::Thread::DefaultStackSize(), _T("TestTimer"));
+
+   Core::TimerType<TimedEntry>::Handle handle = timer.Schedule(Core::Time::Now().Add(20), TimedEntry(&fired, &lock, 1));
+   timer.Schedule(Core::Time::Now().Add(20), TimedEntry(&fired, &lock, 2));
+   timer.Schedule(Core::Time::Now().Add(40), TimedEntry(&fired, &lock, 3));
+   timer.Schedule(Core::Time::Now().Add(24 * 60 * 60 * 1000), TimedEntry(&fired, &lock, 4));
+
+   EXPECT_TRUE(handle.IsValid());
+   EXPECT_TRUE(timer.Revoke(handle));
+   EXPECT_FALSE(timer.Revoke(handle));
+   EXPECT_TRUE(timer.Revoke(TimedEntry(nullptr, nullptr, 2)));
+   EXPECT_FALSE(timer.Revoke(TimedEntry(nullptr, nullptr, 2)));
+   EXPECT_EQ(timer.Pending(), 2u);
+
+   EXPECT_TRUE(WaitFor(fired, lock, 1));
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+   std::lock_guard<std::mutex> guard(lock);
+   ASSERT_EQ(fired.size(), 1u);
+   EXPECT_EQ(fired[0], 3u);
+   EXPECT_EQ(timer.Pending(), 1u);
+}
+
+TEST(Core_Timer, Reschedule)
+{
+   std::vector<uint32_t> fired;
+   std::mutex lock;
+   Core::TimerType<TimedEntry> timer(Core::Thread::DefaultStackSize(), _T("TestTimer"));
+
+   timer.Schedule(Core::Time::Now().Add(5), TimedEntry(&fired, &lock, 1, 3));
+   timer.Trigger(Core::Time::Now().Add(10).Ticks(), TimedEntry(&fired, &lock, 2));
+   timer.Trigger(Core::Time::Now().Add(50).Ticks(), TimedEntry(&fired, &lock, 2));
+   EXPECT_EQ(timer.Pending(), 2u);
+
+   EXPECT_TRUE(WaitFor(fired, lock, 5));
+
+   std::lock_guard<std::mutex> guard(lock);
+   EXPECT_EQ(std::count(fired.begin(), fired.end(), 1u), 4);
+   EXPECT_EQ(std::count(fired.begin(), fired.end(), 2u), 1);
+}
+
+TEST(Core_Timer, Benchmark10k)
+{
+   Benchmark(10000);
+}
+
+TEST(Core_Timer, DISABLED_Benchmark100k)
+{
+   Benchmark(100000);
+}
+
+} // Tests
+} // WPEFramework
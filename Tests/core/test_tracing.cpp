@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <tracing/tracing.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class TraceText : public Trace::ITrace {
+    public:
+        TraceText(const TraceText&) = delete;
+        TraceText& operator=(const TraceText&) = delete;
+
+        TraceText(const string& text)
+            : _text(text)
+        {
+        }
+
+    public:
+        const char* Category() const override
+        {
+            return (_T("Information"));
+        }
+        const char* Module() const override
+        {
+            return (_T("Tests"));
+        }
+        const char* Data() const override
+        {
+            return (_text.c_str());
+        }
+        uint16_t Length() const override
+        {
+            return (static_cast<uint16_t>(_text.length()));
+        }
+
+    private:
+        const string _text;
+    };
+
+    TEST(Trace_TraceUnit, RingsMergedInOrder)
+    {
+        const string path(_T("/tmp/tracingtest/"));
+        const uint8_t threads = 4;
+        const uint8_t records = 40;
+
+        Core::Directory(path.c_str()).CreatePath();
+        ASSERT_EQ(Trace::TraceUnit::Instance().Open(path), Core::ERROR_NONE);
+
+        std::thread tracers[threads];
+        std::atomic<uint8_t> done(0);
+
+        for (uint8_t index = 0; index < threads; index++) {
+            tracers[index] = std::thread([index, &done]() {
+                for (uint8_t record = 0; record < records; record++) {
+                    TraceText text(Core::NumberType<uint8_t>(index).Text() + ':' + Core::NumberType<uint8_t>(record).Text());
+                    Trace::TraceUnit::Instance().Trace(__FILE__, __LINE__, "TraceText", &text);
+                }
+
+                // Keep the ring claimed until all threads traced, so each thread has its own.
+                done++;
+                while (done.load() != threads) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (std::thread& tracer : tracers) {
+            tracer.join();
+        }
+
+        Trace::TraceReader reader(path + Trace::CyclicBufferName);
+        ASSERT_TRUE(reader.IsValid());
+
+        uint8_t buffer[Trace::CyclicBufferSize];
+        uint16_t length;
+        uint64_t last = 0;
+        uint32_t count = 0;
+        int next[threads] = {};
+
+        while ((length = reader.Read(buffer, sizeof(buffer))) != 0) {
+            uint64_t ticks;
+            ::memcpy(&ticks, &(buffer[2]), sizeof(ticks));
+            EXPECT_LE(last, ticks);
+            last = ticks;
+
+            // Skip the line number and the four zero terminated names to get to the text.
+            const char* text = reinterpret_cast<const char*>(&(buffer[14]));
+            for (uint8_t field = 0; field < 4; field++) {
+                text += strlen(text) + 1;
+            }
+            const string data(text, length - (text - reinterpret_cast<const char*>(buffer)));
+            const uint8_t thread = static_cast<uint8_t>(atoi(data.c_str()));
+            ASSERT_LT(thread, threads);
+            EXPECT_EQ(atoi(data.c_str() + data.find(':') + 1), next[thread]);
+            next[thread]++;
+            count++;
+        }
+
+        EXPECT_EQ(count, static_cast<uint32_t>(threads * records));
+
+        Trace::TraceUnit::Instance().Close();
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Trace_TraceUnit, CompactRecords)
+    {
+        const string path(_T("/tmp/tracingtest/"));
+
+        Core::Directory(path.c_str()).CreatePath();
+        ASSERT_EQ(Trace::TraceUnit::Instance().Open(path), Core::ERROR_NONE);
+
+        Trace::CallSite site(__FILE__, 42, _T("CompactRecords"), _T("Tests"), _T("Information"));
+        Trace::CallSite other(__FILE__, 43, _T("CompactRecords"), _T("Tests"), _T("Information"));
+        Trace::CallSite sized(__FILE__, 44, _T("CompactRecords"), _T("Tests"), _T("Information"));
+        const string name(_T("text"));
+
+        TraceText text(_T("as text"));
+        Trace::TraceUnit::Instance().Trace(__FILE__, 41, "TraceText", &text);
+        site.Trace(_T("%s %d of %u, %5.2f%% %c %04x %s [%*d]"), _T("record"), -3, 10u, 99.5, 'z', 255, name, 4, 7);
+        other.Trace(_T("%d %s"), 1);
+        sized.Trace(_T("%x %u %d %d %hhx %hd %llx"), -1, -1, static_cast<int8_t>(-5), 3000000000u, 0x1ff, 70000, static_cast<int64_t>(-1));
+
+        Trace::TraceReader reader(path + Trace::CyclicBufferName);
+        Trace::TraceReader::Entry entry;
+
+        ASSERT_TRUE(reader.Read(entry));
+        EXPECT_EQ(entry.Line, 41u);
+        EXPECT_EQ(entry.Text, _T("as text"));
+
+        ASSERT_TRUE(reader.Read(entry));
+        EXPECT_EQ(entry.Line, 42u);
+        EXPECT_EQ(entry.File, _T("test_tracing.cpp"));
+        EXPECT_EQ(entry.ClassName, _T("CompactRecords"));
+        EXPECT_EQ(entry.Module, _T("Tests"));
+        EXPECT_EQ(entry.Category, _T("Information"));
+        EXPECT_EQ(entry.Text, _T("record -3 of 10, 99.50% z 00ff text [   7]"));
+
+        ASSERT_TRUE(reader.Read(entry));
+        EXPECT_EQ(entry.Text, _T("1 <missing>"));
+
+        // Integers are narrowed to the size they were passed with, as printf would.
+        ASSERT_TRUE(reader.Read(entry));
+        EXPECT_EQ(entry.Text, _T("ffffffff 4294967295 -5 -1294967296 ff 4464 ffffffffffffffff"));
+
+        EXPECT_FALSE(reader.Read(entry));
+
+        Trace::TraceUnit::Instance().Close();
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Trace_TraceUnit, CompactRecordsDirectOutput)
+    {
+        // No ring is open, the records only go to the console.
+        Trace::CallSite site(__FILE__, 45, _T("CompactRecords"), _T("Tests"), _T("Information"));
+
+        Trace::TraceUnit::Instance().DirectOutput(true);
+        testing::internal::CaptureStdout();
+        site.Trace(_T("%d of %s"), 3, _T("three"));
+        const string output(testing::internal::GetCapturedStdout());
+        Trace::TraceUnit::Instance().DirectOutput(false);
+
+        EXPECT_NE(output.find(_T("]:[test_tracing.cpp:45]:[CompactRecords] Information: 3 of three\n")), string::npos);
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static string CachedText(const Web::Response& response)
+    {
+        string result;
+
+        if (response.HasBody() == true) {
+            Core::ProxyType<const Web::IBody> body(response.Body<Web::IBody>());
+            uint8_t buffer[64];
+            uint32_t length = body->Serialize();
+
+            while (length > 0) {
+                uint16_t size = static_cast<uint16_t>(std::min(length, static_cast<uint32_t>(sizeof(buffer))));
+                body->Serialize(buffer, size);
+                result.append(reinterpret_cast<const char*>(buffer), size);
+                length -= size;
+            }
+            body->End();
+        }
+
+        return (result);
+    }
+
+    TEST(Web_FileCache, Serve)
+    {
+        const string fileName(_T("/tmp/webcache.txt"));
+        string content;
+
+        for (uint32_t index = 0; index < 256; index++) {
+            content += _T("Hello cached world! ");
+        }
+
+        Core::File file(fileName);
+        ASSERT_TRUE(file.Create());
+        file.Write(reinterpret_cast<const uint8_t*>(content.c_str()), static_cast<uint32_t>(content.length()));
+        file.Close();
+
+        Web::FileCache cache(16 * 1024);
+        Web::Request request;
+        Web::Response response;
+
+        // Plain request, the full file from memory.
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_OK);
+        ASSERT_TRUE(response.ETag.IsSet());
+        EXPECT_FALSE(response.ContentEncoding.IsSet());
+        ASSERT_TRUE(response.Vary.IsSet());
+        EXPECT_EQ(response.Vary.Value(), _T("Accept-Encoding"));
+        EXPECT_EQ(CachedText(response), content);
+        EXPECT_EQ(cache.Count(), 1u);
+
+        const string tag(response.ETag.Value());
+
+        // Conditional request, no body.
+        response.Clear();
+        request.IfNoneMatch = tag;
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_NOT_MODIFIED);
+        EXPECT_FALSE(response.HasBody());
+        request.IfNoneMatch.Clear();
+
+        // Partial requests.
+        response.Clear();
+        request.Range = _T("bytes=6-11");
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_PARTIAL_CONTENT);
+        EXPECT_EQ(response.ContentRange.Value(), _T("bytes 6-11/") + Core::NumberType<uint32_t>(static_cast<uint32_t>(content.length())).Text());
+        EXPECT_EQ(CachedText(response), _T("cached"));
+
+        response.Clear();
+        request.Range = _T("bytes=-7");
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_PARTIAL_CONTENT);
+        EXPECT_EQ(CachedText(response), _T("world! "));
+
+        response.Clear();
+        request.Range = _T("bytes=100000-");
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+        EXPECT_FALSE(response.HasBody());
+
+        // Numbers beyond 32 bits do not wrap around.
+        response.Clear();
+        request.Range = _T("bytes=4294967302-");
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+
+        response.Clear();
+        request.Range = _T("bytes=6-99999999999999999999");
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_PARTIAL_CONTENT);
+        EXPECT_EQ(CachedText(response), content.substr(6));
+
+        // Malformed ranges are ignored, the whole file is served.
+        const TCHAR* malformed[] = { _T("bytes=6-11x"), _T("bytes=-7;"), _T("bytes=11-6"), _T("bytes=6-11,20-"), _T("lines=1-2") };
+
+        for (const TCHAR* range : malformed) {
+            response.Clear();
+            request.Range = range;
+            EXPECT_TRUE(cache.Serve(fileName, request, response));
+            EXPECT_EQ(response.ErrorCode, Web::STATUS_OK) << range;
+            EXPECT_FALSE(response.ContentRange.IsSet()) << range;
+            EXPECT_EQ(CachedText(response), content) << range;
+        }
+        request.Range.Clear();
+
+        // The gzip variant, with its own entity tag.
+        response.Clear();
+        request.AcceptEncoding = Web::ENCODING_GZIP;
+        EXPECT_TRUE(cache.Serve(fileName, request, response));
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_OK);
+        ASSERT_TRUE(response.ContentEncoding.IsSet());
+        EXPECT_EQ(response.ContentEncoding.Value(), Web::ENCODING_GZIP);
+        EXPECT_NE(response.ETag.Value(), tag);
+        EXPECT_EQ(response.Vary.Value(), _T("Accept-Encoding"));
+        EXPECT_LT(CachedText(response).length(), content.length());
+
+        // Missing files are not cached.
+        response.Clear();
+        EXPECT_FALSE(cache.Serve(_T("/tmp/webcache.none"), request, response));
+        EXPECT_FALSE(response.HasBody());
+
+        file.Destroy();
+        cache.Clear();
+        EXPECT_EQ(cache.Size(), 0u);
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
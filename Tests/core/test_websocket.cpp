@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+#include <chrono>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class MessageSource {
+    public:
+        MessageSource(const string& message)
+            : _message(message)
+            , _offset(0)
+        {
+        }
+
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
+        {
+            uint32_t size = static_cast<uint32_t>(std::min(static_cast<size_t>(maxSendSize), _message.length() - _offset));
+
+            ::memcpy(dataFrame, &(_message[_offset]), size);
+            _offset += size;
+
+            return (size);
+        }
+
+    private:
+        const string _message;
+        size_t _offset;
+    };
+
+    class MessageSink {
+    public:
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
+        {
+            _message.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+
+            return (receivedSize);
+        }
+        string Take()
+        {
+            string result;
+            result.swap(_message);
+            return (result);
+        }
+
+    private:
+        string _message;
+    };
+
+    // Frames a message the way the link does, with buffers of the given size.
+    static std::string Send(Web::WebSocket::Protocol& sender, const string& message, const uint32_t bufferSize)
+    {
+        MessageSource source(message);
+        std::string wire;
+        std::vector<uint8_t> buffer(bufferSize);
+
+        do {
+            uint32_t length = sender.Encoder(buffer.data(), bufferSize, source);
+            wire.append(reinterpret_cast<const char*>(buffer.data()), length);
+        } while (sender.SendInProgress() == true);
+
+        return (wire);
+    }
+
+    // Offers the wire to the receiver in pieces of the given size, as the socket would, frames that
+    // do not fit a piece are delivered in parts.
+    static string Receive(Web::WebSocket::Protocol& receiver, std::string& wire, const uint32_t piece = ~0)
+    {
+        MessageSink sink;
+        uint32_t offset = 0;
+        uint32_t end = 0;
+
+        while (offset < wire.length()) {
+            if (end == offset) {
+                end = static_cast<uint32_t>(std::min(static_cast<size_t>(end) + piece, wire.length()));
+            }
+
+            uint32_t size = end - offset;
+            uint16_t header = receiver.Decoder(reinterpret_cast<uint8_t*>(&(wire[offset])), size);
+
+            if ((header == 0) && (size == 0)) {
+                // Not even the header is complete, wait for more.
+                if (end == wire.length()) {
+                    break;
+                }
+                end = static_cast<uint32_t>(std::min(static_cast<size_t>(end) + piece, wire.length()));
+            } else {
+                EXPECT_EQ((receiver.FrameType() & 0xF0), 0);
+                receiver.Decoder(reinterpret_cast<uint8_t*>(&(wire[offset + header])), size, sink);
+                offset += (header + size);
+            }
+        }
+
+        EXPECT_TRUE(receiver.IsCompleteMessage());
+
+        return (sink.Take());
+    }
+
+    static void Exchange(const bool contextTakeover)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        string response;
+
+        client.Compression(true, contextTakeover, 128);
+        server.Compression(true, contextTakeover, 128);
+
+        EXPECT_TRUE(server.Accept(client.Offer(), response));
+        EXPECT_TRUE(client.Confirm(response));
+        EXPECT_TRUE(client.IsCompressed());
+        EXPECT_TRUE(server.IsCompressed());
+
+        string large;
+        for (uint32_t index = 0; index < 400; index++) {
+            large += _T("{\"callsign\":\"Controller\",\"state\":\"activated\",\"index\":") + Core::NumberType<uint32_t>(index).Text() + _T("},");
+        }
+
+        for (uint8_t round = 0; round < 3; round++) {
+            // A large message, compressed in multiple frames.
+            std::string wire(Send(server, large, 1024));
+            EXPECT_NE((wire[0] & 0x40), 0);
+            EXPECT_LT(wire.length(), large.length() / 4);
+            EXPECT_EQ(Receive(client, wire), large);
+
+            // A small message, sent as is.
+            wire = Send(server, _T("{\"id\":1}"), 1024);
+            EXPECT_EQ((wire[0] & 0x40), 0);
+            EXPECT_EQ(Receive(client, wire), _T("{\"id\":1}"));
+
+            // And the other way around, masked.
+            wire = Send(client, large, 512);
+            EXPECT_NE((wire[0] & 0x40), 0);
+            EXPECT_EQ(Receive(server, wire), large);
+        }
+    }
+
+    TEST(Web_WebSocket, Deflate)
+    {
+        Exchange(true);
+        Exchange(false);
+    }
+
+    TEST(Web_WebSocket, DeflateNegotiation)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        string response;
+
+        // Nothing offered, nothing accepted.
+        server.Compression(true, true, 128);
+        EXPECT_EQ(client.Offer(), _T(""));
+        EXPECT_FALSE(server.Accept(client.Offer(), response));
+        EXPECT_TRUE(response.empty());
+
+        // Offers we can not live with are skipped.
+        EXPECT_TRUE(server.Accept(_T("x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=8, permessage-deflate; client_max_window_bits"), response));
+        EXPECT_EQ(response, _T("permessage-deflate"));
+
+        EXPECT_TRUE(server.Accept(_T("permessage-deflate; server_no_context_takeover; server_max_window_bits=10"), response));
+        EXPECT_EQ(response, _T("permessage-deflate; server_max_window_bits=10; server_no_context_takeover"));
+
+        // A server that is not willing to compress.
+        server.Compression(false, true, 128);
+        EXPECT_FALSE(server.Accept(_T("permessage-deflate"), response));
+
+        client.Compression(true, true, 128);
+        EXPECT_FALSE(client.Confirm(_T("")));
+        EXPECT_FALSE(client.IsCompressed());
+        EXPECT_TRUE(client.Confirm(_T("permessage-deflate; client_max_window_bits=12")));
+        EXPECT_TRUE(client.IsCompressed());
+    }
+
+    TEST(Web_WebSocket, DeflateNothingToSend)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        string response;
+
+        // Everything is worth compressing.
+        client.Compression(true, true, 0);
+        server.Compression(true, true, 0);
+
+        EXPECT_TRUE(server.Accept(client.Offer(), response));
+        EXPECT_TRUE(client.Confirm(response));
+
+        // A source without data does not start a compressed message.
+        for (uint8_t round = 0; round < 3; round++) {
+            MessageSource empty(EMPTY_STRING);
+            uint8_t buffer[64];
+
+            EXPECT_EQ(server.Encoder(buffer, sizeof(buffer), empty), 0u);
+            EXPECT_FALSE(server.SendInProgress());
+        }
+
+        std::string wire(Send(server, _T("{\"id\":1}"), 1024));
+        EXPECT_NE((wire[0] & 0x40), 0);
+        EXPECT_EQ(Receive(client, wire), _T("{\"id\":1}"));
+    }
+
+    TEST(Web_WebSocket, LargeFrames)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        string large;
+
+        while (large.length() < (300 * 1024)) {
+            large += _T("{\"callsign\":\"Screenshot\",\"data\":\"iVBORw0KGgoAAAANSUhEUgAA\"},");
+        }
+
+        // A single frame, with a 64 bits length, delivered in network sized pieces.
+        std::string wire(Send(server, large, 512 * 1024));
+        EXPECT_EQ((wire[1] & 0x7F), 127);
+        EXPECT_EQ(wire.length(), large.length() + 10);
+        EXPECT_EQ(Receive(client, wire, 1500), large);
+
+        // The same, masked.
+        wire = Send(client, large, 512 * 1024);
+        EXPECT_EQ((wire[1] & 0xFF), 0xFF);
+        EXPECT_EQ(wire.length(), large.length() + 14);
+        EXPECT_EQ(Receive(server, wire, 4093), large);
+
+        // Buffers up to 64KB use 16 bits lengths, a large message takes multiple frames.
+        wire = Send(server, large, 64 * 1024);
+        EXPECT_EQ((wire[1] & 0x7F), 126);
+        EXPECT_EQ(wire.length(), large.length() + (4 * ((large.length() + 65531) / 65532)));
+        EXPECT_EQ(Receive(client, wire, 7), large);
+
+        // Small frames still have the short header.
+        wire = Send(client, _T("{\"id\":1}"), 512 * 1024);
+        EXPECT_EQ(wire.length(), 2u + 4u + 8u);
+        EXPECT_EQ(Receive(server, wire), _T("{\"id\":1}"));
+    }
+
+    static void MaskBytes(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+    {
+        for (uint32_t index = 0; index < length; index++) {
+            data[index] ^= key[(offset + index) & 0x3];
+        }
+    }
+
+    TEST(Web_WebSocket, Masking)
+    {
+        const uint8_t key[4] = { 0x12, 0x9A, 0x5C, 0xE7 };
+        uint8_t expected[128];
+        uint8_t actual[132];
+
+        // All lengths around the vector and word sizes, at all key offsets and any alignment.
+        for (uint32_t length = 0; length < 100; length++) {
+            for (uint8_t offset = 0; offset < 4; offset++) {
+                for (uint8_t start = 0; start < 4; start++) {
+                    for (uint32_t index = 0; index < length; index++) {
+                        expected[index] = static_cast<uint8_t>(index * 7 + length);
+                    }
+                    ::memcpy(&actual[start], expected, length);
+
+                    MaskBytes(expected, length, key, offset);
+                    Web::WebSocket::Protocol::Mask(&actual[start], length, key, offset);
+                    EXPECT_EQ(::memcmp(&actual[start], expected, length), 0);
+                }
+            }
+        }
+    }
+
+    TEST(Web_WebSocket, MaskingBenchmark)
+    {
+        const uint8_t key[4] = { 0x12, 0x9A, 0x5C, 0xE7 };
+        const uint32_t total = 64 * 1024 * 1024;
+        std::vector<uint8_t> frame(1024 * 1024);
+
+        for (uint32_t size = 1024; size <= frame.size(); size *= 4) {
+            std::vector<uint8_t> reference(frame.begin(), frame.begin() + size);
+            long long duration[2];
+
+            for (uint8_t kernel = 0; kernel < 2; kernel++) {
+                auto begin = std::chrono::steady_clock::now();
+
+                for (uint32_t done = 0; done < total; done += size) {
+                    if (kernel == 0) {
+                        MaskBytes(frame.data(), size, key, 1);
+                    } else {
+                        Web::WebSocket::Protocol::Mask(frame.data(), size, key, 1);
+                    }
+                }
+
+                duration[kernel] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+            }
+
+            // Both ran the same, even, number of times, so all is back to where we started.
+            EXPECT_TRUE(std::equal(reference.begin(), reference.end(), frame.begin()));
+
+            printf("Masking %7u byte frames: byte by byte %6.0f MB/s, vectorized %6.0f MB/s\n", size,
+                (duration[0] > 0 ? static_cast<double>(total) / duration[0] : 0.0),
+                (duration[1] > 0 ? static_cast<double>(total) / duration[1] : 0.0));
+        }
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <chrono>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+const uint8_t g_poolThreads = 4;
+
+class FanOut : public Core::IDispatch {
+public:
+   FanOut() = delete;
+   FanOut(const FanOut&) = delete;
+   FanOut& operator=(const FanOut&) = delete;
+
+   FanOut(std::atomic<uint32_t>* counter, const uint8_t depth)
+       : _counter(*counter)
+       , _depth(depth)
+   {
+   }
+   virtual ~FanOut()
+   {
+   }
+
+public:
+   virtual void Dispatch() override
+   {
+       // Nested jobs are submitted from a pool thread, so they stay on its local queue.
+       if (_depth > 0) {
+           Core::WorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<FanOut>::Create(&_counter, _depth - 1)));
+           Core::WorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<FanOut>::Create(&_counter, _depth - 1)));
+       }
+       _counter++;
+   }
+
+private:
+   std::atomic<uint32_t>& _counter;
+   const uint8_t _depth;
+};
+
+void RunFanOut(const bool workStealing, const uint8_t depth)
+{
+   const uint32_t expected = (1 << (depth + 1)) - 1;
+   std::atomic<uint32_t> counter(0);
+
+   Core::WorkerPoolType<g_poolThreads> pool(0, workStealing);
+   EXPECT_EQ(pool.IsWorkStealing(), workStealing);
+
+   pool.Run();
+   pool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<FanOut>::Create(&counter, depth)));
+
+   uint32_t waited = 0;
+   while ((counter.load() != expected) && (waited < 10000)) {
+       std::this_thread::sleep_for(std::chrono::milliseconds(1));
+       waited++;
+   }
+   EXPECT_EQ(counter.load(), expected);
+
+   const Core::WorkerPool::Metadata& snapshot = pool.Snapshot();
+   uint32_t runs = 0;
+   uint32_t steals = 0;
+   for (uint8_t index = 0; index < snapshot.Slots; index++) {
+       runs += snapshot.Slot[index];
+       steals += snapshot.Steals[index];
+   }
+   EXPECT_EQ(snapshot.Pending, 0u);
+   EXPECT_LE(steals, runs);
+   if (workStealing == false) {
+       EXPECT_EQ(steals, 0u);
+   }
+
+   pool.Stop();
+}
+
+TEST(Core_WorkerPool, SharedQueue)
+{
+   // The shared queue is bounded, workers inserting nested jobs block once it is full.
+   RunFanOut(false, 3);
+
+   Core::Singleton::Dispose();
+}
+
+TEST(Core_WorkerPool, WorkStealing)
+{
+   RunFanOut(true, 12);
+
+   Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
@@ -1240,6 +1240,16 @@ def GenerateStubs(output_file, source_file, defaults="", scan_only=False):
                             "RPC::Data::Frame::Writer writer(newMessage->Parameters().Writer());"
                         )
 
+                        # size the frame up front, so it gets the right size class without growing per parameter
+                        variable = []
+                        for c, p in enumerate(params):
+                            if p.is_input and not p.obj and p.is_ptr:
+                                variable.append("%s" % p.length_expr)
+                            elif p.is_input and p.CheckRpcType() == "Text":
+                                variable.append("param%i.size()" % c)
+                        if variable and len(params) > 1:
+                            emit.Line("writer.Reserve(%s + %i);" % (" + ".join(variable), 16 * len(params)))
+
                         for c, p in enumerate(params):
                             if not p.is_ptr and not p.CheckRpcType():
                                 if p.obj: